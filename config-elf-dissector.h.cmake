@@ -10,4 +10,8 @@
 #cmakedefine01 HAVE_DWARF
 #cmakedefine HAVE_CAPSTONE
 
+#define LDBENCHMARK_RUNNER "${KDE_INSTALL_FULL_LIBEXECDIR}/ldbenchmark-runner"
+#define LDBENCHMARK_AUDIT_MODULE "${KDE_INSTALL_FULL_PLUGINDIR}/elf-dissector/ldbenchmark-audit.so"
+#define LDBENCHMARK_STARTUP_MODULE "${KDE_INSTALL_FULL_PLUGINDIR}/elf-dissector/ldbenchmark-startup.so"
+
 #endif
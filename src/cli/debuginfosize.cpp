@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/debuginfosizecheck.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsectionheader.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+#include <elf.h>
+
+static void printSectionSizes(ElfFile *file)
+{
+    uint64_t debugSize = 0;
+    uint64_t codeSize = 0;
+    foreach (const auto shdr, file->sectionHeaders()) {
+        if (shdr->isDebugInformation()) {
+            std::cout << "  " << shdr->name() << ": " << shdr->size() << " bytes" << std::endl;
+            debugSize += shdr->size();
+        } else if (shdr->flags() & SHF_EXECINSTR) {
+            codeSize += shdr->size();
+        }
+    }
+    std::cout << "  Debug information: " << debugSize << " bytes, executable code: " << codeSize << " bytes";
+    if (codeSize > 0)
+        std::cout << " (ratio " << qPrintable(QString::number(double(debugSize) / double(codeSize), 'g', 3)) << ")";
+    std::cout << std::endl << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption topOption(QStringLiteral("top"), QStringLiteral("Number of entries to show per category (default: 25, 0 for all)."), QStringLiteral("count"), QStringLiteral("25"));
+    parser.addOption(topOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF library to open"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+        std::cout << qPrintable(fileName) << ":" << std::endl;
+        printSectionSizes(set.file(0));
+        DebugInfoSizeCheck checker;
+        checker.analyze(set.file(0)->dwarfInfo());
+        checker.printReport(parser.value(topOption).toInt());
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/exportreductioncheck.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption verboseOption(QStringList() << QStringLiteral("v") << QStringLiteral("verbose"), QStringLiteral("List the exports that can be hidden."));
+    parser.addOption(verboseOption);
+    QCommandLineOption scriptOption(QStringList() << QStringLiteral("s") << QStringLiteral("version-script"), QStringLiteral("Write linker version scripts for all libraries with hideable exports to <dir>, below the path of the library."), QStringLiteral("dir"));
+    parser.addOption(scriptOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library to open, its dependencies are analyzed as well"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+
+        ExportReductionCheck checker(&set);
+        checker.printReport(parser.isSet(verboseOption));
+        if (!parser.isSet(scriptOption))
+            continue;
+
+        const QDir dir(parser.value(scriptOption));
+        foreach (const auto &result, checker.analyze()) {
+            if (result.hiddenCount() == 0)
+                continue;
+            // mirror the original location, libraries with the same name in different directories must not overwrite each other
+            QFile scriptFile(dir.absolutePath() + QFileInfo(result.file->fileName()).absoluteFilePath() + QLatin1String(".map"));
+            if (!QDir().mkpath(QFileInfo(scriptFile).absolutePath())) {
+                std::cerr << "Failed to create output directory for " << qPrintable(scriptFile.fileName()) << std::endl;
+                return 1;
+            }
+            if (!scriptFile.open(QFile::WriteOnly | QFile::Truncate)) {
+                std::cerr << "Failed to open " << qPrintable(scriptFile.fileName()) << ": " << qPrintable(scriptFile.errorString()) << std::endl;
+                return 1;
+            }
+            ExportReductionCheck::writeVersionScript(result, &scriptFile);
+            std::cout << "Wrote " << qPrintable(scriptFile.fileName()) << std::endl;
+        }
+    }
+
+    return 0;
+}
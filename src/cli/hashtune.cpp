@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <optimizers/gnuhashoptimizer.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+
+#include <iostream>
+
+static void printEstimate(const char *label, const GnuHashOptimizer::Estimate &estimate)
+{
+    std::cout << label << ": " << estimate.parameters.bucketCount << " buckets, "
+              << estimate.parameters.maskWordsCount << " bloom words, shift2 " << estimate.parameters.shift2
+              << ", " << estimate.tableSize << " bytes" << std::endl;
+    std::cout << "  " << estimate.probesPerLookup() << " probes per lookup, "
+              << (estimate.bloomFalsePositiveRate() * 100.0) << "% bloom false positives, "
+              << estimate.stats.chainWalks << " chain entries and "
+              << estimate.stats.strcmpCalls << " string comparisons for " << estimate.lookups << " lookups" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption bucketsOption(QStringLiteral("buckets"), QStringLiteral("Use this bucket count instead of the computed one."), QStringLiteral("count"));
+    parser.addOption(bucketsOption);
+    QCommandLineOption maskWordsOption(QStringLiteral("mask-words"), QStringLiteral("Use this number of bloom filter words (power of two) instead of the computed one."), QStringLiteral("count"));
+    parser.addOption(maskWordsOption);
+    QCommandLineOption shiftOption(QStringLiteral("shift2"), QStringLiteral("Use this bloom filter shift instead of the computed one."), QStringLiteral("shift"));
+    parser.addOption(shiftOption);
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"), QStringLiteral("Write a copy of the library with the rebuilt hash table to this file."), QStringLiteral("file"));
+    parser.addOption(outputOption);
+    parser.addPositionalArgument(QStringLiteral("library"), QStringLiteral("ELF library to tune the .gnu.hash section of"), QStringLiteral("<library>"));
+    parser.addPositionalArgument(QStringLiteral("dependents"), QStringLiteral("Executables or libraries whose imports to replay"), QStringLiteral("[dependents...]"));
+    parser.process(app);
+
+    const auto args = parser.positionalArguments();
+    if (args.isEmpty())
+        parser.showHelp(1);
+
+    ElfFile lib(args.at(0));
+    if (!lib.open(QFile::ReadOnly) || !lib.isValid()) {
+        std::cerr << "Failed to open " << qPrintable(args.at(0)) << std::endl;
+        return 1;
+    }
+
+    GnuHashOptimizer optimizer(&lib);
+    if (!optimizer.isValid()) {
+        std::cerr << qPrintable(lib.displayName()) << " has no .gnu.hash section that can be rebuilt." << std::endl;
+        return 1;
+    }
+
+    // a single set, so that libraries shared by several dependents are replayed only once
+    ElfFileSet set;
+    for (int i = 1; i < args.size(); ++i) {
+        const auto path = QFileInfo(args.at(i)).canonicalFilePath();
+        bool loaded = false;
+        for (int j = 0; j < set.size() && !loaded; ++j)
+            loaded = QFileInfo(set.file(j)->fileName()).canonicalFilePath() == path;
+        if (!loaded)
+            set.addFile(args.at(i));
+    }
+    optimizer.addImports(&set);
+    if (args.size() == 1) {
+        std::cout << "No dependents given, replaying the exported symbols instead." << std::endl;
+        optimizer.addExportsAsImports();
+    }
+
+    const auto current = optimizer.simulate(optimizer.currentParameters());
+    printEstimate("Current", current);
+
+    auto params = optimizer.optimize().parameters;
+    if (parser.isSet(bucketsOption))
+        params.bucketCount = parser.value(bucketsOption).toUInt();
+    if (parser.isSet(maskWordsOption))
+        params.maskWordsCount = parser.value(maskWordsOption).toUInt();
+    if (parser.isSet(shiftOption))
+        params.shift2 = parser.value(shiftOption).toUInt();
+    if (params.bucketCount == 0 || params.maskWordsCount == 0 || (params.maskWordsCount & (params.maskWordsCount - 1)) != 0 || params.shift2 >= 32) {
+        std::cerr << "Invalid hash table parameters." << std::endl;
+        return 1;
+    }
+    printEstimate("Proposed", optimizer.simulate(params));
+
+    if (parser.isSet(outputOption)) {
+        if (!optimizer.write(params, parser.value(outputOption)))
+            return 1;
+        std::cout << "Wrote " << qPrintable(parser.value(outputOption)) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/ldbenchmark.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+static void printStatistics(const char *label, const LDBenchmark::Statistics &stats)
+{
+    std::cout << "  " << label << ": " << stats.median << " µs median, " << stats.mean << " ± " << stats.confidenceInterval
+              << " µs mean, " << stats.min << " - " << stats.max << " µs, " << stats.samples << " samples, "
+              << stats.outliers << " outliers";
+    for (int c = 0; c < LDBenchmark::CounterCount; ++c) {
+        if (stats.counters[c] >= 0.0)
+            std::cout << ", " << stats.counters[c] << " " << LDBenchmark::counterName(static_cast<LDBenchmark::Counter>(c));
+    }
+    for (int p = 0; p < LDBenchmark::PhaseCount; ++p) {
+        if (stats.phases[p] >= 0.0)
+            std::cout << ", " << LDBenchmark::phaseName(static_cast<LDBenchmark::Phase>(p)) << ": " << stats.phases[p] << " µs";
+    }
+    if (stats.io[LDBenchmark::IoWait] >= 0.0)
+        std::cout << ", I/O wait: " << stats.io[LDBenchmark::IoWait] << " µs";
+    if (stats.io[LDBenchmark::BytesRead] >= 0.0)
+        std::cout << ", " << stats.io[LDBenchmark::BytesRead] << " bytes read";
+    if (stats.io[LDBenchmark::CachedBytes] > 0.0)
+        std::cout << ", " << stats.io[LDBenchmark::CachedBytes] << " bytes not evicted from the page cache";
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption warmupOption(QStringLiteral("warmup"), QStringLiteral("Number of discarded warmup runs (default: 1)."), QStringLiteral("count"), QStringLiteral("1"));
+    parser.addOption(warmupOption);
+    QCommandLineOption minOption(QStringLiteral("min-iterations"), QStringLiteral("Minimum number of runs per load mode (default: 5)."), QStringLiteral("count"), QStringLiteral("5"));
+    parser.addOption(minOption);
+    QCommandLineOption maxOption(QStringLiteral("max-iterations"), QStringLiteral("Maximum number of runs per load mode (default: 50)."), QStringLiteral("count"), QStringLiteral("50"));
+    parser.addOption(maxOption);
+    QCommandLineOption precisionOption(QStringLiteral("precision"), QStringLiteral("Stop when the 95% confidence interval is narrower than this fraction of the mean (default: 0.02)."), QStringLiteral("fraction"), QStringLiteral("0.02"));
+    parser.addOption(precisionOption);
+    QCommandLineOption cpuOption(QStringLiteral("cpu"), QStringLiteral("Pin the benchmark runner to this CPU."), QStringLiteral("cpu"));
+    parser.addOption(cpuOption);
+    QCommandLineOption countersOption(QStringLiteral("counters"), QStringLiteral("Record hardware performance counters."));
+    parser.addOption(countersOption);
+    QCommandLineOption phasesOption(QStringLiteral("phases"), QStringLiteral("Split load times into search, mapping and relocation phases using LD_AUDIT."));
+    parser.addOption(phasesOption);
+    QCommandLineOption coldOption(QStringLiteral("cold"), QStringLiteral("Evict all files from the page cache before each run, to measure first start latency. Fails if other processes keep any of the files mapped."));
+    parser.addOption(coldOption);
+    QCommandLineOption startupOption(QStringLiteral("startup"), QStringLiteral("Launch the executable with the remaining arguments and measure its startup instead of loading libraries one by one."));
+    parser.addOption(startupOption);
+    QCommandLineOption markerOption(QStringLiteral("marker"), QStringLiteral("With --startup, measure until the application prints this text on stdout or stderr."), QStringLiteral("text"));
+    parser.addOption(markerOption);
+    QCommandLineOption jsonOption(QStringLiteral("json"), QStringLiteral("Write results to this JSON file."), QStringLiteral("file"));
+    parser.addOption(jsonOption);
+    QCommandLineOption csvOption(QStringLiteral("csv"), QStringLiteral("Write results to this CSV file, as used by the plotter."), QStringLiteral("file"));
+    parser.addOption(csvOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF library to benchmark, together with its dependencies"), QStringLiteral("<elf> [args...]"));
+    parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsPositionalArguments);
+    parser.process(app);
+
+    const auto minIterations = parser.value(minOption).toInt();
+    const auto maxIterations = parser.value(maxOption).toInt();
+    if (minIterations <= 0 || maxIterations < minIterations) {
+        std::cerr << "Invalid number of iterations." << std::endl;
+        return 1;
+    }
+
+    auto args = parser.positionalArguments();
+    if (args.isEmpty() || (args.size() > 1 && !parser.isSet(startupOption))) {
+        std::cerr << "Specify exactly one ELF file." << std::endl;
+        parser.showHelp(1);
+    }
+
+    LDBenchmark benchmark;
+    benchmark.setWarmupIterations(parser.value(warmupOption).toInt());
+    benchmark.setIterations(minIterations, maxIterations);
+    benchmark.setTargetPrecision(parser.value(precisionOption).toDouble());
+    if (parser.isSet(cpuOption))
+        benchmark.setCpu(parser.value(cpuOption).toInt());
+    benchmark.setHardwareCounters(parser.isSet(countersOption));
+    benchmark.setPhaseTiming(parser.isSet(phasesOption));
+    benchmark.setColdCache(parser.isSet(coldOption));
+    benchmark.setStartupMarker(parser.value(markerOption));
+
+    ElfFileSet set;
+    set.addFile(args.takeFirst());
+    if (set.size() == 0)
+        return 1;
+
+    if (parser.isSet(startupOption)) {
+        benchmark.measureStartup(&set, args);
+        for (int t = 0; t < LDBenchmark::StartupTimeCount; ++t) {
+            const auto time = static_cast<LDBenchmark::StartupTime>(t);
+            const auto stats = benchmark.startupStatistics(time);
+            if (stats.samples > 0)
+                printStatistics(LDBenchmark::startupTimeName(time), stats);
+        }
+        std::cout << "Per object search and mapping time:" << std::endl;
+        foreach (const auto &obj, benchmark.startupObjects()) {
+            std::cout << (obj.file ? qPrintable(obj.file->displayName()) : obj.fileName.constData()) << ":" << std::endl;
+            printStatistics("load", obj.load);
+        }
+        if (parser.isSet(jsonOption))
+            benchmark.writeJSON(parser.value(jsonOption));
+        return 0;
+    }
+
+    benchmark.measureFileSet(&set);
+
+    for (int i = 0; i < benchmark.size(); ++i) {
+        std::cout << qPrintable(benchmark.file(i)->displayName()) << ":" << std::endl;
+        printStatistics("lazy", benchmark.statistics(LDBenchmark::LoadMode::Lazy, i));
+        printStatistics("now", benchmark.statistics(LDBenchmark::LoadMode::Now, i));
+    }
+
+    if (parser.isSet(jsonOption))
+        benchmark.writeJSON(parser.value(jsonOption));
+    if (parser.isSet(csvOption))
+        benchmark.writeCSV(parser.value(csvOption));
+
+    return 0;
+}
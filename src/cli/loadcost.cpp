@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/ldbenchmark.h>
+#include <checks/loadcostmodel.h>
+
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption fitOption(QStringLiteral("fit"), QStringLiteral("Measure the load time of all given files and their dependencies, and write the fitted model to this file."), QStringLiteral("model"));
+    parser.addOption(fitOption);
+    QCommandLineOption modelOption(QStringLiteral("model"), QStringLiteral("Predict the load time of all given files and their dependencies using this model."), QStringLiteral("model"));
+    parser.addOption(modelOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    if (parser.isSet(fitOption) == parser.isSet(modelOption)) {
+        std::cerr << "Specify exactly one of --fit or --model." << std::endl;
+        parser.showHelp(1);
+    }
+
+    LoadCostModel model;
+    if (parser.isSet(fitOption)) {
+        foreach (const auto &fileName, parser.positionalArguments()) {
+            ElfFileSet set;
+            set.addFile(fileName);
+            if (set.size() == 0)
+                continue;
+            LDBenchmark benchmark;
+            benchmark.measureFileSet(&set);
+            model.addSamples(benchmark);
+        }
+        if (!model.fit())
+            return 1;
+        model.printModel();
+        return model.save(parser.value(fitOption)) ? 0 : 1;
+    }
+
+    if (!model.load(parser.value(modelOption)))
+        return 1;
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+        double lazyTotal = 0.0;
+        double nowTotal = 0.0;
+        for (int i = 0; i < set.size(); ++i) {
+            const auto lazy = model.predict(LDBenchmark::LoadMode::Lazy, set.file(i));
+            const auto now = model.predict(LDBenchmark::LoadMode::Now, set.file(i));
+            lazyTotal += lazy;
+            nowTotal += now;
+            std::cout << qPrintable(set.file(i)->displayName()) << ": " << lazy << " µs lazy, " << now << " µs now" << std::endl;
+        }
+        std::cout << "Total: " << lazyTotal << " µs lazy, " << nowTotal << " µs now" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/symbollookupsimulator.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+
+#include <iostream>
+
+static int fileIndexForName(ElfFileSet *set, const QByteArray &name)
+{
+    for (int i = 0; i < set->size(); ++i) {
+        const auto file = set->file(i);
+        if (file->dynamicSection() && file->dynamicSection()->soName() == name)
+            return i;
+        if (file->fileName().toUtf8() == name || file->displayName().toUtf8() == name)
+            return i;
+    }
+    return -1;
+}
+
+static bool loadHiddenSymbols(const QString &fileName, ElfFileSet *set, SymbolLookupSimulator *sim)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        std::cerr << "Failed to open " << qPrintable(fileName) << ": " << qPrintable(file.errorString()) << std::endl;
+        return false;
+    }
+
+    QHash<int, QSet<QByteArray>> symbols;
+    while (!file.atEnd()) {
+        const auto line = file.readLine().simplified();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+        const auto fields = line.split(' ');
+        const auto idx = fileIndexForName(set, fields.at(0));
+        if (fields.size() != 2 || idx < 0) {
+            std::cerr << "Ignoring invalid line: " << line.constData() << std::endl;
+            continue;
+        }
+        symbols[idx].insert(fields.at(1));
+    }
+
+    for (auto it = symbols.constBegin(); it != symbols.constEnd(); ++it)
+        sim->hideSymbols(it.key(), it.value());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption sysrootOption(QStringLiteral("sysroot"), QStringLiteral("Resolve dependencies inside this directory."), QStringLiteral("sysroot"));
+    parser.addOption(sysrootOption);
+    QCommandLineOption lazyOption(QStringLiteral("lazy"), QStringLiteral("Only simulate lazy binding."));
+    parser.addOption(lazyOption);
+    QCommandLineOption nowOption(QStringLiteral("now"), QStringLiteral("Only simulate immediate binding."));
+    parser.addOption(nowOption);
+    QCommandLineOption orderOption(QStringLiteral("scope-order"), QStringLiteral("Comma-separated list of libraries to put first in the lookup scope, after the executable."), QStringLiteral("libs"));
+    parser.addOption(orderOption);
+    QCommandLineOption hideOption(QStringLiteral("hide-symbols"), QStringLiteral("File with one \"<library> <symbol>\" pair per line, symbols to treat as not exported."), QStringLiteral("file"));
+    parser.addOption(hideOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library to simulate loading of"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1)
+        parser.showHelp(1);
+    if (parser.isSet(lazyOption) && parser.isSet(nowOption)) {
+        std::cerr << "--lazy and --now are mutually exclusive." << std::endl;
+        return 1;
+    }
+
+    ElfFileSet set;
+    if (parser.isSet(sysrootOption))
+        set.setSysroot(parser.value(sysrootOption));
+    set.addFile(parser.positionalArguments().at(0));
+    if (set.size() == 0)
+        return 1;
+
+    SymbolLookupSimulator sim(&set);
+
+    if (parser.isSet(orderOption)) {
+        auto scope = sim.scopeOrder();
+        int insertPos = 1;
+        foreach (const auto &lib, parser.value(orderOption).toUtf8().split(',')) {
+            const auto idx = fileIndexForName(&set, lib.trimmed());
+            const auto scopeIdx = scope.indexOf(idx);
+            if (idx < 0 || scopeIdx < insertPos) {
+                std::cerr << "Ignoring unknown library " << lib.constData() << std::endl;
+                continue;
+            }
+            scope.move(scopeIdx, insertPos++);
+        }
+        sim.setScopeOrder(scope);
+    }
+
+    if (parser.isSet(hideOption) && !loadHiddenSymbols(parser.value(hideOption), &set, &sim))
+        return 1;
+
+    if (!parser.isSet(lazyOption)) {
+        std::cout << "Immediate binding:" << std::endl;
+        sim.simulate(SymbolLookupSimulator::BindNow);
+        sim.printReport();
+        std::cout << std::endl;
+    }
+    if (!parser.isSet(nowOption)) {
+        std::cout << "Lazy binding:" << std::endl;
+        sim.simulate(SymbolLookupSimulator::Lazy);
+        sim.printReport();
+    }
+
+    return 0;
+}
@@ -18,11 +18,25 @@
 #include <config-elf-dissector-version.h>
 
 #include <optimizers/dependencysorter.h>
+#include <checks/symbollookupsimulator.h>
 
 #include <elf/elffileset.h>
 
 #include <QCoreApplication>
 #include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+
+#include <iostream>
+
+static uint64_t globalLookupCost(ElfFileSet *set, const QVector<int> &scope)
+{
+    SymbolLookupSimulator sim(set);
+    sim.setScopeOrder(scope);
+    sim.simulate(SymbolLookupSimulator::BindNow);
+    const auto stats = sim.totalStatistics();
+    return stats.bloomProbes + stats.chainWalks + stats.strcmpCalls;
+}
 
 int main(int argc, char** argv)
 {
@@ -36,16 +50,57 @@ int main(int argc, char** argv)
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.addVersionOption();
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"), QStringLiteral("Write optimized copies of all changed files into this directory, below their original absolute path."), QStringLiteral("dir"));
+    parser.addOption(outputOption);
+    QCommandLineOption dryRunOption(QStringList() << QStringLiteral("n") << QStringLiteral("dry-run"), QStringLiteral("Only show the proposed changes and their estimated effect."));
+    parser.addOption(dryRunOption);
+    QCommandLineOption removeUnusedOption(QStringLiteral("remove-unused"), QStringLiteral("Drop DT_NEEDED entries no symbol is used from."));
+    parser.addOption(removeUnusedOption);
     parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF library to optimize"), QStringLiteral("<elf>"));
     parser.process(app);
 
+    const auto dryRun = parser.isSet(dryRunOption);
+    if (!dryRun && !parser.isSet(outputOption)) {
+        std::cerr << "No output directory specified, use --output <dir> or --dry-run." << std::endl;
+        parser.showHelp(1);
+    }
+    const QDir outputDir(parser.value(outputOption));
+    if (!dryRun && !outputDir.exists() && !QDir().mkpath(outputDir.path())) {
+        std::cerr << "Failed to create output directory " << qPrintable(outputDir.path()) << std::endl;
+        return 1;
+    }
+
     DependencySorter optimizer;
+    optimizer.setRemoveUnused(parser.isSet(removeUnusedOption));
     foreach (const auto &fileName, parser.positionalArguments()) {
         ElfFileSet set;
         set.addFile(fileName);
         if (set.size() == 0)
             continue;
-        optimizer.sortDtNeeded(&set);
+
+        const auto results = optimizer.sortDtNeeded(&set);
+        DependencySorter::printResults(&set, results);
+
+        SymbolLookupSimulator defaultSim(&set);
+        const auto originalGlobalCost = globalLookupCost(&set, defaultSim.scopeOrder());
+        const auto optimizedGlobalCost = globalLookupCost(&set, DependencySorter::scopeOrder(&set, results));
+        std::cout << "Estimated lookup cost in the global scope: " << originalGlobalCost << " -> " << optimizedGlobalCost << " probes" << std::endl;
+
+        if (dryRun)
+            continue;
+        foreach (const auto &result, results) {
+            if (!result.isModified())
+                continue;
+            const auto file = set.file(result.fileIndex);
+            // mirror the original location, libraries with the same name in different directories must not overwrite each other
+            const auto outputFileName = outputDir.absolutePath() + QFileInfo(file->fileName()).absoluteFilePath();
+            if (!QDir().mkpath(QFileInfo(outputFileName).absolutePath())) {
+                std::cerr << "Failed to create output directory for " << qPrintable(outputFileName) << std::endl;
+                continue;
+            }
+            if (DependencySorter::write(file, result, outputFileName))
+                std::cout << "Wrote " << qPrintable(outputFileName) << std::endl;
+        }
     }
 
     return 0;
@@ -17,6 +17,7 @@
 
 #include <config-elf-dissector-version.h>
 
+#include <checks/paddingcostcheck.h>
 #include <checks/structurepackingcheck.h>
 
 #include <elf/elffileset.h>
@@ -36,9 +37,31 @@ int main(int argc, char** argv)
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.addVersionOption();
+    QCommandLineOption rankOption(QStringList() << QStringLiteral("r") << QStringLiteral("rank"), QStringLiteral("Rank types by total memory wasted over all their instances."));
+    parser.addOption(rankOption);
+    QCommandLineOption heapOption(QStringLiteral("heap-histogram"), QStringLiteral("Heap allocation histogram (type name and live instance count per line) to weight the ranking with. Implies --rank."), QStringLiteral("file"));
+    parser.addOption(heapOption);
+    QCommandLineOption topOption(QStringLiteral("top"), QStringLiteral("Only show the given number of types in the ranking."), QStringLiteral("count"));
+    parser.addOption(topOption);
     parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF library to open"), QStringLiteral("<elf>"));
     parser.process(app);
 
+    if (parser.isSet(rankOption) || parser.isSet(heapOption)) {
+        PaddingCostCheck costCheck;
+        if (parser.isSet(heapOption) && !costCheck.loadHeapHistogram(parser.value(heapOption)))
+            return 1;
+        foreach (const auto &fileName, parser.positionalArguments()) {
+            ElfFileSet set;
+            set.addFile(fileName);
+            if (set.size() == 0)
+                continue;
+            costCheck.setElfFileSet(&set);
+            costCheck.collect(set.file(0)->dwarfInfo());
+        }
+        costCheck.printRanking(parser.value(topOption).toInt());
+        return 0;
+    }
+
     StructurePackingCheck checker;
     foreach (const auto &fileName, parser.positionalArguments()) {
         ElfFileSet set;
@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/relocateddatacheck.h>
+
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption topOption(QStringLiteral("top"), QStringLiteral("Number of objects to show (default: 25, 0 for all)."), QStringLiteral("count"), QStringLiteral("25"));
+    parser.addOption(topOption);
+    QCommandLineOption pageSizeOption(QStringList() << QStringLiteral("p") << QStringLiteral("page-size"), QStringLiteral("Page size in bytes (default: 4096)."), QStringLiteral("bytes"));
+    parser.addOption(pageSizeOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF library to open"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    RelocatedDataCheck checker;
+    if (parser.isSet(pageSizeOption)) {
+        bool ok = false;
+        const auto pageSize = parser.value(pageSizeOption).toULongLong(&ok);
+        if (!ok || pageSize == 0) {
+            std::cerr << "Invalid page size: " << qPrintable(parser.value(pageSizeOption)) << std::endl;
+            return 1;
+        }
+        checker.setPageSize(pageSize);
+    }
+
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+        checker.printReport(set.file(0), parser.value(topOption).toInt());
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/loadcostmodel.h>
+#include <checks/relrsavingscheck.h>
+
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption pageSizeOption(QStringList() << QStringLiteral("p") << QStringLiteral("page-size"), QStringLiteral("Page size in bytes (default: 4096)."), QStringLiteral("bytes"));
+    parser.addOption(pageSizeOption);
+    QCommandLineOption modelOption(QStringLiteral("model"), QStringLiteral("Load cost model created by elf-loadcost, to estimate the time saved by reading smaller relocation tables."), QStringLiteral("model"));
+    parser.addOption(modelOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library to analyze, including its dependencies"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    RelrSavingsCheck checker;
+    if (parser.isSet(pageSizeOption)) {
+        bool ok = false;
+        const auto pageSize = parser.value(pageSizeOption).toULongLong(&ok);
+        if (!ok || pageSize == 0) {
+            std::cerr << "Invalid page size: " << qPrintable(parser.value(pageSizeOption)) << std::endl;
+            return 1;
+        }
+        checker.setPageSize(pageSize);
+    }
+
+    LoadCostModel model;
+    if (parser.isSet(modelOption)) {
+        if (!model.load(parser.value(modelOption)))
+            return 1;
+        checker.setLoadCostModel(&model);
+    }
+
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+        checker.printReport(&set);
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/staticinitializercheck.h>
+
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <algorithm>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption measureOption(QStringLiteral("measure"), QStringLiteral("Measure the runtime of each initializer of the loaded libraries (re-runs them in a forked process, which might not be safe for all code)."));
+    parser.addOption(measureOption);
+    QCommandLineOption iterationsOption(QStringLiteral("iterations"), QStringLiteral("Number of runtime measurements per initializer (default: 5)."), QStringLiteral("n"), QStringLiteral("5"));
+    parser.addOption(iterationsOption);
+    QCommandLineOption topOption(QStringLiteral("top"), QStringLiteral("Show the <n> most expensive initializers only (default: 25, 0 for all)."), QStringLiteral("n"), QStringLiteral("25"));
+    parser.addOption(topOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library to open, its dependencies are analyzed as well"), QStringLiteral("<elf>"));
+    parser.process(app);
+
+    foreach (const auto &fileName, parser.positionalArguments()) {
+        ElfFileSet set;
+        set.addFile(fileName);
+        if (set.size() == 0)
+            continue;
+        StaticInitializerCheck checker(&set);
+        auto results = checker.analyze();
+        if (parser.isSet(measureOption))
+            checker.measure(results, std::max(1, parser.value(iterationsOption).toInt()));
+        StaticInitializerCheck::printReport(results, parser.value(topOption).toInt());
+    }
+
+    return 0;
+}
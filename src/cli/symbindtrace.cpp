@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <config-elf-dissector-version.h>
+
+#include <checks/symbolbindingtrace.h>
+
+#include <elf/elffileset.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    QCoreApplication::setApplicationName(QStringLiteral("ELF Dissector"));
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELF_DISSECTOR_VERSION_STRING));
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption traceOption(QStringList() << QStringLiteral("t") << QStringLiteral("trace"), QStringLiteral("Symbol binding trace file to record to or to analyze."), QStringLiteral("file"));
+    parser.addOption(traceOption);
+    QCommandLineOption recordOption(QStringLiteral("record"), QStringLiteral("Run the given command and append its symbol bindings to the trace file."));
+    parser.addOption(recordOption);
+    QCommandLineOption topOption(QStringLiteral("top"), QStringLiteral("Show the <n> most frequent bindings only (default: 25, 0 for all)."), QStringLiteral("n"), QStringLiteral("25"));
+    parser.addOption(topOption);
+    parser.addPositionalArgument(QStringLiteral("elf"), QStringLiteral("ELF executable or library the trace belongs to, or the command to run when recording"), QStringLiteral("[<elf>|<command> [args...]]"));
+    parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsPositionalArguments);
+    parser.process(app);
+
+    if (!parser.isSet(traceOption))
+        parser.showHelp(1);
+    const auto traceFile = parser.value(traceOption);
+
+    if (parser.isSet(recordOption)) {
+        auto args = parser.positionalArguments();
+        if (args.isEmpty())
+            parser.showHelp(1);
+        const auto command = args.takeFirst();
+        const auto exitCode = SymbolBindingTrace::record(traceFile, command, args);
+        if (exitCode < 0) {
+            std::cerr << "Failed to record symbol bindings of " << qPrintable(command) << std::endl;
+            return 1;
+        }
+        return exitCode;
+    }
+
+    SymbolBindingTrace trace;
+    if (!trace.load(traceFile))
+        return 1;
+
+    ElfFileSet set;
+    foreach (const auto &fileName, parser.positionalArguments())
+        set.addFile(fileName);
+    if (set.size() > 0)
+        trace.resolve(&set);
+
+    trace.printReport(parser.value(topOption).toInt());
+    return 0;
+}
@@ -0,0 +1,335 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "cachelinecheck.h"
+
+#include <elf/elffileset.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+
+#include <dwarf.h>
+#endif
+
+#include <QBitArray>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+void CacheLineCheck::setElfFileSet(ElfFileSet* fileSet)
+{
+    m_packingCheck.setElfFileSet(fileSet);
+}
+
+void CacheLineCheck::setCacheLineSize(int size)
+{
+    assert(size > 0);
+    m_lineSize = size;
+}
+
+void CacheLineCheck::checkAll(DwarfInfo* info)
+{
+#if HAVE_DWARF
+    if (!info)
+        return;
+
+    foreach (auto die, info->compilationUnits())
+        checkDie(die);
+#endif
+}
+
+QString CacheLineCheck::checkOneStructure(DwarfDie* structDie) const
+{
+    bool hasIssues = false;
+    return analyzeStructure(structDie, &hasIssues);
+}
+
+void CacheLineCheck::checkDie(DwarfDie* die)
+{
+#if HAVE_DWARF
+    if ((die->tag() == DW_TAG_structure_type || die->tag() == DW_TAG_class_type) && die->typeSize() > 0) {
+        const QString loc = die->sourceLocation();
+        if (!m_duplicateCheck.contains(loc)) {
+            m_duplicateCheck.insert(loc);
+            bool hasIssues = false;
+            const auto s = analyzeStructure(die, &hasIssues);
+            if (hasIssues)
+                std::cout << s.toLocal8Bit().constData() << std::endl;
+        }
+    }
+
+    foreach (auto child, die->children()) {
+        if (child->tag() == DW_TAG_member || child->tag() == DW_TAG_inheritance)
+            continue;
+        checkDie(child);
+    }
+#endif
+}
+
+#if HAVE_DWARF
+static QByteArray normalizedTypeName(DwarfDie *typeDie)
+{
+    auto name = typeDie->fullyQualifiedName();
+    const auto templateIdx = name.indexOf('<');
+    if (templateIdx > 0)
+        name.truncate(templateIdx);
+    // inline namespaces of libc++ and libstdc++
+    name.replace("::__1::", "::");
+    name.replace("::__cxx11::", "::");
+    return name;
+}
+
+static bool isSynchronizationType(DwarfDie *typeDie)
+{
+    static const char* const syncTypeNames[] = {
+        "std::atomic",
+        "std::atomic_flag",
+        "std::mutex",
+        "std::recursive_mutex",
+        "std::timed_mutex",
+        "std::recursive_timed_mutex",
+        "std::shared_mutex",
+        "std::shared_timed_mutex",
+        "std::condition_variable",
+        "pthread_mutex_t",
+        "pthread_rwlock_t",
+        "pthread_spinlock_t",
+        "pthread_cond_t",
+        "QMutex",
+        "QBasicMutex",
+        "QRecursiveMutex",
+        "QReadWriteLock",
+        "QWaitCondition",
+        "QSemaphore",
+        "QAtomicInt",
+        "QAtomicInteger",
+        "QAtomicPointer",
+        "QBasicAtomicInteger",
+        "QBasicAtomicPointer"
+    };
+
+    while (typeDie) {
+        switch (typeDie->tag()) {
+            case DW_TAG_const_type:
+            case DW_TAG_volatile_type:
+            case DW_TAG_array_type:
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+            case DW_TAG_typedef:
+            case DW_TAG_class_type:
+            case DW_TAG_structure_type:
+            case DW_TAG_union_type:
+            {
+                const auto name = normalizedTypeName(typeDie);
+                for (const auto syncTypeName : syncTypeNames) {
+                    if (name == syncTypeName)
+                        return true;
+                }
+                if (typeDie->tag() != DW_TAG_typedef)
+                    return false;
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+static bool isWritableType(DwarfDie *typeDie)
+{
+    while (typeDie) {
+        switch (typeDie->tag()) {
+            case DW_TAG_const_type:
+                return false;
+            case DW_TAG_volatile_type:
+            case DW_TAG_typedef:
+            case DW_TAG_array_type:
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+            default:
+                return true;
+        }
+    }
+    return true;
+}
+
+static QString memberName(DwarfDie *memberDie)
+{
+    if (memberDie->tag() == DW_TAG_inheritance) {
+        const auto baseDie = memberDie->attribute(DW_AT_type).value<DwarfDie*>();
+        return QLatin1String("base ") + QString::fromUtf8(baseDie ? baseDie->typeName() : QByteArray());
+    }
+    return QString::fromUtf8(memberDie->name());
+}
+#endif
+
+QVector<CacheLineCheck::Member> CacheLineCheck::memberLayout(DwarfDie* structDie) const
+{
+    QVector<Member> layout;
+#if HAVE_DWARF
+    int nextMemberLocation = 0;
+    bool skipPadding = false;
+    foreach (auto memberDie, StructurePackingCheck::structureMembers(structDie)) {
+        const auto unresolvedTypeDie = memberDie->attribute(DW_AT_type).value<DwarfDie*>();
+        if (!unresolvedTypeDie)
+            continue;
+
+        Member m;
+        m.die = memberDie;
+        m.typeDie = m_packingCheck.findTypeDefinition(unresolvedTypeDie);
+        m.offset = StructurePackingCheck::memberLocation(memberDie);
+        m.size = m.typeDie->typeSize();
+        m.padding = skipPadding ? 0 : std::max(0, m.offset - nextMemberLocation);
+        m.isSync = isSynchronizationType(unresolvedTypeDie);
+        m.isWritable = isWritableType(unresolvedTypeDie);
+        // natural alignment never needs more than alignment - 1 bytes of padding
+        const auto alignment = m.typeDie->typeAlignment();
+        m.isOverAligned = alignment > 0 && m.padding >= alignment;
+        layout.push_back(m);
+
+        skipPadding = m.size <= 0;
+        nextMemberLocation = std::max(nextMemberLocation, m.offset + m.size);
+    }
+#else
+    Q_UNUSED(structDie);
+#endif
+    return layout;
+}
+
+QString CacheLineCheck::analyzeStructure(DwarfDie* structDie, bool* hasIssues) const
+{
+    QString str;
+    *hasIssues = false;
+#if HAVE_DWARF
+    assert(structDie->tag() == DW_TAG_class_type || structDie->tag() == DW_TAG_structure_type);
+
+    const int structSize = structDie->typeSize();
+    if (structSize <= 0)
+        return str;
+
+    const auto members = memberLayout(structDie);
+    const int lineCount = (structSize + m_lineSize - 1) / m_lineSize;
+
+    QStringList straddling;
+    QStringList overAligned;
+    QStringList falseSharing;
+    QBitArray firstLineUsage(std::min(structSize, m_lineSize));
+    int endOfLastMember = 0;
+
+    for (int i = 0; i < members.size(); ++i) {
+        const auto &m = members.at(i);
+        if (m.isOverAligned)
+            overAligned.push_back(memberName(m.die) + QLatin1String(" (") + QString::number(m.padding) + QLatin1String(" byte(s) padding)"));
+        if (m.size <= 0)
+            continue;
+
+        endOfLastMember = std::max(endOfLastMember, m.offset + m.size);
+        const int firstLine = m.offset / m_lineSize;
+        const int lastLine = (m.offset + m.size - 1) / m_lineSize;
+        if (m.size <= m_lineSize && firstLine != lastLine)
+            straddling.push_back(memberName(m.die));
+        if (m.offset < firstLineUsage.size())
+            firstLineUsage.fill(true, m.offset, std::min(m.offset + m.size, firstLineUsage.size()));
+
+        if (!m.isSync)
+            continue;
+        QStringList sharing;
+        for (int j = 0; j < members.size(); ++j) {
+            const auto &other = members.at(j);
+            if (i == j || other.size <= 0 || !other.isWritable)
+                continue;
+            const int otherFirstLine = other.offset / m_lineSize;
+            const int otherLastLine = (other.offset + other.size - 1) / m_lineSize;
+            if (otherLastLine < firstLine || otherFirstLine > lastLine)
+                continue;
+            sharing.push_back(memberName(other.die));
+        }
+        if (!sharing.isEmpty())
+            falseSharing.push_back(memberName(m.die) + QLatin1String(" shares a cache line with: ") + sharing.join(QLatin1String(", ")));
+    }
+
+    // only relevant if the structure occupies at least one full cache line
+    const int firstLineUsed = firstLineUsage.count(true);
+    const bool firstLinePadding = structSize >= m_lineSize && firstLineUsed * 2 < firstLineUsage.size();
+
+    *hasIssues = !straddling.isEmpty() || !overAligned.isEmpty() || !falseSharing.isEmpty() || firstLinePadding;
+
+    QTextStream s(&str);
+    s << "Cache lines: " << lineCount << " (" << m_lineSize << " bytes per line)\n";
+    if (!straddling.isEmpty())
+        s << "Members straddling a cache line boundary: " << straddling.join(QLatin1String(", ")) << "\n";
+    foreach (const auto &sharing, falseSharing)
+        s << "Possible false sharing: synchronization member " << sharing << "\n";
+    if (firstLinePadding)
+        s << "First cache line is mostly padding: " << firstLineUsed << "/" << firstLineUsage.size() << " bytes used\n";
+    if (!overAligned.isEmpty())
+        s << "Over-aligned members: " << overAligned.join(QLatin1String(", ")) << "\n";
+    s << "\n";
+
+    s << (structDie->tag() == DW_TAG_class_type ? "class " : "struct ");
+    s << structDie->fullyQualifiedName();
+    s << " // location: " << structDie->sourceLocation();
+    s << "\n{\n";
+
+    int currentLine = -1;
+    for (const auto &m : members) {
+        if (m.padding > 0)
+            s << "    // " << m.padding << " byte(s) padding\n";
+
+        const int firstLine = m.offset / m_lineSize;
+        if (firstLine > currentLine) {
+            s << "    // --- cache line " << firstLine << " (offset " << firstLine * m_lineSize << ") ---\n";
+            currentLine = firstLine;
+        }
+
+        s << "    ";
+        if (m.die->tag() == DW_TAG_inheritance)
+            s << "inherits ";
+        // we use the unresolved DIE here to have the user-visible type name, e.g. of a typedef
+        s << m.die->attribute(DW_AT_type).value<DwarfDie*>()->fullyQualifiedName() << " " << m.die->name();
+        s << "; // offset: " << m.offset << ", size: " << m.size;
+        if (m.size > 0) {
+            const int lastLine = (m.offset + m.size - 1) / m_lineSize;
+            if (lastLine != firstLine) {
+                s << ", spans cache lines " << firstLine << "-" << lastLine;
+                currentLine = lastLine;
+            }
+        }
+        if (m.isSync)
+            s << ", synchronization";
+        else if (!m.isWritable)
+            s << ", read-only";
+        s << "\n";
+    }
+
+    if (endOfLastMember < structSize && (members.isEmpty() || members.last().size > 0))
+        s << "    // " << (structSize - endOfLastMember) << " byte(s) padding\n";
+
+    s << "}; // size: " << structSize << ", alignment: " << structDie->typeAlignment() << "\n";
+#else
+    Q_UNUSED(structDie);
+#endif
+    return str;
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef CACHELINECHECK_H
+#define CACHELINECHECK_H
+
+#include "structurepackingcheck.h"
+
+#include <QSet>
+#include <QVector>
+
+class ElfFileSet;
+class DwarfInfo;
+class DwarfDie;
+
+class QString;
+
+/** Analyze data structure layouts with respect to cache line boundaries.
+ *  This flags members straddling cache lines, synchronization primitives sharing
+ *  a cache line with other writable members (false sharing), mostly empty first
+ *  cache lines and padding caused by over-aligned members.
+ */
+class CacheLineCheck
+{
+public:
+    CacheLineCheck() = default;
+    CacheLineCheck(const CacheLineCheck&) = default;
+    ~CacheLineCheck() = default;
+
+    CacheLineCheck& operator=(const CacheLineCheck&) = default;
+
+    /** Set the ELF file set the checked DWARF info belongs to.*/
+    void setElfFileSet(ElfFileSet *fileSet);
+    /** Cache line size in bytes, 64 by default. */
+    void setCacheLineSize(int size);
+
+    /** Dump all structures with cache line layout issues to stdout. */
+    void checkAll(DwarfInfo* info);
+    /** Annotated cache line layout of a single structure. */
+    QString checkOneStructure(DwarfDie *structDie) const;
+
+private:
+    struct Member {
+        DwarfDie *die;
+        DwarfDie *typeDie;
+        int offset;
+        int size;
+        int padding;
+        bool isSync;
+        bool isWritable;
+        bool isOverAligned;
+    };
+
+    void checkDie(DwarfDie *die);
+    QVector<Member> memberLayout(DwarfDie *structDie) const;
+    QString analyzeStructure(DwarfDie *structDie, bool *hasIssues) const;
+
+    StructurePackingCheck m_packingCheck;
+    QSet<QString> m_duplicateCheck;
+    int m_lineSize = 64;
+};
+
+#endif // CACHELINECHECK_H
@@ -0,0 +1,249 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "debuginfosizecheck.h"
+
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+
+#include <dwarf.h>
+#include <libdwarf.h>
+#endif
+
+#include <QDir>
+
+#include <algorithm>
+#include <iostream>
+
+static QVector<DebugInfoSizeCheck::Entry> sortedEntries(const QHash<QString, DebugInfoSizeCheck::Entry> &entries)
+{
+    QVector<DebugInfoSizeCheck::Entry> v;
+    v.reserve(entries.size());
+    for (const auto &entry : entries)
+        v.push_back(entry);
+    std::sort(v.begin(), v.end(), [](const DebugInfoSizeCheck::Entry &lhs, const DebugInfoSizeCheck::Entry &rhs) {
+        return lhs.size > rhs.size;
+    });
+    return v;
+}
+
+void DebugInfoSizeCheck::analyze(DwarfInfo* info)
+{
+#if HAVE_DWARF
+    if (!info)
+        return;
+
+    foreach (auto cu, info->compilationUnits()) {
+        Dwarf_Off cuOffset = 0;
+        Dwarf_Off cuLength = 0;
+        if (dwarf_die_CU_offset_range(cu->dieHandle(), &cuOffset, &cuLength, nullptr) != DW_DLV_OK)
+            continue;
+
+        const auto name = QString::fromUtf8(cu->name());
+        auto &entry = m_cus[name];
+        entry.name = name;
+        entry.size += cuLength;
+        ++entry.count;
+        m_totalSize += cuLength;
+
+        scanChildren(cu, cuOffset + cuLength, cu);
+    }
+#else
+    Q_UNUSED(info);
+#endif
+}
+
+void DebugInfoSizeCheck::scanChildren(DwarfDie* parent, quint64 end, DwarfCuDie* cu)
+{
+#if HAVE_DWARF
+    // DIEs are stored in pre-order, so the subtree of a DIE extends until its next sibling
+    const auto children = parent->children();
+    for (int i = 0; i < children.size(); ++i) {
+        const auto child = children.at(i);
+        const quint64 childEnd = i + 1 < children.size() ? children.at(i + 1)->offset() : end;
+        if (child->tag() == DW_TAG_namespace)
+            scanChildren(child, childEnd, cu);
+        else
+            recordDie(child, childEnd - child->offset(), cu);
+    }
+#else
+    Q_UNUSED(parent);
+    Q_UNUSED(end);
+    Q_UNUSED(cu);
+#endif
+}
+
+#if HAVE_DWARF
+static bool isTypeDie(DwarfDie *die)
+{
+    switch (die->tag()) {
+        case DW_TAG_array_type:
+        case DW_TAG_base_type:
+        case DW_TAG_class_type:
+        case DW_TAG_const_type:
+        case DW_TAG_enumeration_type:
+        case DW_TAG_pointer_type:
+        case DW_TAG_ptr_to_member_type:
+        case DW_TAG_reference_type:
+        case DW_TAG_restrict_type:
+        case DW_TAG_rvalue_reference_type:
+        case DW_TAG_structure_type:
+        case DW_TAG_subroutine_type:
+        case DW_TAG_typedef:
+        case DW_TAG_union_type:
+        case DW_TAG_volatile_type:
+            return true;
+    }
+    return false;
+}
+#endif
+
+void DebugInfoSizeCheck::recordDie(DwarfDie* die, quint64 size, DwarfCuDie* cu)
+{
+#if HAVE_DWARF
+    m_topLevelDies.push_back({ cu, die, size });
+
+    auto file = declaringFile(die);
+    if (file.isEmpty())
+        file = QStringLiteral("<unknown>");
+    auto &fileEntry = m_files[file];
+    fileEntry.name = file;
+    fileEntry.size += size;
+    ++fileEntry.count;
+
+    if (!isTypeDie(die))
+        return;
+
+    const auto typeName = QString::fromUtf8(die->name().isEmpty() ? die->typeName() : die->fullyQualifiedName());
+    auto &typeEntry = m_types[typeName];
+    typeEntry.name = typeName;
+    typeEntry.size += size;
+    ++typeEntry.count;
+
+    // ODR: the same named type defined at the same location in multiple CUs
+    switch (die->tag()) {
+        case DW_TAG_class_type:
+        case DW_TAG_structure_type:
+        case DW_TAG_union_type:
+        case DW_TAG_enumeration_type:
+            break;
+        default:
+            return;
+    }
+    if (die->name().isEmpty() || die->attribute(DW_AT_declaration).toBool())
+        return;
+    const auto key = typeName + QLatin1String(" // location: ") + file + QLatin1Char(':') + QString::number(die->attribute(DW_AT_decl_line).toInt());
+    auto &dup = m_duplicates[key];
+    dup.totalSize += size;
+    dup.maxSize = std::max(dup.maxSize, size);
+    ++dup.count;
+#else
+    Q_UNUSED(die);
+    Q_UNUSED(size);
+    Q_UNUSED(cu);
+#endif
+}
+
+QString DebugInfoSizeCheck::declaringFile(DwarfDie* die)
+{
+#if HAVE_DWARF
+    const auto filePath = die->attribute(DW_AT_decl_file).toString();
+    if (filePath.isEmpty() || !QDir::isRelativePath(filePath))
+        return filePath;
+    const auto cu = die->compilationUnit();
+    if (!cu)
+        return filePath;
+    return QDir::cleanPath(cu->attribute(DW_AT_comp_dir).toString() + QLatin1Char('/') + filePath);
+#else
+    Q_UNUSED(die);
+    return {};
+#endif
+}
+
+quint64 DebugInfoSizeCheck::totalSize() const
+{
+    return m_totalSize;
+}
+
+QVector<DebugInfoSizeCheck::Entry> DebugInfoSizeCheck::compilationUnits() const
+{
+    return sortedEntries(m_cus);
+}
+
+QVector<DebugInfoSizeCheck::Entry> DebugInfoSizeCheck::types() const
+{
+    return sortedEntries(m_types);
+}
+
+QVector<DebugInfoSizeCheck::Entry> DebugInfoSizeCheck::sourceFiles() const
+{
+    return sortedEntries(m_files);
+}
+
+QVector<DebugInfoSizeCheck::Entry> DebugInfoSizeCheck::duplicateTypes() const
+{
+    QHash<QString, Entry> entries;
+    for (auto it = m_duplicates.constBegin(); it != m_duplicates.constEnd(); ++it) {
+        if (it.value().count < 2)
+            continue;
+        Entry entry;
+        entry.name = it.key();
+        entry.size = it.value().totalSize - it.value().maxSize;
+        entry.count = it.value().count;
+        entries.insert(it.key(), entry);
+    }
+    return sortedEntries(entries);
+}
+
+const QVector<DebugInfoSizeCheck::DieSize>& DebugInfoSizeCheck::topLevelDies() const
+{
+    return m_topLevelDies;
+}
+
+static void printEntries(const char *title, const QVector<DebugInfoSizeCheck::Entry> &entries, quint64 totalSize, int limit, const char *countLabel)
+{
+    std::cout << title << ":" << std::endl;
+    for (int i = 0; i < entries.size() && (limit <= 0 || i < limit); ++i) {
+        const auto &entry = entries.at(i);
+        std::cout << "  " << entry.size << " bytes";
+        if (totalSize > 0)
+            std::cout << " (" << qPrintable(QString::number(double(entry.size * 100) / double(totalSize), 'g', 4)) << "%)";
+        std::cout << ", " << entry.count << " " << countLabel << ": " << qPrintable(entry.name) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void DebugInfoSizeCheck::printReport(int limit) const
+{
+    std::cout << "Total .debug_info size: " << m_totalSize << " bytes" << std::endl << std::endl;
+    printEntries("Compilation units", compilationUnits(), m_totalSize, limit, "unit(s)");
+    printEntries("Declaring source files", sourceFiles(), m_totalSize, limit, "DIE(s)");
+    printEntries("Types", types(), m_totalSize, limit, "definition(s)");
+
+    const auto duplicates = duplicateTypes();
+    quint64 duplicateSize = 0;
+    for (const auto &dup : duplicates)
+        duplicateSize += dup.size;
+    printEntries("Duplicated type definitions (redundant bytes)", duplicates, m_totalSize, limit, "copies");
+    std::cout << "Total redundant type definitions: " << duplicateSize << " bytes in " << duplicates.size() << " types";
+    if (m_totalSize > 0)
+        std::cout << " (" << qPrintable(QString::number(double(duplicateSize * 100) / double(m_totalSize), 'g', 4)) << "%)";
+    std::cout << std::endl;
+}
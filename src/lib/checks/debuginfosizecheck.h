@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DEBUGINFOSIZECHECK_H
+#define DEBUGINFOSIZECHECK_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class DwarfInfo;
+class DwarfDie;
+class DwarfCuDie;
+
+/** Attributes the size of .debug_info to compilation units, types and declaring source files,
+ *  and finds type definitions that are duplicated across compilation units.
+ */
+class DebugInfoSizeCheck
+{
+public:
+    DebugInfoSizeCheck() = default;
+    DebugInfoSizeCheck(const DebugInfoSizeCheck&) = default;
+    ~DebugInfoSizeCheck() = default;
+
+    DebugInfoSizeCheck& operator=(const DebugInfoSizeCheck&) = default;
+
+    struct Entry {
+        QString name;
+        quint64 size = 0;
+        int count = 0;
+    };
+
+    /** A DIE on compilation unit or namespace level, including all its children. */
+    struct DieSize {
+        DwarfCuDie *cu;
+        DwarfDie *die;
+        quint64 size;
+    };
+
+    /** Analyze all compilation units in @p info. Can be called repeatedly to accumulate multiple files. */
+    void analyze(DwarfInfo *info);
+
+    /** Total size of all analyzed compilation units, including headers. */
+    quint64 totalSize() const;
+
+    /** Size per compilation unit. */
+    QVector<Entry> compilationUnits() const;
+    /** Size per type name, count is the number of definitions. */
+    QVector<Entry> types() const;
+    /** Size per declaring source file, count is the number of top-level DIEs. */
+    QVector<Entry> sourceFiles() const;
+    /** Types defined in more than one compilation unit.
+     *  Size is the amount of bytes that could be saved by deduplication, count the number of definitions.
+     */
+    QVector<Entry> duplicateTypes() const;
+
+    /** All top-level DIEs with their size, for further aggregation. */
+    const QVector<DieSize>& topLevelDies() const;
+
+    /** Dump a size report to stdout, showing the @p limit largest entries of each category. */
+    void printReport(int limit) const;
+
+    /** Declaring file of @p die, without hitting the file system. */
+    static QString declaringFile(DwarfDie *die);
+
+private:
+    struct DuplicateInfo {
+        quint64 totalSize = 0;
+        quint64 maxSize = 0;
+        int count = 0;
+    };
+
+    void scanChildren(DwarfDie *parent, quint64 end, DwarfCuDie *cu);
+    void recordDie(DwarfDie *die, quint64 size, DwarfCuDie *cu);
+
+    QHash<QString, Entry> m_cus;
+    QHash<QString, Entry> m_types;
+    QHash<QString, Entry> m_files;
+    QHash<QString, DuplicateInfo> m_duplicates;
+    QVector<DieSize> m_topLevelDies;
+    quint64 m_totalSize = 0;
+};
+
+#endif // DEBUGINFOSIZECHECK_H
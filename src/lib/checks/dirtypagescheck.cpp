@@ -0,0 +1,222 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "dirtypagescheck.h"
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfrelrsection.h>
+#include <elf/elfsectionheader.h>
+#include <elf/elfsegmentheader.h>
+
+#include <QString>
+
+#include <cassert>
+#include <iostream>
+
+#include <elf.h>
+
+void DirtyPagesCheck::setPageSize(uint64_t pageSize)
+{
+    assert(pageSize > 0 && (pageSize & (pageSize - 1)) == 0);
+    m_pageSize = pageSize;
+}
+
+uint64_t DirtyPagesCheck::pageSize() const
+{
+    return m_pageSize;
+}
+
+QString DirtyPagesCheck::Segment::pageMap() const
+{
+    QString s;
+    s.reserve(pages.size());
+    foreach (auto state, pages)
+        s += QLatin1Char(state);
+    return s;
+}
+
+int DirtyPagesCheck::Result::privatePages() const
+{
+    return dirtyPages + relroPages + textRelocationPages + zeroFillPages;
+}
+
+DirtyPagesCheck::Result DirtyPagesCheck::analyze(ElfFile* file) const
+{
+    Result result;
+    result.file = file;
+
+    // same rounding as _dl_protect_relro: only pages entirely inside the RELRO range are protected
+    uint64_t relroBegin = 0;
+    uint64_t relroEnd = 0;
+    foreach (auto phdr, file->segmentHeaders()) {
+        if (phdr->type() != PT_GNU_RELRO)
+            continue;
+        relroBegin = phdr->virtualAddress() & ~(m_pageSize - 1);
+        relroEnd = (phdr->virtualAddress() + phdr->memorySize()) & ~(m_pageSize - 1);
+    }
+
+    foreach (auto phdr, file->segmentHeaders()) {
+        if (phdr->type() != PT_LOAD || phdr->memorySize() == 0)
+            continue;
+        Segment seg;
+        seg.segment = phdr;
+        seg.firstPageAddress = phdr->virtualAddress() & ~(m_pageSize - 1);
+        const auto fileEnd = phdr->virtualAddress() + phdr->fileSize();
+        const auto memEnd = phdr->virtualAddress() + phdr->memorySize();
+        const auto pageCount = (memEnd - seg.firstPageAddress + m_pageSize - 1) / m_pageSize;
+        seg.pages.fill(Clean, (int)pageCount);
+
+        for (int i = 0; i < seg.pages.size(); ++i) {
+            const auto pageAddr = seg.firstPageAddress + i * m_pageSize;
+            if (pageAddr >= fileEnd)
+                seg.pages[i] = Anonymous;
+            else if (memEnd > fileEnd && pageAddr + m_pageSize > fileEnd)
+                seg.pages[i] = ZeroFill;
+        }
+        result.segments.push_back(seg);
+    }
+
+    const auto markPage = [this, &result, relroBegin, relroEnd](uint64_t offset) {
+        for (auto &seg : result.segments) {
+            if (offset < seg.segment->virtualAddress() || offset >= seg.segment->virtualAddress() + seg.segment->memorySize())
+                continue;
+            ++result.relocationCount;
+            const auto pageAddr = offset & ~(m_pageSize - 1);
+            auto &state = seg.pages[(pageAddr - seg.firstPageAddress) / m_pageSize];
+            if ((seg.segment->flags() & PF_W) == 0)
+                state = TextRelocation;
+            else if (pageAddr >= relroBegin && pageAddr < relroEnd)
+                state = RelRo;
+            else
+                state = Dirty;
+            return;
+        }
+    };
+
+    foreach (auto shdr, file->sectionHeaders()) {
+        if ((shdr->flags() & SHF_ALLOC) == 0)
+            continue;
+        switch (shdr->type()) {
+            case SHT_REL:
+            case SHT_RELA:
+            {
+                const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+                for (uint64_t i = 0; relocSection && i < shdr->entryCount(); ++i)
+                    markPage(relocSection->entry(i)->offset());
+                break;
+            }
+            case SHT_RELR:
+            case SHT_ANDROID_RELR:
+            {
+                const auto relrSection = file->section<ElfRelrSection>(shdr->sectionIndex());
+                if (relrSection) {
+                    foreach (auto offset, relrSection->relocationOffsets())
+                        markPage(offset);
+                }
+                break;
+            }
+            case SHT_ANDROID_REL:
+            case SHT_ANDROID_RELA:
+            {
+                const auto packedSection = file->section<ElfPackedRelocationSection>(shdr->sectionIndex());
+                if (packedSection) {
+                    foreach (auto offset, packedSection->relocationOffsets())
+                        markPage(offset);
+                }
+                break;
+            }
+        }
+    }
+
+    foreach (const auto &seg, result.segments) {
+        foreach (auto state, seg.pages) {
+            switch (state) {
+                case Clean:
+                    break;
+                case Dirty:
+                    ++result.dirtyPages;
+                    break;
+                case RelRo:
+                    ++result.relroPages;
+                    break;
+                case TextRelocation:
+                    ++result.textRelocationPages;
+                    break;
+                case ZeroFill:
+                    ++result.zeroFillPages;
+                    break;
+                case Anonymous:
+                    ++result.anonymousPages;
+                    break;
+            }
+        }
+    }
+
+    return result;
+}
+
+void DirtyPagesCheck::printReport(ElfFileSet* fileSet, bool withPageMap) const
+{
+    int totalPrivatePages = 0;
+    int totalRelroPages = 0;
+    int totalAnonymousPages = 0;
+
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto result = analyze(fileSet->file(i));
+        totalPrivatePages += result.privatePages();
+        totalRelroPages += result.relroPages;
+        totalAnonymousPages += result.anonymousPages;
+
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.privatePages() << " private pages ("
+                  << result.relocationCount << " relocations dirty " << (result.dirtyPages + result.relroPages + result.textRelocationPages)
+                  << " pages, " << result.relroPages << " of them read-only after RELRO";
+        if (result.textRelocationPages > 0)
+            std::cout << ", " << result.textRelocationPages << " text relocation pages";
+        std::cout << ", " << result.zeroFillPages << " zero-filled), " << result.anonymousPages << " .bss pages" << std::endl;
+
+        if (!withPageMap)
+            continue;
+        foreach (const auto &seg, result.segments)
+            std::cout << "  0x" << std::hex << seg.firstPageAddress << std::dec << ": " << qPrintable(seg.pageMap()) << std::endl;
+    }
+
+    std::cout << "Private memory per process: " << totalPrivatePages << " pages (" << (totalPrivatePages * m_pageSize / 1024) << " kB), "
+              << totalRelroPages << " of them read-only after RELRO, plus up to " << totalAnonymousPages
+              << " .bss pages (" << (totalAnonymousPages * m_pageSize / 1024) << " kB)" << std::endl;
+    if (withPageMap) {
+        std::cout << "Page map legend: " << (char)Clean << " clean, " << (char)Dirty << " dirty, " << (char)RelRo << " RELRO, "
+                  << (char)TextRelocation << " text relocation, " << (char)ZeroFill << " zero-filled, " << (char)Anonymous << " .bss" << std::endl;
+    }
+}
+
+QString DirtyPagesCheck::printResult(const Result& result) const
+{
+    QString s;
+    s += QLatin1String("Private pages: ") + QString::number(result.privatePages()) + " (" + QString::number(result.privatePages() * m_pageSize / 1024) + " kB)<br/>";
+    s += QLatin1String("Relocated pages: ") + QString::number(result.dirtyPages + result.relroPages + result.textRelocationPages)
+       + " (" + QString::number(result.relroPages) + " read-only after RELRO, " + QString::number(result.textRelocationPages) + " text relocations)<br/>";
+    s += QLatin1String("Zero-filled pages: ") + QString::number(result.zeroFillPages) + "<br/>";
+    s += QLatin1String(".bss pages: ") + QString::number(result.anonymousPages) + "<br/>";
+    s += QLatin1String("<tt>");
+    foreach (const auto &seg, result.segments)
+        s += "0x" + QString::number(seg.firstPageAddress, 16) + ": " + seg.pageMap() + "<br/>";
+    s += QLatin1String("</tt>");
+    return s;
+}
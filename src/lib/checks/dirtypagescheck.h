@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DIRTYPAGESCHECK_H
+#define DIRTYPAGESCHECK_H
+
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSegmentHeader;
+
+class QString;
+
+/** Estimates the private memory each loaded file costs per process.
+ *  Every page of a PT_LOAD segment written to by a relocation becomes a private copy
+ *  of the file-backed page, as does the partial page zero-filled at the end of the file
+ *  data of a segment. Pages in PT_GNU_RELRO are made read-only again after relocation,
+ *  but stay private.
+ */
+class DirtyPagesCheck
+{
+public:
+    DirtyPagesCheck() = default;
+    DirtyPagesCheck(const DirtyPagesCheck&) = default;
+    ~DirtyPagesCheck() = default;
+
+    DirtyPagesCheck& operator=(const DirtyPagesCheck&) = default;
+
+    /** Page size in bytes, 4096 by default. */
+    void setPageSize(uint64_t pageSize);
+    uint64_t pageSize() const;
+
+    enum PageState : char {
+        Clean = '.', ///< shared with the page cache
+        Dirty = 'D', ///< written by relocations, remains writable
+        RelRo = 'R', ///< written by relocations, read-only after PT_GNU_RELRO is applied
+        TextRelocation = 'T', ///< written by relocations in a non-writable segment (DT_TEXTREL)
+        ZeroFill = 'Z', ///< partially zero-filled end of the file data
+        Anonymous = 'B' ///< beyond the file data (.bss), only allocated when touched
+    };
+
+    struct Segment {
+        ElfSegmentHeader *segment = nullptr;
+        uint64_t firstPageAddress = 0;
+        QVector<PageState> pages;
+
+        /** One character per page, see PageState. */
+        QString pageMap() const;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        QVector<Segment> segments;
+        int relocationCount = 0;
+        int dirtyPages = 0;
+        int relroPages = 0;
+        int textRelocationPages = 0;
+        int zeroFillPages = 0;
+        int anonymousPages = 0;
+
+        /** Pages copied for every process loading this file. */
+        int privatePages() const;
+    };
+
+    Result analyze(ElfFile *file) const;
+
+    /** Dump the estimates for all files in @p fileSet to stdout, optionally with page maps. */
+    void printReport(ElfFileSet *fileSet, bool withPageMap) const;
+    /** HTML summary and page map of @p result, for the file details view. */
+    QString printResult(const Result &result) const;
+
+private:
+    uint64_t m_pageSize = 4096;
+};
+
+#endif // DIRTYPAGESCHECK_H
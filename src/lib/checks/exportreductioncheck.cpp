@@ -0,0 +1,321 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "exportreductioncheck.h"
+
+#include <demangle/demangler.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfgnusymbolversiondefinition.h>
+#include <elf/elfgnusymbolversiondefinitionauxiliaryentry.h>
+#include <elf/elfgnusymbolversiondefinitionssection.h>
+#include <elf/elfgnusymbolversiontable.h>
+#include <elf/elfheader.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QHash>
+#include <QIODevice>
+#include <QSet>
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include <elf.h>
+
+ExportReductionCheck::ExportReductionCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+}
+
+int ExportReductionCheck::Result::hiddenCount() const
+{
+    return counts[UsedInternally] + counts[Unused];
+}
+
+uint64_t ExportReductionCheck::Result::savedBytes() const
+{
+    return dynsymSize + dynstrSize + versymSize + hashSize;
+}
+
+const char* ExportReductionCheck::usageName(Usage usage)
+{
+    switch (usage) {
+        case Required: return "required";
+        case UsedExternally: return "used externally";
+        case UsedInternally: return "used internally";
+        case Unused: return "unused";
+    }
+    return "";
+}
+
+/** Symbols looked up by name at runtime, or compared by address across libraries. */
+static bool isRequired(const char *name)
+{
+    static const char* const requiredNames[] = { "_init", "_fini", "main", "JNI_OnLoad", "JNI_OnUnload", "qt_plugin_instance" };
+    for (auto requiredName : requiredNames) {
+        if (strcmp(name, requiredName) == 0)
+            return true;
+    }
+    if (strncmp(name, "qt_plugin_query_metadata", 24) == 0)
+        return true;
+
+    const auto symbolType = Demangler::symbolType(name);
+    return symbolType == Demangler::SymbolType::TypeInfo || symbolType == Demangler::SymbolType::TypeInfoName;
+}
+
+QVector<ExportReductionCheck::Result> ExportReductionCheck::analyze() const
+{
+    QVector<Result> results;
+    for (int i = 0; i < m_fileSet->size(); ++i) {
+        if (m_fileSet->file(i)->isExecutable())
+            continue;
+        results.push_back(analyzeFile(i));
+    }
+    return results;
+}
+
+ExportReductionCheck::Result ExportReductionCheck::analyzeFile(int fileIndex) const
+{
+    Result result;
+    result.file = m_fileSet->file(fileIndex);
+    const auto file = result.file;
+    const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+    if (!symTab)
+        return result;
+
+    QSet<QByteArray> imports;
+    for (int i = 0; i < m_fileSet->size(); ++i) {
+        if (i == fileIndex)
+            continue;
+        const auto otherFile = m_fileSet->file(i);
+        const auto otherSymTab = otherFile->section<ElfSymbolTableSection>(otherFile->indexOfSection(SHT_DYNSYM));
+        if (!otherSymTab)
+            continue;
+        for (uint32_t j = 1; j < otherSymTab->header()->entryCount(); ++j) {
+            const auto entry = otherSymTab->entry(j);
+            if (entry->sectionIndex() == SHN_UNDEF)
+                imports.insert(entry->name());
+        }
+    }
+
+    QSet<uint32_t> relocatedSymbols;
+    foreach (const auto shdr, file->sectionHeaders()) {
+        if ((shdr->type() != SHT_REL && shdr->type() != SHT_RELA) || !(shdr->flags() & SHF_ALLOC))
+            continue;
+        const auto relocs = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocs || relocs->linkedSection<ElfSymbolTableSection>() != symTab)
+            continue;
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i)
+            relocatedSymbols.insert(relocs->entry(i)->symbolIndex());
+    }
+
+    const auto verSymTab = file->section<ElfGNUSymbolVersionTable>(file->indexOfSection(SHT_GNU_versym));
+    const auto verDefIndex = file->indexOfSection(SHT_GNU_verdef);
+    const auto verDefSection = verDefIndex > 0 ? file->section<ElfGNUSymbolVersionDefinitionsSection>(verDefIndex) : nullptr;
+    const auto hashTableCount = (file->indexOfSection(SHT_GNU_HASH) >= 0 ? 1 : 0) + (file->indexOfSection(SHT_HASH) >= 0 ? 1 : 0);
+
+    QSet<QByteArray> hiddenNames;
+    for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+        const auto entry = symTab->entry(i);
+        if (!entry->hasValidSection() || entry->bindType() == STB_LOCAL)
+            continue;
+        if (entry->visibility() != STV_DEFAULT && entry->visibility() != STV_PROTECTED)
+            continue;
+        if (entry->type() == STT_NOTYPE || entry->type() == STT_SECTION || entry->type() == STT_FILE)
+            continue;
+
+        Export exp;
+        exp.symbol = entry;
+        bool isCompatSymbol = false;
+        if (verSymTab) {
+            const auto versionIndex = verSymTab->versionIndex(i);
+            isCompatSymbol = verSymTab->isHidden(i);
+            if (verDefSection && versionIndex > VER_NDX_GLOBAL) {
+                const auto verDef = verDefSection->definitionForVersionIndex(versionIndex);
+                if (verDef)
+                    exp.version = verDef->auxiliaryEntry(0)->name();
+            }
+        }
+
+        if (isCompatSymbol || isRequired(entry->name()))
+            exp.usage = Required;
+        else if (imports.contains(entry->name()))
+            exp.usage = UsedExternally;
+        else if (relocatedSymbols.contains(i))
+            exp.usage = UsedInternally;
+        else
+            exp.usage = Unused;
+        result.counts[exp.usage]++;
+        result.exports.push_back(exp);
+
+        if (exp.usage != UsedInternally && exp.usage != Unused)
+            continue;
+        hiddenNames.insert(entry->name());
+        result.dynsymSize += symTab->header()->entrySize();
+        // upper bound, the linker might share string suffixes
+        result.dynstrSize += strlen(entry->name()) + 1;
+        if (verSymTab)
+            result.versymSize += sizeof(uint16_t);
+        result.hashSize += hashTableCount * sizeof(uint32_t);
+    }
+
+    GnuHashOptimizer hashOpt(file);
+    if (hashOpt.isValid()) {
+        hashOpt.addImports(m_fileSet);
+        const auto params = hashOpt.currentParameters();
+        result.currentLookups = hashOpt.simulate(params);
+        hashOpt.removeExports(hiddenNames);
+        result.reducedLookups = hashOpt.simulate(params);
+        result.hasLookupEstimate = true;
+    }
+
+    return result;
+}
+
+void ExportReductionCheck::writeVersionScript(const Result& result, QIODevice* device)
+{
+    // every version node the library defines must be written, .symver directives in the sources refer to them
+    QVector<QByteArray> versions;
+    QHash<QByteArray, QByteArray> parents;
+    const auto verDefIndex = result.file->indexOfSection(SHT_GNU_verdef);
+    const auto verDefSection = verDefIndex > 0 ? result.file->section<ElfGNUSymbolVersionDefinitionsSection>(verDefIndex) : nullptr;
+    for (uint32_t i = 0; verDefSection && i < verDefSection->entryCount(); ++i) {
+        const auto verDef = verDefSection->definition(i);
+        if ((verDef->flags() & VER_FLG_BASE) || verDef->auxiliarySize() == 0)
+            continue;
+        const QByteArray version = verDef->auxiliaryEntry(0)->name();
+        versions.push_back(version);
+        if (verDef->auxiliarySize() > 1)
+            parents.insert(version, verDef->auxiliaryEntry(1)->name());
+    }
+
+    QHash<QByteArray, QVector<QByteArray>> globals;
+    QHash<QByteArray, QVector<QByteArray>> locals;
+    QSet<QByteArray> globalNames;
+    QSet<QByteArray> seen;
+    foreach (const auto &exp, result.exports) {
+        if (exp.usage != Required && exp.usage != UsedExternally)
+            continue;
+        const QByteArray name = exp.symbol->name();
+        globalNames.insert(name);
+        if (seen.contains(exp.version + '@' + name))
+            continue;
+        seen.insert(exp.version + '@' + name);
+        if (!versions.contains(exp.version))
+            versions.push_back(exp.version);
+        globals[exp.version].push_back(name);
+    }
+
+    // ld rejects a name that is global in one node and local in another, those stay exported anyway
+    seen.clear();
+    foreach (const auto &exp, result.exports) {
+        if (exp.usage == Required || exp.usage == UsedExternally)
+            continue;
+        const QByteArray name = exp.symbol->name();
+        if (globalNames.contains(name) || seen.contains(name))
+            continue;
+        seen.insert(name);
+        if (!versions.contains(exp.version))
+            versions.push_back(exp.version);
+        locals[exp.version].push_back(name);
+    }
+
+    device->write("/* " + result.file->displayName().toUtf8() + ": " + QByteArray::number(result.exports.size() - result.hiddenCount())
+                  + " of " + QByteArray::number(result.exports.size()) + " exports kept */\n");
+
+    // ld does not allow mixing an anonymous version node with named ones
+    const auto unversionedGlobals = globals.take(QByteArray());
+    const auto unversionedLocals = locals.take(QByteArray());
+    versions.removeAll(QByteArray());
+    if (versions.isEmpty())
+        versions.push_back(QByteArray());
+    else if (!unversionedGlobals.isEmpty() || !unversionedLocals.isEmpty())
+        device->write("/* unversioned exports are added to the first version node */\n");
+
+    for (int i = 0; i < versions.size(); ++i) {
+        const auto &version = versions.at(i);
+        auto nodeGlobals = globals.value(version);
+        auto nodeLocals = locals.value(version);
+        if (i == 0) {
+            nodeGlobals += unversionedGlobals;
+            nodeLocals += unversionedLocals;
+        }
+
+        device->write(version.isEmpty() ? QByteArray("{\n") : version + " {\n");
+        if (!nodeGlobals.isEmpty()) {
+            device->write("  global:\n");
+            foreach (const auto &name, nodeGlobals)
+                device->write("    " + name + ";\n");
+        }
+        if (!nodeLocals.isEmpty() || i == 0) {
+            device->write("  local:\n");
+            foreach (const auto &name, nodeLocals)
+                device->write("    " + name + ";\n");
+            if (i == 0)
+                device->write("    *;\n");
+        }
+        const auto parent = parents.value(version);
+        device->write(parent.isEmpty() ? QByteArray("};\n") : "} " + parent + ";\n");
+    }
+}
+
+void ExportReductionCheck::printReport(bool verbose) const
+{
+    uint64_t totalSavedBytes = 0;
+    int totalHidden = 0;
+    int totalExports = 0;
+    uint64_t currentCost = 0;
+    uint64_t reducedCost = 0;
+
+    foreach (const auto &result, analyze()) {
+        totalSavedBytes += result.savedBytes();
+        totalHidden += result.hiddenCount();
+        totalExports += result.exports.size();
+
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.exports.size() << " exports";
+        for (int usage = Required; usage <= Unused; ++usage)
+            std::cout << ", " << result.counts[usage] << " " << usageName(static_cast<Usage>(usage));
+        std::cout << std::endl;
+        std::cout << "  hiding " << result.hiddenCount() << " exports saves " << result.savedBytes() << " bytes (.dynsym: "
+                  << result.dynsymSize << ", .dynstr: " << result.dynstrSize << ", .gnu.version: " << result.versymSize
+                  << ", hash tables: " << result.hashSize << ")" << std::endl;
+        if (result.hasLookupEstimate) {
+            const auto &current = result.currentLookups.stats;
+            const auto &reduced = result.reducedLookups.stats;
+            currentCost += current.bloomProbes + current.chainWalks + current.strcmpCalls;
+            reducedCost += reduced.bloomProbes + reduced.chainWalks + reduced.strcmpCalls;
+            std::cout << "  " << result.currentLookups.lookups << " lookups, probes per lookup: " << result.currentLookups.probesPerLookup()
+                      << " -> " << result.reducedLookups.probesPerLookup() << ", bloom false positive rate: "
+                      << result.currentLookups.bloomFalsePositiveRate() << " -> " << result.reducedLookups.bloomFalsePositiveRate() << std::endl;
+        }
+
+        if (!verbose)
+            continue;
+        foreach (const auto &exp, result.exports) {
+            if (exp.usage == UsedInternally || exp.usage == Unused)
+                std::cout << "    " << usageName(exp.usage) << ": " << Demangler::demangleFull(exp.symbol->name()).constData() << std::endl;
+        }
+    }
+
+    std::cout << std::endl << "Total: " << totalHidden << " of " << totalExports << " exports can be hidden, saving "
+              << totalSavedBytes << " bytes and " << (currentCost - reducedCost) << " of " << currentCost
+              << " lookup probes" << std::endl;
+}
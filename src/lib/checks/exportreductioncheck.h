@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef EXPORTREDUCTIONCHECK_H
+#define EXPORTREDUCTIONCHECK_H
+
+#include <optimizers/gnuhashoptimizer.h>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+
+class QIODevice;
+
+/** Classifies the exports of the libraries in an ElfFileSet by their users, and estimates
+ *  the size and lookup cost that hiding the ones not needed by other files would save.
+ *  Results are only valid for this file set, dlopen()/dlsym() users are not visible here.
+ */
+class ExportReductionCheck
+{
+public:
+    explicit ExportReductionCheck(ElfFileSet *fileSet);
+    ExportReductionCheck(const ExportReductionCheck&) = default;
+    ~ExportReductionCheck() = default;
+
+    ExportReductionCheck& operator=(const ExportReductionCheck&) = default;
+
+    enum Usage {
+        /** Needs to stay exported regardless of its users, e.g. RTTI, plugin entry points or compat symbols. */
+        Required,
+        /** Imported by another file of the set. */
+        UsedExternally,
+        /** Only referenced by relocations of the library itself. */
+        UsedInternally,
+        Unused
+    };
+
+    struct Export {
+        ElfSymbolTableEntry *symbol = nullptr;
+        Usage usage = Unused;
+        /** Version node, empty for unversioned symbols. */
+        QByteArray version;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        QVector<Export> exports;
+        int counts[Unused + 1] = {};
+        /** Bytes in .dynsym, .dynstr, .gnu.version and the hash tables hiding the internal and unused exports removes. */
+        uint64_t dynsymSize = 0;
+        uint64_t dynstrSize = 0;
+        uint64_t versymSize = 0;
+        uint64_t hashSize = 0;
+        /** Lookups of all imports of the file set in this library, with all and with the reduced exports. */
+        bool hasLookupEstimate = false;
+        GnuHashOptimizer::Estimate currentLookups;
+        GnuHashOptimizer::Estimate reducedLookups;
+
+        int hiddenCount() const;
+        uint64_t savedBytes() const;
+    };
+
+    /** Analyze all libraries of the set, executables are skipped. */
+    QVector<Result> analyze() const;
+    Result analyzeFile(int fileIndex) const;
+
+    static const char* usageName(Usage usage);
+
+    /** Write a version script keeping only the required and externally used exports of @p result. */
+    static void writeVersionScript(const Result &result, QIODevice *device);
+
+    /** Dump the results to stdout, listing the hideable symbols if @p verbose is set. */
+    void printReport(bool verbose) const;
+
+private:
+    ElfFileSet *m_fileSet;
+};
+
+#endif // EXPORTREDUCTIONCHECK_H
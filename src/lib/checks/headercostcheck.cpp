@@ -0,0 +1,232 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "headercostcheck.h"
+#include "debuginfosizecheck.h"
+
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+
+#include <dwarf.h>
+#include <libdwarf.h>
+#endif
+
+#include <QDir>
+
+#include <algorithm>
+#include <iostream>
+
+void HeaderCostCheck::analyze(DwarfInfo* info)
+{
+#if HAVE_DWARF
+    if (!info)
+        return;
+
+    foreach (auto cu, info->compilationUnits()) {
+        Dwarf_Off cuOffset = 0;
+        Dwarf_Off cuLength = 0;
+        if (dwarf_die_CU_offset_range(cu->dieHandle(), &cuOffset, &cuLength, nullptr) != DW_DLV_OK)
+            continue;
+        ++m_cuCount;
+
+        CuUsage usage;
+        const auto children = cu->children();
+        for (int i = 0; i < children.size(); ++i)
+            scanDie(children.at(i), i + 1 < children.size() ? children.at(i + 1)->offset() : cuOffset + cuLength, QString(), usage);
+
+        // the main source file is not a header
+        auto mainFile = QString::fromUtf8(cu->name());
+        if (QDir::isRelativePath(mainFile))
+            mainFile = QDir::cleanPath(cu->attribute(DW_AT_comp_dir).toString() + QLatin1Char('/') + mainFile);
+        usage.remove(mainFile);
+
+        for (auto it = usage.constBegin(); it != usage.constEnd(); ++it) {
+            auto &header = m_headers[it.key()];
+            header.fileName = it.key();
+            ++header.cuCount;
+            header.dieCount += it.value().dieCount;
+            header.size += it.value().size;
+            if (it.value().definesTypes && !it.value().directUse)
+                ++header.indirectUseCuCount;
+        }
+    }
+#else
+    Q_UNUSED(info);
+#endif
+}
+
+#if HAVE_DWARF
+static bool isTypeDefinition(DwarfDie *die)
+{
+    switch (die->tag()) {
+        case DW_TAG_class_type:
+        case DW_TAG_structure_type:
+        case DW_TAG_union_type:
+        case DW_TAG_enumeration_type:
+            return !die->attribute(DW_AT_declaration).toBool();
+    }
+    return false;
+}
+
+/** Follows typedefs, cv-qualifiers and arrays, but not pointers or references. */
+static DwarfDie* valueType(DwarfDie *typeDie)
+{
+    while (typeDie) {
+        switch (typeDie->tag()) {
+            case DW_TAG_typedef:
+            case DW_TAG_const_type:
+            case DW_TAG_volatile_type:
+            case DW_TAG_restrict_type:
+            case DW_TAG_array_type:
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+        }
+        return typeDie;
+    }
+    return nullptr;
+}
+#endif
+
+void HeaderCostCheck::scanDie(DwarfDie* die, quint64 end, const QString& parentFile, CuUsage& usage) const
+{
+#if HAVE_DWARF
+    auto file = DebugInfoSizeCheck::declaringFile(die);
+    if (file.isEmpty())
+        file = parentFile;
+
+    const auto children = die->children();
+    if (!file.isEmpty()) {
+        auto &fileUsage = usage[file];
+        ++fileUsage.dieCount;
+        fileUsage.size += (children.isEmpty() ? end : children.first()->offset()) - die->offset();
+        if (isTypeDefinition(die))
+            fileUsage.definesTypes = true;
+    }
+
+    // anything but pointers, references and the transparent type modifiers needs the complete type
+    switch (die->tag()) {
+        case DW_TAG_pointer_type:
+        case DW_TAG_reference_type:
+        case DW_TAG_rvalue_reference_type:
+        case DW_TAG_ptr_to_member_type:
+        case DW_TAG_typedef:
+        case DW_TAG_const_type:
+        case DW_TAG_volatile_type:
+        case DW_TAG_restrict_type:
+        case DW_TAG_array_type:
+            break;
+        default:
+        {
+            const auto typeDie = valueType(die->attribute(DW_AT_type).value<DwarfDie*>());
+            if (typeDie && isTypeDefinition(typeDie)) {
+                const auto typeFile = DebugInfoSizeCheck::declaringFile(typeDie);
+                if (!typeFile.isEmpty())
+                    usage[typeFile].directUse = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < children.size(); ++i)
+        scanDie(children.at(i), i + 1 < children.size() ? children.at(i + 1)->offset() : end, file, usage);
+#else
+    Q_UNUSED(die);
+    Q_UNUSED(end);
+    Q_UNUSED(parentFile);
+    Q_UNUSED(usage);
+#endif
+}
+
+int HeaderCostCheck::compilationUnitCount() const
+{
+    return m_cuCount;
+}
+
+QVector<HeaderCostCheck::Header> HeaderCostCheck::headers() const
+{
+    QVector<Header> headers;
+    headers.reserve(m_headers.size());
+    for (const auto &header : m_headers)
+        headers.push_back(header);
+    std::sort(headers.begin(), headers.end(), [](const Header &lhs, const Header &rhs) {
+        return lhs.size > rhs.size;
+    });
+    return headers;
+}
+
+QVector<HeaderCostCheck::Header> HeaderCostCheck::precompiledHeaderCandidates() const
+{
+    QVector<Header> headers;
+    for (const auto &header : m_headers) {
+        if (header.cuCount > 1)
+            headers.push_back(header);
+    }
+    std::sort(headers.begin(), headers.end(), [](const Header &lhs, const Header &rhs) {
+        if (lhs.cuCount == rhs.cuCount)
+            return lhs.size > rhs.size;
+        return lhs.cuCount > rhs.cuCount;
+    });
+    return headers;
+}
+
+QVector<HeaderCostCheck::Header> HeaderCostCheck::forwardDeclarationCandidates() const
+{
+    QVector<Header> headers;
+    for (const auto &header : m_headers) {
+        if (header.indirectUseCuCount > 0)
+            headers.push_back(header);
+    }
+    std::sort(headers.begin(), headers.end(), [](const Header &lhs, const Header &rhs) {
+        if (lhs.indirectUseCuCount == rhs.indirectUseCuCount)
+            return lhs.size > rhs.size;
+        return lhs.indirectUseCuCount > rhs.indirectUseCuCount;
+    });
+    return headers;
+}
+
+static void printHeader(const HeaderCostCheck::Header &header)
+{
+    std::cout << "  " << qPrintable(header.fileName) << ": " << header.cuCount << " CU(s), "
+              << header.dieCount << " DIE(s), " << header.size << " bytes";
+    if (header.indirectUseCuCount > 0)
+        std::cout << ", only used via pointers/references in " << header.indirectUseCuCount << " CU(s)";
+    std::cout << std::endl;
+}
+
+void HeaderCostCheck::printReport(int limit) const
+{
+    std::cout << "Analyzed " << m_cuCount << " compilation units, found " << m_headers.size() << " headers." << std::endl << std::endl;
+
+    std::cout << "Largest headers:" << std::endl;
+    const auto allHeaders = headers();
+    for (int i = 0; i < allHeaders.size() && (limit <= 0 || i < limit); ++i)
+        printHeader(allHeaders.at(i));
+    std::cout << std::endl;
+
+    std::cout << "Precompiled header candidates:" << std::endl;
+    const auto pchHeaders = precompiledHeaderCandidates();
+    for (int i = 0; i < pchHeaders.size() && (limit <= 0 || i < limit); ++i)
+        printHeader(pchHeaders.at(i));
+    std::cout << std::endl;
+
+    std::cout << "Forward declaration candidates:" << std::endl;
+    const auto fwdHeaders = forwardDeclarationCandidates();
+    for (int i = 0; i < fwdHeaders.size() && (limit <= 0 || i < limit); ++i)
+        printHeader(fwdHeaders.at(i));
+}
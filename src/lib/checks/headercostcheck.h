@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADERCOSTCHECK_H
+#define HEADERCOSTCHECK_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class DwarfInfo;
+class DwarfDie;
+
+/** Estimates the compile-time cost of headers based on the DW_AT_decl_file attributes in the debug information.
+ *  For every header this determines the number of compilation units including it and the DIEs and
+ *  .debug_info bytes attributed to it, to identify candidates for precompiled headers and for
+ *  replacing includes by forward declarations.
+ */
+class HeaderCostCheck
+{
+public:
+    HeaderCostCheck() = default;
+    HeaderCostCheck(const HeaderCostCheck&) = default;
+    ~HeaderCostCheck() = default;
+
+    HeaderCostCheck& operator=(const HeaderCostCheck&) = default;
+
+    struct Header {
+        QString fileName;
+        /** Number of compilation units containing DIEs declared in this header. */
+        int cuCount = 0;
+        /** Number of DIEs declared in this header, over all compilation units. */
+        int dieCount = 0;
+        /** .debug_info bytes attributed to this header, over all compilation units. */
+        quint64 size = 0;
+        /** Number of compilation units that use types defined in this header only via pointers or references. */
+        int indirectUseCuCount = 0;
+    };
+
+    /** Analyze all compilation units in @p info. Can be called repeatedly to accumulate multiple files. */
+    void analyze(DwarfInfo *info);
+
+    /** Number of analyzed compilation units. */
+    int compilationUnitCount() const;
+    /** All headers, sorted by size. */
+    QVector<Header> headers() const;
+    /** Headers included in more than one compilation unit, sorted by the number of including compilation units. */
+    QVector<Header> precompiledHeaderCandidates() const;
+    /** Headers whose types are only used via pointers or references, sorted by the number of such compilation units. */
+    QVector<Header> forwardDeclarationCandidates() const;
+
+    /** Dump a report to stdout, showing the @p limit highest ranked entries of each category. */
+    void printReport(int limit) const;
+
+private:
+    struct FileUsage {
+        int dieCount = 0;
+        quint64 size = 0;
+        bool definesTypes = false;
+        bool directUse = false;
+    };
+    using CuUsage = QHash<QString, FileUsage>;
+
+    void scanDie(DwarfDie *die, quint64 end, const QString &parentFile, CuUsage &usage) const;
+
+    QHash<QString, Header> m_headers;
+    int m_cuCount = 0;
+};
+
+#endif // HEADERCOSTCHECK_H
@@ -0,0 +1,197 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "interpositioncheck.h"
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QHash>
+
+#include <cassert>
+#include <iostream>
+
+#include <elf.h>
+
+InterpositionCheck::InterpositionCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+}
+
+bool InterpositionCheck::Result::isSymbolicFunctionsSafe() const
+{
+    foreach (const auto &interposition, interpositions) {
+        if (interposition.isFunction)
+            return false;
+    }
+    return true;
+}
+
+bool InterpositionCheck::Result::isSymbolicSafe() const
+{
+    return interpositions.isEmpty();
+}
+
+static bool isFunction(ElfSymbolTableEntry *sym)
+{
+    return sym->type() == STT_FUNC || sym->type() == STT_GNU_IFUNC;
+}
+
+static uint64_t cost(const SymbolLookupSimulator::Statistics &stats)
+{
+    return stats.bloomProbes + stats.chainWalks + stats.strcmpCalls;
+}
+
+QVector<InterpositionCheck::Result> InterpositionCheck::analyze() const
+{
+    QVector<Result> results;
+    if (m_fileSet->size() == 0)
+        return results;
+
+    SymbolLookupSimulator defaultSim(m_fileSet);
+    SymbolLookupSimulator symbolicFunctionsSim(m_fileSet);
+    SymbolLookupSimulator symbolicSim(m_fileSet);
+    const auto scope = defaultSim.scopeOrder();
+    // the lookups done for a file only depend on its own binding, so all files can be changed at once
+    foreach (auto fileIndex, scope) {
+        symbolicFunctionsSim.setSymbolicBinding(fileIndex, SymbolLookupSimulator::SymbolicFunctions);
+        symbolicSim.setSymbolicBinding(fileIndex, SymbolLookupSimulator::Symbolic);
+    }
+    defaultSim.simulate(SymbolLookupSimulator::BindNow);
+    symbolicFunctionsSim.simulate(SymbolLookupSimulator::BindNow);
+    symbolicSim.simulate(SymbolLookupSimulator::BindNow);
+
+    foreach (auto fileIndex, scope) {
+        if (m_fileSet->file(fileIndex)->isExecutable())
+            continue;
+        auto result = analyzeFile(fileIndex, scope);
+        result.defaultCost = defaultSim.requesterStatistics(fileIndex);
+        result.symbolicFunctionsCost = symbolicFunctionsSim.requesterStatistics(fileIndex);
+        result.symbolicCost = symbolicSim.requesterStatistics(fileIndex);
+        results.push_back(result);
+    }
+    return results;
+}
+
+InterpositionCheck::Result InterpositionCheck::analyzeFile(int fileIndex, const QVector<int> &scope) const
+{
+    Result result;
+    result.file = m_fileSet->file(fileIndex);
+    const auto file = result.file;
+    if (!file->dynamicSection())
+        return result;
+
+    const auto jmpRelEntry = file->dynamicSection()->entryWithTag(DT_JMPREL);
+    const auto jmpRel = jmpRelEntry ? jmpRelEntry->value() : 0;
+    QHash<QByteArray, bool> symbols;
+
+    foreach (const auto shdr, file->sectionHeaders()) {
+        if ((shdr->type() != SHT_REL && shdr->type() != SHT_RELA) || !(shdr->flags() & SHF_ALLOC))
+            continue;
+        const auto relocs = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocs)
+            continue;
+        const bool isPlt = jmpRel != 0 && shdr->virtualAddress() == jmpRel;
+
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto reloc = relocs->entry(i);
+            const auto sym = reloc->symbol();
+            if (!sym || !sym->hasValidSection() || sym->bindType() == STB_LOCAL || sym->visibility() != STV_DEFAULT)
+                continue;
+            ++result.selfRelocations;
+            if (isFunction(sym)) {
+                ++result.functionRelocations;
+                if (isPlt)
+                    ++result.pltSlots;
+            }
+            symbols.insert(sym->name(), isFunction(sym));
+        }
+    }
+    result.symbolCount = symbols.size();
+
+    // only definitions earlier in the lookup scope win over our own, that includes copy relocations in the executable
+    for (auto it = symbols.constBegin(); it != symbols.constEnd(); ++it) {
+        foreach (auto otherIndex, scope) {
+            if (otherIndex == fileIndex)
+                break;
+            const auto hash = m_fileSet->file(otherIndex)->hash();
+            if (!hash)
+                continue;
+            const auto def = hash->lookup(it.key().constData());
+            if (!def)
+                continue;
+            // undefined functions with a value are canonical PLT entries, those win over our definition as well
+            const auto isCanonicalPlt = def->sectionIndex() == SHN_UNDEF && isFunction(def) && m_fileSet->file(otherIndex)->isExecutable();
+            if (!def->hasValidSection() && !isCanonicalPlt)
+                continue;
+            Interposition interposition;
+            interposition.symbolName = it.key();
+            interposition.interposer = m_fileSet->file(otherIndex);
+            interposition.isFunction = it.value();
+            interposition.isCanonicalPlt = isCanonicalPlt;
+            result.interpositions.push_back(interposition);
+            break;
+        }
+    }
+
+    return result;
+}
+
+void InterpositionCheck::printReport() const
+{
+    const auto results = analyze();
+    uint64_t defaultCost = 0;
+    uint64_t symbolicFunctionsCost = 0;
+    uint64_t symbolicCost = 0;
+
+    foreach (const auto &result, results) {
+        defaultCost += cost(result.defaultCost);
+        symbolicFunctionsCost += cost(result.symbolicFunctionsCost);
+        symbolicCost += cost(result.symbolicCost);
+        if (result.selfRelocations == 0)
+            continue;
+
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.selfRelocations << " relocations against "
+                  << result.symbolCount << " own symbols, " << result.functionRelocations << " of them to functions ("
+                  << result.pltSlots << " PLT slots)" << std::endl;
+        std::cout << "  lookups: " << result.defaultCost.lookups << ", -Bsymbolic-functions: " << result.symbolicFunctionsCost.lookups
+                  << ", -Bsymbolic: " << result.symbolicCost.lookups << std::endl;
+        std::cout << "  lookup cost: " << cost(result.defaultCost) << ", -Bsymbolic-functions: " << cost(result.symbolicFunctionsCost)
+                  << ", -Bsymbolic: " << cost(result.symbolicCost) << std::endl;
+
+        foreach (const auto &interposition, result.interpositions) {
+            std::cout << "  " << interposition.symbolName.constData() << " is interposed by "
+                      << qPrintable(interposition.interposer->displayName());
+            if (interposition.isCanonicalPlt)
+                std::cout << " (canonical PLT entry, its address is taken there)";
+            std::cout << std::endl;
+        }
+        if (result.isSymbolicSafe())
+            std::cout << "  -Bsymbolic or protected visibility is safe within this file set." << std::endl;
+        else if (result.isSymbolicFunctionsSafe())
+            std::cout << "  -Bsymbolic-functions is safe within this file set, -Bsymbolic is not." << std::endl;
+        else
+            std::cout << "  Interposed functions, protected visibility for the remaining symbols only." << std::endl;
+    }
+
+    std::cout << std::endl << "Total lookup cost: " << defaultCost << ", with -Bsymbolic-functions: " << symbolicFunctionsCost
+              << ", with -Bsymbolic: " << symbolicCost << std::endl;
+}
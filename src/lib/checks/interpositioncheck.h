@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTERPOSITIONCHECK_H
+#define INTERPOSITIONCHECK_H
+
+#include "symbollookupsimulator.h"
+
+#include <QByteArray>
+#include <QVector>
+
+class ElfFile;
+class ElfFileSet;
+
+/** Finds relocations of a library against its own exported definitions. With default visibility
+ *  those go through a symbol lookup and the PLT/GOT only because the symbol could be interposed.
+ *  Estimates the savings of -Bsymbolic(-functions) or protected visibility, and checks the
+ *  file set for definitions actually interposing them.
+ */
+class InterpositionCheck
+{
+public:
+    explicit InterpositionCheck(ElfFileSet *fileSet);
+    InterpositionCheck(const InterpositionCheck&) = default;
+    ~InterpositionCheck() = default;
+
+    InterpositionCheck& operator=(const InterpositionCheck&) = default;
+
+    struct Interposition {
+        QByteArray symbolName;
+        /** The file providing the definition the dynamic linker binds to. */
+        ElfFile *interposer = nullptr;
+        bool isFunction = false;
+        /** The interposer is the canonical PLT entry of an executable taking the address of the function,
+         *  binding it locally breaks function pointer equality.
+         */
+        bool isCanonicalPlt = false;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        /** Symbolic relocations against exported definitions of the same file. */
+        int selfRelocations = 0;
+        /** Those against functions, affected by -Bsymbolic-functions. */
+        int functionRelocations = 0;
+        /** PLT slots among the function relocations, those become direct calls. */
+        int pltSlots = 0;
+        /** Distinct symbols referenced that way. */
+        int symbolCount = 0;
+        QVector<Interposition> interpositions;
+        SymbolLookupSimulator::Statistics defaultCost;
+        SymbolLookupSimulator::Statistics symbolicFunctionsCost;
+        SymbolLookupSimulator::Statistics symbolicCost;
+
+        /** -Bsymbolic-functions does not change which definitions are used. */
+        bool isSymbolicFunctionsSafe() const;
+        /** -Bsymbolic does not change which definitions are used. */
+        bool isSymbolicSafe() const;
+    };
+
+    /** Analyze all libraries of the set, in lookup scope order. Executables are skipped, symbolic binding doesn't apply to them. */
+    QVector<Result> analyze() const;
+
+    /** Dump the results to stdout. */
+    void printReport() const;
+
+private:
+    Result analyzeFile(int fileIndex, const QVector<int> &scope) const;
+
+    ElfFileSet *m_fileSet;
+};
+
+#endif // INTERPOSITIONCHECK_H
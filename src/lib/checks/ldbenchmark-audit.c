@@ -0,0 +1,203 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define _GNU_SOURCE
+
+#include "ldbenchmark-audit.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <link.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+static struct ldbenchmark_audit_data *data = NULL;
+
+/* symbol binding trace, enabled by setting LDBENCHMARK_SYMBIND_TRACE to the output file
+ * each binding is appended as "<requester>\t<provider>\t<symbol>\n", see SymbolBindingTrace
+ */
+static int traceFd = -1;
+static char mainProgram[PATH_MAX];
+
+static uint64_t now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t event()
+{
+    const uint64_t timestamp = now();
+    if (!data)
+        return timestamp;
+    if (data->first_event == 0)
+        data->first_event = timestamp;
+    return timestamp;
+}
+
+static void finishSearch()
+{
+    if (!data || data->search_start == 0)
+        return;
+    data->search_time += data->search_last - data->search_start;
+    data->search_start = 0;
+    data->search_last = 0;
+}
+
+static struct ldbenchmark_audit_data* openData()
+{
+    char name[64];
+    ldbenchmark_audit_shm_name(name, sizeof(name));
+    // when benchmarking process startup, the runner created the data already
+    const int startup = getenv("LDBENCHMARK_AUDIT_SHM") != NULL;
+    const int fd = shm_open(name, startup ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        return NULL;
+    if (!startup && ftruncate(fd, sizeof(struct ldbenchmark_audit_data)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    void *addr = mmap(NULL, sizeof(struct ldbenchmark_audit_data), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return NULL;
+    if (!startup)
+        memset(addr, 0, sizeof(struct ldbenchmark_audit_data));
+    return addr;
+}
+
+unsigned int la_version(unsigned int version)
+{
+    const uint64_t timestamp = now();
+    const ssize_t size = readlink("/proc/self/exe", mainProgram, sizeof(mainProgram) - 1);
+    mainProgram[size > 0 ? size : 0] = 0;
+
+    const char *traceFile = getenv("LDBENCHMARK_SYMBIND_TRACE");
+    if (traceFile) {
+        traceFd = open(traceFile, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    } else {
+        data = openData();
+        if (data)
+            data->audit_start = timestamp;
+    }
+
+    if (!data && traceFd < 0)
+        return 0; // disables auditing
+    return version < LAV_CURRENT ? version : LAV_CURRENT;
+}
+
+void la_activity(uintptr_t *cookie, unsigned int flag)
+{
+    (void)cookie;
+    if (!data)
+        return;
+    const uint64_t timestamp = event();
+    switch (flag) {
+        case LA_ACT_ADD:
+            data->activity_start = timestamp;
+            break;
+        case LA_ACT_CONSISTENT:
+            finishSearch();
+            data->consistent = timestamp;
+            break;
+    }
+}
+
+char *la_objsearch(const char *name, uintptr_t *cookie, unsigned int flag)
+{
+    (void)cookie;
+    (void)flag;
+    if (!data)
+        return (char*)name;
+    data->search_last = event();
+    if (data->search_start == 0)
+        data->search_start = data->search_last;
+    return (char*)name;
+}
+
+unsigned int la_objopen(struct link_map *map, Lmid_t lmid, uintptr_t *cookie)
+{
+    (void)lmid;
+    *cookie = (uintptr_t)map;
+    if (traceFd >= 0)
+        return LA_FLG_BINDTO | LA_FLG_BINDFROM;
+    // data is released after la_preinit() when benchmarking process startup
+    if (!data)
+        return 0;
+
+    const uint64_t timestamp = event();
+    finishSearch();
+    if (data->object_count < LDBENCHMARK_MAX_OBJECTS) {
+        data->object_loaded[data->object_count] = timestamp;
+        const char *name = map->l_name[0] ? map->l_name : mainProgram;
+        const size_t size = strnlen(name, LDBENCHMARK_NAME_SIZE - 1);
+        memcpy(data->object_names[data->object_count], name, size);
+        data->object_names[data->object_count][size] = 0;
+    }
+    ++data->object_count;
+    return 0; // no symbol binding callbacks when benchmarking
+}
+
+void la_preinit(uintptr_t *cookie)
+{
+    (void)cookie;
+    if (!data)
+        return;
+    data->preinit = now();
+    // when benchmarking process startup, later dlopen() calls by the application are not of interest
+    if (getenv("LDBENCHMARK_AUDIT_SHM"))
+        data = NULL;
+}
+
+static void traceBinding(uintptr_t *refcook, uintptr_t *defcook, const char *symname)
+{
+    const struct link_map *requester = (const struct link_map*)*refcook;
+    const struct link_map *provider = (const struct link_map*)*defcook;
+    char line[4096];
+    const int size = snprintf(line, sizeof(line), "%s\t%s\t%s\n",
+                              requester->l_name[0] ? requester->l_name : mainProgram,
+                              provider->l_name[0] ? provider->l_name : mainProgram, symname);
+    // a single write per line, so concurrent processes appending to the same file don't interleave
+    if (size > 0 && size < (int)sizeof(line) && write(traceFd, line, size) < 0)
+        return;
+}
+
+#if __ELF_NATIVE_CLASS == 64
+uintptr_t la_symbind64(Elf64_Sym *sym, unsigned int ndx, uintptr_t *refcook, uintptr_t *defcook, unsigned int *flags, const char *symname)
+{
+    (void)ndx;
+    traceBinding(refcook, defcook, symname);
+    // we only care about the binding, not the calls
+    *flags |= LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT;
+    return sym->st_value;
+}
+#else
+uintptr_t la_symbind32(Elf32_Sym *sym, unsigned int ndx, uintptr_t *refcook, uintptr_t *defcook, unsigned int *flags, const char *symname)
+{
+    (void)ndx;
+    traceBinding(refcook, defcook, symname);
+    *flags |= LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT;
+    return sym->st_value;
+}
+#endif
@@ -0,0 +1,70 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LDBENCHMARK_AUDIT_H
+#define LDBENCHMARK_AUDIT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define LDBENCHMARK_MAX_OBJECTS 512
+#define LDBENCHMARK_NAME_SIZE 256
+
+/* Timestamps recorded by the ldbenchmark-audit LD_AUDIT module, in nanoseconds of CLOCK_MONOTONIC_RAW.
+ * The audit module runs in its own link map namespace with its own libc, so this is shared with the
+ * runner via a POSIX shared memory object named by ldbenchmark_audit_shm_name().
+ * When benchmarking process startup, the runner creates that object itself and passes its name to the
+ * benchmarked process in LDBENCHMARK_AUDIT_SHM.
+ */
+struct ldbenchmark_audit_data {
+    /* first callback since the last reset, the search of the requested object precedes LA_ACT_ADD */
+    uint64_t first_event;
+    /* la_activity(LA_ACT_ADD), start of loading new objects */
+    uint64_t activity_start;
+    /* la_activity(LA_ACT_CONSISTENT), all new objects are mapped, relocation follows */
+    uint64_t consistent;
+    /* time spent between the first and the last la_objsearch() for each object, ie. probing the search path */
+    uint64_t search_time;
+    /* first and last la_objsearch() of the object currently searched, 0 if none */
+    uint64_t search_start;
+    uint64_t search_last;
+    /* la_preinit(), relocation of the objects loaded at startup is done, constructors follow */
+    uint64_t preinit;
+    /* number of la_objopen() calls */
+    uint32_t object_count;
+    /* la_objopen() of each object, and its file name */
+    uint64_t object_loaded[LDBENCHMARK_MAX_OBJECTS];
+    char object_names[LDBENCHMARK_MAX_OBJECTS][LDBENCHMARK_NAME_SIZE];
+
+    /* process startup only: execve() by the runner, la_version(), and entry of main() as seen by ldbenchmark-startup */
+    uint64_t exec;
+    uint64_t audit_start;
+    uint64_t main;
+};
+
+static inline void ldbenchmark_audit_shm_name(char *buffer, size_t size)
+{
+    const char *name = getenv("LDBENCHMARK_AUDIT_SHM");
+    if (name)
+        snprintf(buffer, size, "%s", name);
+    else
+        snprintf(buffer, size, "/ldbenchmark-audit-%d", (int)getpid());
+}
+
+#endif
@@ -15,55 +15,583 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#define _GNU_SOURCE
+
+#include "ldbenchmark-audit.h"
+
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+enum {
+    COUNTER_INSTRUCTIONS,
+    COUNTER_CYCLES,
+    COUNTER_PAGE_FAULTS,
+    COUNTER_DTLB_MISSES,
+    COUNTER_COUNT
+};
+
+static int counterFds[COUNTER_COUNT] = { -1, -1, -1, -1 };
+static const char* counterNames[COUNTER_COUNT] = { "instructions", "cycles", "page faults", "dTLB misses" };
+
+static struct ldbenchmark_audit_data *auditData = NULL;
 
 int usage()
 {
-    fprintf(stderr, "Usage: ldbenchark-runner [RTLD_LAZY|RTLD_NOW] <files>\n");
+    fprintf(stderr, "Usage: ldbenchark-runner [--cpu <n>] [--counters] [--cold] [RTLD_LAZY|RTLD_NOW] <files>\n"
+                    "       ldbenchark-runner [--cpu <n>] [--cold] --audit <module> --preload <module> [--marker <text>] [--timeout <ms>]\n"
+                    "                         EXEC <files> -- <command> [args]\n"
+                    "       ldbenchark-runner [--cpu <n>] CALL <files> -- <file> <address>...\n");
     return 1;
 }
 
+#ifdef __linux__
+static int openCounter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static void openCounters()
+{
+#ifdef __linux__
+    counterFds[COUNTER_INSTRUCTIONS] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    counterFds[COUNTER_CYCLES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    counterFds[COUNTER_PAGE_FAULTS] = openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+    counterFds[COUNTER_DTLB_MISSES] = openCounter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        if (counterFds[i] < 0)
+            fprintf(stderr, "Performance counter for %s not available, check /proc/sys/kernel/perf_event_paranoid.\n", counterNames[i]);
+    }
+#else
+    fprintf(stderr, "Performance counters are not supported on this platform.\n");
+#endif
+}
+
+static void startCounters()
+{
+#ifdef __linux__
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        if (counterFds[i] < 0)
+            continue;
+        ioctl(counterFds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counterFds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static void stopCounters(long long *values)
+{
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        values[i] = -1;
+#ifdef __linux__
+        if (counterFds[i] < 0)
+            continue;
+        ioctl(counterFds[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        if (read(counterFds[i], &value, sizeof(value)) == sizeof(value))
+            values[i] = value;
+#endif
+    }
+}
+
+static int pinToCpu(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) == 0)
+        return 1;
+    perror("Failed to set CPU affinity");
+#else
+    fprintf(stderr, "CPU pinning is not supported on this platform.\n");
+#endif
+    return 0;
+}
+
+/* Attach to the data of the audit module, if we run with LD_AUDIT=ldbenchmark-audit.so */
+static void openAuditData()
+{
+    char name[64];
+    ldbenchmark_audit_shm_name(name, sizeof(name));
+    const int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0)
+        return;
+    shm_unlink(name);
+    void *addr = mmap(NULL, sizeof(struct ldbenchmark_audit_data), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr != MAP_FAILED)
+        auditData = addr;
+}
+
+/* Number of bytes of @p fileName in the page cache, -1 on error. */
+static long long residentBytes(const char *fileName)
+{
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return -1;
+    }
+    void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return -1;
+
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const size_t pageCount = (st.st_size + pageSize - 1) / pageSize;
+    unsigned char *vec = malloc(pageCount);
+    long long resident = -1;
+    if (vec && mincore(addr, st.st_size, vec) == 0) {
+        resident = 0;
+        for (size_t i = 0; i < pageCount; ++i)
+            resident += (vec[i] & 1) ? pageSize : 0;
+    }
+    free(vec);
+    munmap(addr, st.st_size);
+    return resident;
+}
+
+/* Drop @p fileName from the page cache, returns the number of bytes still cached afterwards.
+ * This needs no privileges, but pages mapped by other processes (or by us) cannot be evicted,
+ * that is checked with mincore() and reported, as it makes the cold cache results too optimistic.
+ */
+static long long evictFromCache(const char *fileName)
+{
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open file for cache eviction");
+        return -1;
+    }
+    // dirty pages cannot be evicted, as found for freshly built files
+    fdatasync(fd);
+    const int err = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+    if (err != 0) {
+        fprintf(stderr, "Failed to evict %s from the page cache: %s\n", fileName, strerror(err));
+        return -1;
+    }
+    const long long resident = residentBytes(fileName);
+    if (resident > 0)
+        fprintf(stderr, "%s: %lld bytes are still cached after eviction, the file is probably mapped by another process.\n", fileName, resident);
+    return resident;
+}
+
+/* Evict all @p files not used by the runner itself, those are skipped by the measurement anyway.
+ * Returns 0 if any file remains cached, the results would be meaningless then.
+ */
+static int evictAllFromCache(char **files, int fileCount, long long *cachedBytes)
+{
+    int success = 1;
+    for (int i = 0; i < fileCount; ++i) {
+        if (dlopen(files[i], RTLD_LAZY | RTLD_NOLOAD) != NULL) {
+            fprintf(stderr, "%s is used by the benchmark runner itself and cannot be evicted from the page cache.\n", files[i]);
+            continue;
+        }
+        const long long resident = evictFromCache(files[i]);
+        if (cachedBytes)
+            cachedBytes[i] = resident;
+        if (resident != 0)
+            success = 0;
+    }
+    if (!success)
+        fprintf(stderr, "Cold cache measurement failed, close all processes using the above files.\n");
+    return success;
+}
+
+/* Bytes this process caused to be read from storage, -1 if I/O accounting is not available. */
+static long long storageReadBytes()
+{
+    FILE *f = fopen("/proc/self/io", "r");
+    if (!f)
+        return -1;
+    char line[128];
+    long long bytes = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "read_bytes: %lld", &bytes) == 1)
+            break;
+    }
+    fclose(f);
+    return bytes;
+}
+
+static uint64_t toNSecs(const struct timespec *ts)
+{
+    return ts->tv_sec * 1000000000ULL + ts->tv_nsec;
+}
+
+static uint64_t now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return toNSecs(&ts);
+}
+
+/* Wait until @p marker shows up on @p fd, returns the time this happened or 0 on timeout or EOF. */
+static uint64_t waitForMarker(int fd, const char *marker, int timeoutMs)
+{
+    const size_t markerSize = strlen(marker);
+    // the tail kept from the previous read, a full read and the terminating null byte
+    char *buffer = malloc(markerSize + 4096 + 1);
+    if (!buffer) {
+        perror("Failed to allocate memory");
+        return 0;
+    }
+    size_t size = 0;
+    uint64_t timestamp = 0;
+    const uint64_t deadline = now() + timeoutMs * 1000000ULL;
+
+    for (uint64_t t = now(); t < deadline; t = now()) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, (deadline - t) / 1000000 + 1) <= 0)
+            continue;
+        const ssize_t n = read(fd, buffer + size, 4096);
+        if (n <= 0)
+            break;
+        const uint64_t readTime = now();
+        size += n;
+        buffer[size] = 0;
+        if (memmem(buffer, size, marker, markerSize)) {
+            timestamp = readTime;
+            break;
+        }
+        // keep the tail, the marker might be split across reads
+        const size_t keep = markerSize < size ? markerSize : size;
+        memmove(buffer, buffer + size - keep, keep);
+        size = keep;
+    }
+    free(buffer);
+    return timestamp;
+}
+
+/* Launch the process once and measure its startup phases, see ldbenchmark-audit.h */
+static int measureStartup(char **files, int fileCount, char **command, int coldCache, const char *auditModule,
+                          const char *preloadModule, const char *marker, int timeoutMs)
+{
+    char shmName[64];
+    snprintf(shmName, sizeof(shmName), "/ldbenchmark-startup-%d", (int)getpid());
+    const int fd = shm_open(shmName, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        perror("Failed to create shared memory");
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(struct ldbenchmark_audit_data)) != 0) {
+        perror("Failed to resize shared memory");
+        close(fd);
+        shm_unlink(shmName);
+        return 1;
+    }
+    struct ldbenchmark_audit_data *data = mmap(NULL, sizeof(struct ldbenchmark_audit_data), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(shmName);
+        return 1;
+    }
+    memset(data, 0, sizeof(struct ldbenchmark_audit_data));
+
+    if (coldCache && !evictAllFromCache(files, fileCount, NULL)) {
+        shm_unlink(shmName);
+        return 1;
+    }
+
+    int pipeFds[2] = { -1, -1 };
+    if (marker && pipe(pipeFds) != 0) {
+        perror("Failed to create pipe");
+        shm_unlink(shmName);
+        return 1;
+    }
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        if (marker) {
+            dup2(pipeFds[1], STDOUT_FILENO);
+            dup2(pipeFds[1], STDERR_FILENO);
+            close(pipeFds[0]);
+            close(pipeFds[1]);
+        }
+        setenv("LD_AUDIT", auditModule, 1);
+        setenv("LD_PRELOAD", preloadModule, 1);
+        setenv("LDBENCHMARK_AUDIT_SHM", shmName, 1);
+        if (!marker)
+            setenv("LDBENCHMARK_EXIT_AT_MAIN", "1", 1);
+        data->exec = now();
+        execvp(command[0], command);
+        perror("Failed to execute benchmark target");
+        _exit(127);
+    }
+    if (pid < 0) {
+        perror("Failed to fork");
+        shm_unlink(shmName);
+        return 1;
+    }
+
+    uint64_t markerTime = 0;
+    int status = 0;
+    if (marker) {
+        close(pipeFds[1]);
+        markerTime = waitForMarker(pipeFds[0], marker, timeoutMs);
+        if (!markerTime)
+            fprintf(stderr, "Marker \"%s\" not seen within %d ms.\n", marker, timeoutMs);
+        kill(pid, SIGKILL);
+        close(pipeFds[0]);
+    }
+    waitpid(pid, &status, 0);
+    shm_unlink(shmName);
+
+    if (!data->audit_start || !data->preinit || !data->main) {
+        fprintf(stderr, "Incomplete startup data, is %s a dynamically linked executable?\n", command[0]);
+        return 1;
+    }
+
+    // exec until the dynamic loader runs, loading, relocation, constructors, and the totals until main() and the marker
+    fprintf(stdout, "LDBENCHMARKSTARTUP\t%s\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\n", command[0],
+            (data->audit_start - data->exec) / 1000.0,
+            ((data->consistent ? data->consistent : data->preinit) - data->audit_start) / 1000.0,
+            (data->preinit - (data->consistent ? data->consistent : data->preinit)) / 1000.0,
+            (data->main - data->preinit) / 1000.0,
+            (data->main - data->exec) / 1000.0,
+            markerTime ? (markerTime - data->exec) / 1000.0 : -1.0);
+
+    // search and mapping time of each object
+    const uint32_t objectCount = data->object_count < LDBENCHMARK_MAX_OBJECTS ? data->object_count : LDBENCHMARK_MAX_OBJECTS;
+    uint64_t previous = data->audit_start;
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        fprintf(stdout, "LDBENCHMARKSTARTUPOBJECT\t%s\t%.3f\n", data->object_names[i], (data->object_loaded[i] - previous) / 1000.0);
+        previous = data->object_loaded[i];
+    }
+
+    munmap(data, sizeof(struct ldbenchmark_audit_data));
+    return 0;
+}
+
+/* Load @p files, and call the functions at the given @p addresses (hex, relative to the load address of @p target)
+ * again, each in a separate child process. Used for timing static initializers, which can't be isolated
+ * inside dlopen(). Running them twice isn't necessarily safe, hence the throw-away processes.
+ */
+static int callFunctions(char **files, int fileCount, const char *target, char **addresses, int addressCount, int argc, char **argv)
+{
+    for (int i = 0; i < fileCount; ++i) {
+        if (!dlopen(files[i], RTLD_NOW)) {
+            fprintf(stderr, "Loading %s failed: %s\n", files[i], dlerror());
+            return 1;
+        }
+    }
+    void *handle = dlopen(target, RTLD_NOW);
+    struct link_map *map = NULL;
+    if (!handle || dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0 || !map) {
+        fprintf(stderr, "Loading %s failed: %s\n", target, dlerror());
+        return 1;
+    }
+
+    for (int i = 0; i < addressCount; ++i) {
+        void (*function)(int, char**, char**) = (void (*)(int, char**, char**))(map->l_addr + strtoull(addresses[i], NULL, 16));
+        fflush(stdout);
+        const pid_t pid = fork();
+        if (pid == 0) {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+            function(argc, argv, environ);
+            clock_gettime(CLOCK_MONOTONIC_RAW, &end);
+            fprintf(stdout, "LDBENCHMARKCALL\t%s\t%s\t%.3f\n", target, addresses[i], (toNSecs(&end) - toNSecs(&start)) / 1000.0);
+            fflush(stdout);
+            _exit(0);
+        }
+        if (pid < 0) {
+            perror("Failed to fork");
+            return 1;
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status))
+            fprintf(stderr, "Calling %s in %s crashed.\n", addresses[i], target);
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc < 3)
+    int arg = 1;
+    int withCounters = 0;
+    int coldCache = 0;
+    const char *auditModule = NULL;
+    const char *preloadModule = NULL;
+    const char *marker = NULL;
+    int timeoutMs = 30000;
+    while (arg < argc && strncmp(argv[arg], "--", 2) == 0) {
+        if (strcmp(argv[arg], "--counters") == 0) {
+            withCounters = 1;
+            ++arg;
+        } else if (strcmp(argv[arg], "--cold") == 0) {
+            coldCache = 1;
+            ++arg;
+        } else if (strcmp(argv[arg], "--cpu") == 0 && arg + 1 < argc) {
+            if (!pinToCpu(atoi(argv[arg + 1])))
+                return 1;
+            arg += 2;
+        } else if (strcmp(argv[arg], "--audit") == 0 && arg + 1 < argc) {
+            auditModule = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "--preload") == 0 && arg + 1 < argc) {
+            preloadModule = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "--marker") == 0 && arg + 1 < argc) {
+            marker = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "--timeout") == 0 && arg + 1 < argc) {
+            timeoutMs = atoi(argv[arg + 1]);
+            arg += 2;
+        } else {
+            return usage();
+        }
+    }
+
+    if (argc - arg < 2)
         return usage();
 
+    if (strcmp(argv[arg], "EXEC") == 0) {
+        int separator = arg + 1;
+        while (separator < argc && strcmp(argv[separator], "--") != 0)
+            ++separator;
+        if (separator + 1 >= argc || !auditModule || !preloadModule)
+            return usage();
+        return measureStartup(argv + arg + 1, separator - arg - 1, argv + separator + 1, coldCache, auditModule,
+                              preloadModule, marker, timeoutMs);
+    }
+
+    if (strcmp(argv[arg], "CALL") == 0) {
+        int separator = arg + 1;
+        while (separator < argc && strcmp(argv[separator], "--") != 0)
+            ++separator;
+        if (separator + 2 >= argc)
+            return usage();
+        return callFunctions(argv + arg + 1, separator - arg - 1, argv[separator + 1], argv + separator + 2, argc - separator - 2, argc, argv);
+    }
+
     int flags = 0;
-    if (strcmp(argv[1], "RTLD_NOW") == 0)
+    if (strcmp(argv[arg], "RTLD_NOW") == 0)
         flags = RTLD_NOW;
-    else if (strcmp(argv[1], "RTLD_LAZY") == 0)
+    else if (strcmp(argv[arg], "RTLD_LAZY") == 0)
         flags = RTLD_LAZY;
     else
         return usage();
 
-    for (int i = 2; i < argc; ++i) {
+    if (withCounters)
+        openCounters();
+    openAuditData();
+
+    // evict everything upfront, once a library is loaded its pages are mapped and stay cached
+    long long *cachedBytes = NULL;
+    if (coldCache) {
+        cachedBytes = calloc(argc, sizeof(long long));
+        if (!cachedBytes) {
+            perror("Failed to allocate memory");
+            return 1;
+        }
+        if (!evictAllFromCache(argv + arg + 1, argc - arg - 1, cachedBytes + arg + 1)) {
+            free(cachedBytes);
+            return 1;
+        }
+    }
+
+    for (int i = arg + 1; i < argc; ++i) {
         if (dlopen(argv[i], flags | RTLD_NOLOAD) != NULL) {
             fprintf(stderr, "%s is already loaded, check argument order!\n", argv[i]);
             continue;
         }
 
-        struct timespec start, end;
-        clock_gettime(CLOCK_REALTIME, &start);
+        long long counters[COUNTER_COUNT];
+        struct timespec start, end, cpuStart, cpuEnd;
+        long long readStart = -1, readEnd = -1;
+        if (auditData) {
+            auditData->first_event = 0;
+            auditData->activity_start = 0;
+            auditData->consistent = 0;
+            auditData->search_time = 0;
+            auditData->search_start = 0;
+            auditData->search_last = 0;
+            auditData->object_count = 0;
+        }
+        if (coldCache) {
+            readStart = storageReadBytes();
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuStart);
+        }
+        if (withCounters)
+            startCounters();
+        // not subject to NTP adjustments, unlike CLOCK_REALTIME
+        clock_gettime(CLOCK_MONOTONIC_RAW, &start);
         void* result = dlopen(argv[i], flags);
-        clock_gettime(CLOCK_REALTIME, &end);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &end);
+        if (withCounters)
+            stopCounters(counters);
+        if (coldCache) {
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+            readEnd = storageReadBytes();
+        }
 
         if (!result) {
             fprintf(stderr, "Loading %s failed: %s\n", argv[i], dlerror());
             return 1;
         }
 
-        long long diff = (end.tv_sec - start.tv_sec) * 1000000000;
-        if (diff == 0)
-            diff = end.tv_nsec - start.tv_nsec;
-        else {
-            diff += end.tv_nsec;
-            diff += 1000000000 - start.tv_nsec;
+        const long long diff = (end.tv_sec - start.tv_sec) * 1000000000LL + (end.tv_nsec - start.tv_nsec);
+        fprintf(stdout, "LDBENCHMARKRUNNER\t%s\t%.3f", argv[i], diff/1000.0);
+        if (withCounters) {
+            for (int c = 0; c < COUNTER_COUNT; ++c)
+                fprintf(stdout, "\t%lld", counters[c]);
+        }
+        fprintf(stdout, "\n");
+
+        // search, mapping, and relocation including constructors, as there is no audit hook between those for dlopen()
+        if (auditData && auditData->activity_start && auditData->consistent >= auditData->first_event + auditData->search_time) {
+            const uint64_t map = auditData->consistent - auditData->first_event - auditData->search_time;
+            const uint64_t relocation = toNSecs(&end) - auditData->consistent;
+            fprintf(stdout, "LDBENCHMARKPHASES\t%s\t%.3f\t%.3f\t%.3f\t%u\n", argv[i], auditData->search_time/1000.0,
+                    map/1000.0, relocation/1000.0, auditData->object_count);
+        }
+
+        // time spent off-CPU, ie. mostly waiting for I/O, bytes read from storage and bytes we failed to evict
+        if (coldCache) {
+            const long long cpu = (cpuEnd.tv_sec - cpuStart.tv_sec) * 1000000000LL + (cpuEnd.tv_nsec - cpuStart.tv_nsec);
+            const long long bytesRead = (readStart >= 0 && readEnd >= 0) ? readEnd - readStart : -1;
+            fprintf(stdout, "LDBENCHMARKIO\t%s\t%.3f\t%lld\t%lld\n", argv[i], (diff > cpu ? diff - cpu : 0) / 1000.0,
+                    bytesRead, cachedBytes[i]);
         }
-        fprintf(stdout, "LDBENCHMARKRUNNER\t%s\t%.2f\n", argv[i], diff/1000.0);
     }
 
+    free(cachedBytes);
     return 0;
 }
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/* LD_PRELOAD module recording the entry of main() of the benchmarked process, see ldbenchmark-audit.h.
+ * Constructors of the executable run inside __libc_start_main(), so we wrap main() itself.
+ */
+
+#define _GNU_SOURCE
+
+#include "ldbenchmark-audit.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+typedef int (*main_function)(int, char**, char**);
+typedef int (*start_main_function)(main_function, int, char**, void (*)(void), void (*)(void), void (*)(void), void*);
+
+static main_function realMain = NULL;
+
+static void recordMain(uint64_t timestamp)
+{
+    char name[64];
+    ldbenchmark_audit_shm_name(name, sizeof(name));
+    const int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0)
+        return;
+    struct ldbenchmark_audit_data *data = mmap(NULL, sizeof(struct ldbenchmark_audit_data), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return;
+    if (data->main == 0)
+        data->main = timestamp;
+    munmap(data, sizeof(struct ldbenchmark_audit_data));
+}
+
+static int benchmarkMain(int argc, char **argv, char **envp)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    recordMain(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+
+    if (getenv("LDBENCHMARK_EXIT_AT_MAIN"))
+        _exit(0);
+
+    // don't measure child processes of the application
+    unsetenv("LD_AUDIT");
+    unsetenv("LD_PRELOAD");
+    unsetenv("LDBENCHMARK_AUDIT_SHM");
+    return realMain(argc, argv, envp);
+}
+
+int __libc_start_main(main_function main, int argc, char **argv, void (*init)(void), void (*fini)(void), void (*rtld_fini)(void), void *stack_end)
+{
+    const start_main_function startMain = (start_main_function)dlsym(RTLD_NEXT, "__libc_start_main");
+    realMain = main;
+    return startMain(benchmarkMain, argc, argv, init, fini, rtld_fini, stack_end);
+}
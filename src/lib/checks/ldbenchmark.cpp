@@ -15,16 +15,27 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "config-elf-dissector.h"
 #include "ldbenchmark.h"
 
 #include <elf/elffile.h>
 #include <elf/elffileset.h>
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QProcess>
+#include <QProcessEnvironment>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
 
 #include <cassert>
 
@@ -50,16 +61,165 @@ static double max(const QVector<double> &data)
     return *std::max_element(data.constBegin(), data.constEnd());
 }
 
+/** Two-sided 95% quantile of Student's t distribution for @p df degrees of freedom. */
+static double tQuantile(int df)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    assert(df > 0);
+    if (df <= 30)
+        return table[df - 1];
+    return 1.96;
+}
+
+/** Indexes of the samples within Tukey's fences, ie. 1.5 interquartile ranges around the quartiles. */
+static QVector<int> inliers(const QVector<double> &data)
+{
+    QVector<int> indexes(data.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    if (data.size() < 4)
+        return indexes;
+
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    const auto q1 = sorted.at(sorted.size() / 4);
+    const auto q3 = sorted.at(sorted.size() * 3 / 4);
+    const auto iqr = q3 - q1;
+    indexes.erase(std::remove_if(indexes.begin(), indexes.end(), [&data, q1, q3, iqr](int i) {
+        return data.at(i) < q1 - 1.5 * iqr || data.at(i) > q3 + 1.5 * iqr;
+    }), indexes.end());
+    return indexes;
+}
+
+/** Statistics of the samples in @p data selected by @p indexes. */
+static LDBenchmark::Statistics sampleStatistics(const QVector<double> &data, const QVector<int> &indexes)
+{
+    LDBenchmark::Statistics stats;
+    if (indexes.isEmpty())
+        return stats;
+
+    QVector<double> times;
+    times.reserve(indexes.size());
+    foreach (auto i, indexes)
+        times.push_back(data.at(i));
+
+    stats.samples = times.size();
+    stats.outliers = data.size() - times.size();
+    stats.median = ::median(times);
+    stats.min = ::min(times);
+    stats.max = ::max(times);
+    stats.mean = std::accumulate(times.constBegin(), times.constEnd(), 0.0) / times.size();
+    if (times.size() > 1) {
+        double sum = 0.0;
+        foreach (auto t, times)
+            sum += (t - stats.mean) * (t - stats.mean);
+        stats.standardDeviation = std::sqrt(sum / (times.size() - 1));
+        stats.confidenceInterval = tQuantile(times.size() - 1) * stats.standardDeviation / std::sqrt(times.size());
+    }
+    return stats;
+}
+
+static QString modulePath(const char *envVar, const QString &defaultPath)
+{
+    const auto path = qEnvironmentVariable(envVar, defaultPath);
+    if (!QFileInfo::exists(path)) {
+        qWarning() << "Module not found at" << path << "- set" << envVar << "to its location.";
+        return {};
+    }
+    return path;
+}
+
+void LDBenchmark::setWarmupIterations(int iterations)
+{
+    m_warmupIterations = iterations;
+}
+
+void LDBenchmark::setIterations(int min, int max)
+{
+    assert(min > 0 && min <= max);
+    m_minIterations = min;
+    m_maxIterations = max;
+}
+
+void LDBenchmark::setTargetPrecision(double precision)
+{
+    m_targetPrecision = precision;
+}
+
+void LDBenchmark::setCpu(int cpu)
+{
+    m_cpu = cpu;
+}
+
+void LDBenchmark::setHardwareCounters(bool enable)
+{
+    m_hardwareCounters = enable;
+}
+
+void LDBenchmark::setPhaseTiming(bool enable)
+{
+    m_phaseTiming = enable;
+}
+
+void LDBenchmark::setColdCache(bool enable)
+{
+    m_coldCache = enable;
+}
+
+void LDBenchmark::setStartupMarker(const QString& marker)
+{
+    m_startupMarker = marker;
+}
+
+QString LDBenchmark::auditModulePath()
+{
+    return modulePath("LDBENCHMARK_AUDIT_MODULE", QStringLiteral(LDBENCHMARK_AUDIT_MODULE));
+}
+
+QString LDBenchmark::runnerPath()
+{
+    // next to the application when running from the build directory
+    const auto localPath = QCoreApplication::applicationDirPath() + QLatin1String("/ldbenchmark-runner");
+    return modulePath("LDBENCHMARK_RUNNER", QFileInfo::exists(localPath) ? localPath : QStringLiteral(LDBENCHMARK_RUNNER));
+}
 
 void LDBenchmark::measureFileSet(ElfFileSet* fileSet)
+{
+    prepare(fileSet);
+    LoadMode mode;
+    while (nextRun(&mode)) {
+        QProcess proc;
+        startRunner(&proc, mode);
+        // a single run with many files or a cold cache can take longer than the default timeout
+        if (!proc.waitForFinished(-1)) {
+            qWarning() << "Failed to run benchmark runner:" << proc.errorString();
+            return;
+        }
+        if (proc.exitStatus() == QProcess::CrashExit) {
+            qWarning() << "Benchmark runner crashed!";
+            return;
+        }
+        if (proc.exitCode() != 0) {
+            qWarning() << "Benchmark runner failed with exit code" << proc.exitCode();
+            return;
+        }
+        readResults(&proc, mode);
+    }
+}
+
+void LDBenchmark::prepare(ElfFileSet* fileSet)
 {
     m_fileSet = fileSet;
 
     m_results.clear();
     m_results.reserve(fileSet->size());
-
-    m_args.reserve(fileSet->size() + 1);
-    m_args.push_back(QString()); // placeholder for mode argument
+    m_args.clear();
+    m_args.reserve(fileSet->size());
+    m_startupTimes.clear();
+    m_startupObjects.clear();
 
     for (int i = fileSet->size() - 1; i >= 0; --i) {
         const auto fileName = fileSet->file(i)->fileName();
@@ -69,54 +229,372 @@ void LDBenchmark::measureFileSet(ElfFileSet* fileSet)
         m_results.push_back(r);
     }
 
-    measure(LoadMode::None, 1); // avoid cold cache skewing the results
-    measure(LoadMode::Lazy, 5);
-    measure(LoadMode::Now, 5);
+    m_currentMode = LoadMode::None;
+    m_currentRuns = 0;
+}
+
+bool LDBenchmark::nextRun(LoadMode* mode)
+{
+    const auto isDone = [this](LoadMode mode) {
+        return m_currentRuns >= m_maxIterations || (m_currentRuns >= m_minIterations && isPrecise(mode));
+    };
+
+    // avoid cold cache skewing the results, in cold cache mode this still warms up the runner itself
+    if (m_currentMode == LoadMode::None && m_currentRuns >= m_warmupIterations) {
+        m_currentMode = LoadMode::Lazy;
+        m_currentRuns = 0;
+    }
+    if (m_currentMode == LoadMode::Lazy && isDone(LoadMode::Lazy)) {
+        m_currentMode = LoadMode::Now;
+        m_currentRuns = 0;
+    }
+    if (m_currentMode == LoadMode::Now && isDone(LoadMode::Now))
+        return false;
+
+    ++m_currentRuns;
+    *mode = m_currentMode;
+    return true;
+}
+
+int LDBenchmark::maximumRuns() const
+{
+    return m_warmupIterations + 2 * m_maxIterations;
+}
+
+void LDBenchmark::measureStartup(ElfFileSet* fileSet, const QStringList& arguments)
+{
+    m_fileSet = fileSet;
+    m_results.clear();
+    m_startupTimes.clear();
+    m_startupObjects.clear();
+
+    // all files are passed for cache eviction only, the dynamic loader resolves the dependencies itself
+    m_args.clear();
+    for (int i = 0; i < fileSet->size(); ++i)
+        m_args.push_back(fileSet->file(i)->fileName());
+    m_startupArgs = QStringList() << fileSet->file(0)->fileName();
+    m_startupArgs += arguments;
+
+    runStartup(m_warmupIterations, false);
+    runStartup(m_minIterations, true);
+    const auto total = m_startupMarker.isEmpty() ? TimeToMain : TimeToMarker;
+    for (int i = m_minIterations; i < m_maxIterations; ++i) {
+        const auto stats = startupStatistics(total);
+        if (stats.mean > 0.0 && stats.confidenceInterval <= m_targetPrecision * stats.mean)
+            break;
+        runStartup(1, true);
+    }
 }
 
-void LDBenchmark::measure(LDBenchmark::LoadMode mode, int iterations)
+void LDBenchmark::runStartup(int iterations, bool record)
 {
-    m_args[0] = mode == LoadMode::Lazy ? QStringLiteral("RTLD_LAZY") : QStringLiteral("RTLD_NOW");
+    const auto auditModule = auditModulePath();
+    const auto startupModule = modulePath("LDBENCHMARK_STARTUP_MODULE", QStringLiteral(LDBENCHMARK_STARTUP_MODULE));
+    const auto runner = runnerPath();
+    if (auditModule.isEmpty() || startupModule.isEmpty() || runner.isEmpty())
+        return;
+
+    QStringList args;
+    if (m_cpu >= 0)
+        args << QStringLiteral("--cpu") << QString::number(m_cpu);
+    if (m_coldCache)
+        args << QStringLiteral("--cold");
+    args << QStringLiteral("--audit") << auditModule << QStringLiteral("--preload") << startupModule;
+    if (!m_startupMarker.isEmpty())
+        args << QStringLiteral("--marker") << m_startupMarker;
+    args << QStringLiteral("EXEC");
+    args += m_args;
+    args << QStringLiteral("--");
+    args += m_startupArgs;
+
     for (int i = 0; i < iterations; ++i) {
+        if (m_coldCache)
+            dropMappedPages();
         QProcess proc;
-        proc.setProcessChannelMode(QProcess::QProcess::ForwardedErrorChannel);
-        proc.start(QStringLiteral("ldbenchmark-runner"), m_args); // TODO find in libexec
-        proc.waitForFinished();
+        proc.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        proc.start(runner, args);
+        proc.waitForFinished(-1);
         if (proc.exitStatus() == QProcess::CrashExit)
             qWarning() << "Benchmark runner crashed!";
-        readResults(&proc, mode);
+        if (record)
+            readStartupResults(&proc);
+    }
+}
+
+void LDBenchmark::readStartupResults(QProcess* proc)
+{
+    while (proc->canReadLine()) {
+        const auto line = proc->readLine();
+        const bool isObject = line.startsWith("LDBENCHMARKSTARTUPOBJECT\t");
+        if (!line.startsWith("LDBENCHMARKSTARTUP\t") && !isObject) {
+            qDebug() << "target stdout:" << line;
+            continue;
+        }
+        // tag, executable, startup times in µs, -1 if not available
+        // or: tag, object file name, search and mapping time in µs
+        const auto fields = line.trimmed().split('\t');
+        if (fields.size() < (isObject ? 3 : 2 + StartupTimeCount)) {
+            qWarning() << "Invalid benchmark runner output:" << line;
+            continue;
+        }
+
+        if (isObject) {
+            const auto fileName = fields.at(1);
+            auto it = std::find_if(m_startupObjects.begin(), m_startupObjects.end(), [fileName](const StartupSamples &samples) {
+                return samples.fileName == fileName;
+            });
+            if (it == m_startupObjects.end()) {
+                StartupSamples samples;
+                samples.fileName = fileName;
+                it = m_startupObjects.insert(it, samples);
+            }
+            (*it).times.push_back(fields.at(2).toDouble());
+            continue;
+        }
+
+        QVector<double> times;
+        times.reserve(StartupTimeCount);
+        for (int i = 0; i < StartupTimeCount; ++i)
+            times.push_back(fields.at(2 + i).toDouble());
+        m_startupTimes.push_back(times);
     }
 }
 
+void LDBenchmark::startRunner(QProcess* proc, LoadMode mode)
+{
+    QStringList args;
+    if (m_cpu >= 0)
+        args << QStringLiteral("--cpu") << QString::number(m_cpu);
+    if (m_hardwareCounters && mode != LoadMode::None)
+        args << QStringLiteral("--counters");
+    if (m_coldCache && mode != LoadMode::None)
+        args << QStringLiteral("--cold");
+    args.push_back(mode == LoadMode::Lazy ? QStringLiteral("RTLD_LAZY") : QStringLiteral("RTLD_NOW"));
+    args += m_args;
+
+    auto env = QProcessEnvironment::systemEnvironment();
+    if (m_phaseTiming && mode != LoadMode::None) {
+        const auto module = auditModulePath();
+        if (!module.isEmpty())
+            env.insert(QStringLiteral("LD_AUDIT"), module);
+    }
+
+    if (m_coldCache && mode != LoadMode::None)
+        dropMappedPages();
+
+    proc->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    proc->setProcessEnvironment(env);
+    // an empty path fails to start, which callers handle like any other start failure
+    proc->start(runnerPath(), args);
+}
+
+void LDBenchmark::dropMappedPages()
+{
+    // accessing the files in between runs maps the pages again, so this is needed before every run
+    for (int i = 0; m_fileSet && i < m_fileSet->size(); ++i)
+        m_fileSet->file(i)->dropMappedPages();
+}
+
 void LDBenchmark::readResults(QProcess* proc, LoadMode mode)
 {
     while(proc->canReadLine()) {
         const auto line = proc->readLine();
-        if (!line.startsWith("LDBENCHMARKRUNNER\t")) {
+        const bool isPhases = line.startsWith("LDBENCHMARKPHASES\t");
+        const bool isIo = line.startsWith("LDBENCHMARKIO\t");
+        if (!line.startsWith("LDBENCHMARKRUNNER\t") && !isPhases && !isIo) {
             qDebug() << "target stdout:" << line;
             continue;
         }
-        const auto index = line.lastIndexOf('\t');
-        const auto fileName = line.mid(18, index - 18);
-        const auto cost = line.mid(index).trimmed().toDouble();
+        // tag, file name, time in µs, and optionally the performance counters
+        // or: tag, file name, phase times in µs, object count
+        // or: tag, file name, I/O wait in µs, bytes read, bytes not evicted
+        const auto fields = line.trimmed().split('\t');
+        if (fields.size() < 3) {
+            qWarning() << "Invalid benchmark runner output:" << line;
+            continue;
+        }
+        const auto fileName = fields.at(1);
+        const auto cost = fields.at(2).toDouble();
         auto it = std::find_if(m_results.begin(), m_results.end(), [fileName](const Result &res) {
             return res.fileName == fileName;
         });
         assert(it != m_results.end());
 
+        Samples *samples = nullptr;
         switch (mode) {
             case LoadMode::Lazy:
-                (*it).lazy.push_back(cost);
+                samples = &(*it).lazy;
                 break;
             case LoadMode::Now:
-                (*it).now.push_back(cost);
+                samples = &(*it).now;
                 break;
             case LoadMode::None:
                 return;
         }
+        if (isPhases) {
+            if (fields.size() < 2 + PhaseCount)
+                continue;
+            QVector<double> phases;
+            phases.reserve(PhaseCount);
+            for (int i = 0; i < PhaseCount; ++i)
+                phases.push_back(fields.at(2 + i).toDouble());
+            samples->phases.push_back(phases);
+            continue;
+        }
+        if (isIo) {
+            if (fields.size() < 2 + IoValueCount)
+                continue;
+            QVector<double> io;
+            io.reserve(IoValueCount);
+            for (int i = 0; i < IoValueCount; ++i)
+                io.push_back(fields.at(2 + i).toDouble());
+            samples->io.push_back(io);
+            continue;
+        }
+
+        samples->times.push_back(cost);
+        if (fields.size() >= 3 + CounterCount) {
+            QVector<double> counters;
+            counters.reserve(CounterCount);
+            for (int i = 0; i < CounterCount; ++i)
+                counters.push_back(fields.at(3 + i).toDouble());
+            samples->counters.push_back(counters);
+        }
     }
 }
 
+bool LDBenchmark::isPrecise(LoadMode mode) const
+{
+    for (int i = 0; i < size(); ++i) {
+        const auto stats = statistics(mode, i);
+        if (stats.mean > 0.0 && stats.confidenceInterval > m_targetPrecision * stats.mean)
+            return false;
+    }
+    return true;
+}
+
+LDBenchmark::Statistics LDBenchmark::statistics(LoadMode mode, int index) const
+{
+    Statistics stats;
+    const auto &res = m_results.at(index);
+    const auto &samples = mode == LoadMode::Lazy ? res.lazy : res.now;
+    const auto indexes = inliers(samples.times);
+    if (indexes.isEmpty())
+        return stats;
+    stats = sampleStatistics(samples.times, indexes);
+
+    if (samples.counters.size() == samples.times.size()) {
+        for (int c = 0; c < CounterCount; ++c) {
+            QVector<double> values;
+            foreach (auto i, indexes) {
+                if (samples.counters.at(i).at(c) >= 0.0)
+                    values.push_back(samples.counters.at(i).at(c));
+            }
+            if (!values.isEmpty())
+                stats.counters[c] = ::median(values);
+        }
+    }
+
+    if (samples.phases.size() == samples.times.size()) {
+        for (int p = 0; p < PhaseCount; ++p) {
+            QVector<double> values;
+            foreach (auto i, indexes)
+                values.push_back(samples.phases.at(i).at(p));
+            stats.phases[p] = ::median(values);
+        }
+    }
+
+    if (samples.io.size() == samples.times.size()) {
+        for (int v = 0; v < IoValueCount; ++v) {
+            QVector<double> values;
+            foreach (auto i, indexes) {
+                if (samples.io.at(i).at(v) >= 0.0)
+                    values.push_back(samples.io.at(i).at(v));
+            }
+            if (!values.isEmpty())
+                stats.io[v] = ::median(values);
+        }
+    }
+
+    return stats;
+}
+
+LDBenchmark::Statistics LDBenchmark::startupStatistics(StartupTime time) const
+{
+    QVector<double> values;
+    foreach (const auto &sample, m_startupTimes) {
+        if (sample.at(time) >= 0.0)
+            values.push_back(sample.at(time));
+    }
+    return sampleStatistics(values, inliers(values));
+}
+
+QVector<LDBenchmark::StartupObject> LDBenchmark::startupObjects() const
+{
+    QHash<QString, ElfFile*> files;
+    for (int i = 0; m_fileSet && i < m_fileSet->size(); ++i)
+        files.insert(QFileInfo(m_fileSet->file(i)->fileName()).canonicalFilePath(), m_fileSet->file(i));
+
+    QVector<StartupObject> objects;
+    objects.reserve(m_startupObjects.size());
+    foreach (const auto &samples, m_startupObjects) {
+        StartupObject obj;
+        obj.fileName = samples.fileName;
+        obj.file = files.value(QFileInfo(QString::fromUtf8(samples.fileName)).canonicalFilePath());
+        obj.load = sampleStatistics(samples.times, inliers(samples.times));
+        objects.push_back(obj);
+    }
+    return objects;
+}
+
+const char* LDBenchmark::counterName(Counter counter)
+{
+    switch (counter) {
+        case Instructions: return "instructions";
+        case Cycles: return "cycles";
+        case PageFaults: return "pageFaults";
+        case DTlbMisses: return "dTlbMisses";
+        case CounterCount: break;
+    }
+    return "";
+}
+
+const char* LDBenchmark::phaseName(Phase phase)
+{
+    switch (phase) {
+        case SearchPhase: return "search";
+        case MapPhase: return "map";
+        case RelocationPhase: return "relocation";
+        case PhaseCount: break;
+    }
+    return "";
+}
+
+const char* LDBenchmark::ioValueName(IoValue value)
+{
+    switch (value) {
+        case IoWait: return "ioWait";
+        case BytesRead: return "bytesRead";
+        case CachedBytes: return "cachedBytes";
+        case IoValueCount: break;
+    }
+    return "";
+}
+
+const char* LDBenchmark::startupTimeName(StartupTime time)
+{
+    switch (time) {
+        case ExecTime: return "exec";
+        case LoadTime: return "load";
+        case StartupRelocationTime: return "relocation";
+        case InitTime: return "init";
+        case TimeToMain: return "main";
+        case TimeToMarker: return "marker";
+        case StartupTimeCount: break;
+    }
+    return "";
+}
+
 void LDBenchmark::writeCSV(const QString& fileName)
 {
     QFile f(fileName);
@@ -126,25 +604,163 @@ void LDBenchmark::writeCSV(const QString& fileName)
     }
 
     for (int i = 0; i < m_results.size(); ++i) {
-        const auto res = m_results.at(i);
+        const auto lazy = statistics(LoadMode::Lazy, i);
+        const auto now = statistics(LoadMode::Now, i);
         const auto file = m_fileSet->file(m_results.size() - 1 - i);
         f.write(file->displayName().toUtf8());
         f.write("\t");
-        f.write(QByteArray::number(::median(res.lazy)));
+        f.write(QByteArray::number(lazy.median));
         f.write("\t");
-        f.write(QByteArray::number(::min(res.lazy)));
+        f.write(QByteArray::number(lazy.min));
         f.write("\t");
-        f.write(QByteArray::number(::max(res.lazy)));
+        f.write(QByteArray::number(lazy.max));
         f.write("\t");
-        f.write(QByteArray::number(::median(res.now)));
+        f.write(QByteArray::number(now.median));
         f.write("\t");
-        f.write(QByteArray::number(::min(res.now)));
+        f.write(QByteArray::number(now.min));
         f.write("\t");
-        f.write(QByteArray::number(::max(res.now)));
+        f.write(QByteArray::number(now.max));
+        if (now.phases[SearchPhase] >= 0.0) {
+            for (int p = 0; p < PhaseCount; ++p) {
+                f.write("\t");
+                f.write(QByteArray::number(now.phases[p]));
+            }
+        }
         f.write("\n");
     }
 }
 
+static QJsonArray toJsonArray(const QVector<double> &data)
+{
+    QJsonArray array;
+    foreach (auto v, data)
+        array.push_back(v);
+    return array;
+}
+
+static QJsonObject toJsonObject(const LDBenchmark::Statistics &stats, const QVector<double> &times)
+{
+    QJsonObject obj;
+    obj.insert(QStringLiteral("samples"), stats.samples);
+    obj.insert(QStringLiteral("outliers"), stats.outliers);
+    obj.insert(QStringLiteral("median"), stats.median);
+    obj.insert(QStringLiteral("min"), stats.min);
+    obj.insert(QStringLiteral("max"), stats.max);
+    obj.insert(QStringLiteral("mean"), stats.mean);
+    obj.insert(QStringLiteral("standardDeviation"), stats.standardDeviation);
+    obj.insert(QStringLiteral("confidenceInterval"), stats.confidenceInterval);
+    obj.insert(QStringLiteral("times"), toJsonArray(times));
+    return obj;
+}
+
+void LDBenchmark::writeJSON(const QString& fileName)
+{
+    QFile f(fileName);
+    if (!f.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning() << "Failed to open" << fileName;
+        return;
+    }
+
+    QJsonArray files;
+    for (int i = 0; i < m_results.size(); ++i) {
+        const auto &res = m_results.at(i);
+        QJsonObject fileObj;
+        fileObj.insert(QStringLiteral("name"), file(i)->displayName());
+        fileObj.insert(QStringLiteral("fileName"), QString::fromUtf8(res.fileName));
+
+        for (auto mode : { LoadMode::Lazy, LoadMode::Now }) {
+            const auto stats = statistics(mode, i);
+            const auto &samples = mode == LoadMode::Lazy ? res.lazy : res.now;
+            auto modeObj = toJsonObject(stats, samples.times);
+
+            if (!samples.counters.isEmpty()) {
+                QJsonObject counters;
+                for (int c = 0; c < CounterCount; ++c) {
+                    QVector<double> values;
+                    foreach (const auto &sample, samples.counters)
+                        values.push_back(sample.at(c));
+                    QJsonObject counterObj;
+                    counterObj.insert(QStringLiteral("median"), stats.counters[c]);
+                    counterObj.insert(QStringLiteral("values"), toJsonArray(values));
+                    counters.insert(QLatin1String(counterName(static_cast<Counter>(c))), counterObj);
+                }
+                modeObj.insert(QStringLiteral("counters"), counters);
+            }
+            if (!samples.phases.isEmpty()) {
+                QJsonObject phases;
+                for (int p = 0; p < PhaseCount; ++p) {
+                    QVector<double> values;
+                    foreach (const auto &sample, samples.phases)
+                        values.push_back(sample.at(p));
+                    QJsonObject phaseObj;
+                    phaseObj.insert(QStringLiteral("median"), stats.phases[p]);
+                    phaseObj.insert(QStringLiteral("values"), toJsonArray(values));
+                    phases.insert(QLatin1String(phaseName(static_cast<Phase>(p))), phaseObj);
+                }
+                modeObj.insert(QStringLiteral("phases"), phases);
+            }
+            if (!samples.io.isEmpty()) {
+                QJsonObject io;
+                for (int v = 0; v < IoValueCount; ++v) {
+                    QVector<double> values;
+                    foreach (const auto &sample, samples.io)
+                        values.push_back(sample.at(v));
+                    QJsonObject ioObj;
+                    ioObj.insert(QStringLiteral("median"), stats.io[v]);
+                    ioObj.insert(QStringLiteral("values"), toJsonArray(values));
+                    io.insert(QLatin1String(ioValueName(static_cast<IoValue>(v))), ioObj);
+                }
+                modeObj.insert(QStringLiteral("io"), io);
+            }
+            fileObj.insert(mode == LoadMode::Lazy ? QStringLiteral("lazy") : QStringLiteral("now"), modeObj);
+        }
+        files.push_back(fileObj);
+    }
+
+    QJsonObject config;
+    config.insert(QStringLiteral("warmupIterations"), m_warmupIterations);
+    config.insert(QStringLiteral("minIterations"), m_minIterations);
+    config.insert(QStringLiteral("maxIterations"), m_maxIterations);
+    config.insert(QStringLiteral("targetPrecision"), m_targetPrecision);
+    config.insert(QStringLiteral("cpu"), m_cpu);
+    config.insert(QStringLiteral("hardwareCounters"), m_hardwareCounters);
+    config.insert(QStringLiteral("phaseTiming"), m_phaseTiming);
+    config.insert(QStringLiteral("coldCache"), m_coldCache);
+    if (!m_startupTimes.isEmpty()) {
+        config.insert(QStringLiteral("startupCommand"), QJsonArray::fromStringList(m_startupArgs));
+        config.insert(QStringLiteral("startupMarker"), m_startupMarker);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("config"), config);
+    root.insert(QStringLiteral("files"), files);
+
+    if (!m_startupTimes.isEmpty()) {
+        QJsonObject startup;
+        for (int t = 0; t < StartupTimeCount; ++t) {
+            QVector<double> values;
+            foreach (const auto &sample, m_startupTimes)
+                values.push_back(sample.at(t));
+            const auto time = static_cast<StartupTime>(t);
+            startup.insert(QLatin1String(startupTimeName(time)), toJsonObject(startupStatistics(time), values));
+        }
+
+        QJsonArray objects;
+        const auto startupObjs = startupObjects();
+        for (int i = 0; i < startupObjs.size(); ++i) {
+            auto obj = toJsonObject(startupObjs.at(i).load, m_startupObjects.at(i).times);
+            obj.insert(QStringLiteral("fileName"), QString::fromUtf8(startupObjs.at(i).fileName));
+            if (startupObjs.at(i).file)
+                obj.insert(QStringLiteral("name"), startupObjs.at(i).file->displayName());
+            objects.push_back(obj);
+        }
+        startup.insert(QStringLiteral("objects"), objects);
+        root.insert(QStringLiteral("startup"), startup);
+    }
+
+    f.write(QJsonDocument(root).toJson());
+}
+
 int LDBenchmark::size() const
 {
     return m_results.size();
@@ -152,14 +768,12 @@ int LDBenchmark::size() const
 
 double LDBenchmark::median(LoadMode mode, int index) const
 {
-    const auto &res = m_results.at(index);
-    return ::median(mode == LoadMode::Lazy ? res.lazy : res.now);
+    return statistics(mode, index).median;
 }
 
 double LDBenchmark::min(LDBenchmark::LoadMode mode, int index) const
 {
-    const auto &res = m_results.at(index);
-    return ::min(mode == LoadMode::Lazy ? res.lazy : res.now);
+    return statistics(mode, index).min;
 }
 
 ElfFile* LDBenchmark::file(int index) const
@@ -31,31 +31,181 @@ class ElfFile;
 class LDBenchmark
 {
 public:
+    /** Stops at the first failed runner invocation, keeping the results measured until then. */
     void measureFileSet(ElfFileSet *fileSet);
+    /** Launch the executable of @p fileSet (its first file) with @p arguments repeatedly and measure the
+     *  whole process startup, until main() or until the startup marker is seen.
+     *  Uses the iteration, precision, CPU and cold cache settings, hardware counters are not supported.
+     */
+    void measureStartup(ElfFileSet *fileSet, const QStringList &arguments);
 
     void writeCSV(const QString &fileName);
+    /** Write all statistics and raw samples to @p fileName. */
+    void writeJSON(const QString &fileName);
+
+    /** Runs discarded before measuring, to warm up the page cache. Default: 1. */
+    void setWarmupIterations(int iterations);
+    /** Measure at least @p min and at most @p max times per load mode. Default: 5 and 50. */
+    void setIterations(int min, int max);
+    /** Stop once the 95% confidence interval of the mean is narrower than @p precision times
+     *  the mean, for all files. Default: 0.02, 0 to always run the maximum number of iterations.
+     */
+    void setTargetPrecision(double precision);
+    /** Pin the runner to CPU @p cpu, -1 (default) for no pinning. */
+    void setCpu(int cpu);
+    /** Additionally record hardware performance counters for each dlopen() call. */
+    void setHardwareCounters(bool enable);
+    /** Split each dlopen() call into phases, using the ldbenchmark-audit LD_AUDIT module. */
+    void setPhaseTiming(bool enable);
+    /** Evict all files from the page cache before each run, to measure first start latency.
+     *  Works unprivileged, but pages still mapped by other processes remain cached. The pages mapped
+     *  by the ElfFile instances of the file set are dropped before each run, the runner fails if
+     *  other processes keep any of the files cached.
+     */
+    void setColdCache(bool enable);
+    /** Additionally measure the time until the application writes @p marker to stdout or stderr in
+     *  measureStartup(), and terminate it then. Empty (default) stops at main() instead.
+     */
+    void setStartupMarker(const QString &marker);
 
     /** Number of files we have results for. */
     int size() const;
 
     enum class LoadMode { None, Now, Lazy };
+    enum Counter { Instructions, Cycles, PageFaults, DTlbMisses, CounterCount };
+    enum Phase {
+        /** Probing the library search path. */
+        SearchPhase,
+        /** Opening and mapping the object, and processing its dependencies. */
+        MapPhase,
+        /** Relocation processing and constructors, the audit interface has no hook separating those for dlopen(). */
+        RelocationPhase,
+        PhaseCount
+    };
+    enum IoValue {
+        /** Time spent off-CPU in µs, ie. mostly waiting for I/O. */
+        IoWait,
+        /** Bytes read from storage. */
+        BytesRead,
+        /** Bytes that could not be evicted from the page cache. */
+        CachedBytes,
+        IoValueCount
+    };
+    enum StartupTime {
+        /** From execve() until the dynamic loader is ready to load dependencies. */
+        ExecTime,
+        /** Searching and mapping all dependencies. */
+        LoadTime,
+        /** Relocation processing of all objects. */
+        StartupRelocationTime,
+        /** Constructors of all objects. */
+        InitTime,
+        /** Total time from execve() to main(). */
+        TimeToMain,
+        /** Total time from execve() to the startup marker. */
+        TimeToMarker,
+        StartupTimeCount
+    };
+
+    struct Statistics {
+        /** Samples used, after outlier rejection. */
+        int samples = 0;
+        int outliers = 0;
+        double median = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+        double standardDeviation = 0.0;
+        /** Half width of the 95% confidence interval of the mean. */
+        double confidenceInterval = 0.0;
+        /** Median of the performance counters, -1 if not available. */
+        double counters[CounterCount] = { -1.0, -1.0, -1.0, -1.0 };
+        /** Median time of the phases in µs, -1 if not available. */
+        double phases[PhaseCount] = { -1.0, -1.0, -1.0 };
+        /** Median of the I/O values in cold cache mode, -1 if not available. */
+        double io[IoValueCount] = { -1.0, -1.0, -1.0 };
+    };
+
+    Statistics statistics(LoadMode mode, int index) const;
+    Statistics startupStatistics(StartupTime time) const;
+
+    struct StartupObject {
+        QByteArray fileName;
+        /** Matching entry in the file set, if any. */
+        ElfFile *file = nullptr;
+        /** Time spent searching and mapping this object during startup. */
+        Statistics load;
+    };
+    /** Objects loaded during process startup, in load order. */
+    QVector<StartupObject> startupObjects() const;
+
     double median(LoadMode mode, int index) const;
     double min(LoadMode mode, int index) const;
     ElfFile* file(int index) const;
 
-private:
-    void measure(LoadMode mode, int iterations);
+    static const char* counterName(Counter counter);
+    static const char* phaseName(Phase phase);
+    static const char* ioValueName(IoValue value);
+    static const char* startupTimeName(StartupTime time);
+    /** Location of the ldbenchmark-audit LD_AUDIT module, empty if not found. */
+    static QString auditModulePath();
+    /** Location of the ldbenchmark-runner helper, empty if not found. */
+    static QString runnerPath();
+
+    /** Step-wise execution of measureFileSet(), for running the benchmark asynchronously.
+     *  After prepare(), start a runner process with startRunner() for as long as nextRun()
+     *  returns @c true, and pass its output to readResults() once it finished.
+     */
+    void prepare(ElfFileSet *fileSet);
+    bool nextRun(LoadMode *mode);
+    void startRunner(QProcess *proc, LoadMode mode);
     void readResults(QProcess *proc, LoadMode mode);
+    /** Upper bound of the number of runner invocations, for progress reporting. */
+    int maximumRuns() const;
+
+private:
+    bool isPrecise(LoadMode mode) const;
+    void dropMappedPages();
+    void runStartup(int iterations, bool record);
+    void readStartupResults(QProcess *proc);
 
     ElfFileSet *m_fileSet = nullptr;
 
+    struct Samples {
+        QVector<double> times;
+        QVector<QVector<double>> counters;
+        QVector<QVector<double>> phases;
+        QVector<QVector<double>> io;
+    };
+
     struct Result {
         QByteArray fileName;
-        QVector<double> lazy;
-        QVector<double> now;
+        Samples lazy;
+        Samples now;
     };
     QVector<Result> m_results;
     QStringList m_args;
+
+    struct StartupSamples {
+        QByteArray fileName;
+        QVector<double> times;
+    };
+    QVector<QVector<double>> m_startupTimes;
+    QVector<StartupSamples> m_startupObjects;
+    QStringList m_startupArgs;
+    QString m_startupMarker;
+
+    int m_warmupIterations = 1;
+    int m_minIterations = 5;
+    int m_maxIterations = 50;
+    double m_targetPrecision = 0.02;
+    int m_cpu = -1;
+    bool m_hardwareCounters = false;
+    bool m_phaseTiming = false;
+    bool m_coldCache = false;
+
+    LoadMode m_currentMode = LoadMode::None;
+    int m_currentRuns = 0;
 };
 
 #endif // LDBENCHMARK_H
@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ldbenchmarkjob.h"
+
+#include <QDebug>
+#include <QProcess>
+
+#include <cassert>
+
+LDBenchmarkJob::LDBenchmarkJob(const std::shared_ptr<LDBenchmark>& benchmark, QObject* parent) :
+    QObject(parent),
+    m_benchmark(benchmark)
+{
+}
+
+LDBenchmarkJob::~LDBenchmarkJob()
+{
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished();
+    }
+}
+
+void LDBenchmarkJob::start(ElfFileSet* fileSet)
+{
+    assert(!isRunning());
+    m_completedRuns = 0;
+    m_cancelled = false;
+    m_running = true;
+    m_benchmark->prepare(fileSet);
+    // the benchmark is set up when we return, but no signal is emitted before returning to the event loop
+    QMetaObject::invokeMethod(this, &LDBenchmarkJob::startNextRun, Qt::QueuedConnection);
+}
+
+void LDBenchmarkJob::cancel()
+{
+    m_cancelled = true;
+    if (m_process)
+        m_process->kill();
+}
+
+bool LDBenchmarkJob::isRunning() const
+{
+    return m_running;
+}
+
+void LDBenchmarkJob::startNextRun()
+{
+    if (m_cancelled || !m_benchmark->nextRun(&m_mode)) {
+        m_running = false;
+        emit finished(m_cancelled);
+        return;
+    }
+
+    m_process = new QProcess(this);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &LDBenchmarkJob::runFinished);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            runFinished();
+    });
+    m_benchmark->startRunner(m_process, m_mode);
+}
+
+void LDBenchmarkJob::runFinished()
+{
+    const auto proc = m_process;
+    m_process = nullptr;
+    proc->deleteLater();
+
+    if (m_cancelled) {
+        m_running = false;
+        emit finished(true);
+        return;
+    }
+    if (proc->error() == QProcess::FailedToStart) {
+        qWarning() << "Failed to start benchmark runner:" << proc->errorString();
+        m_running = false;
+        emit finished(true);
+        return;
+    }
+    if (proc->exitStatus() == QProcess::CrashExit || proc->exitCode() != 0) {
+        if (proc->exitStatus() == QProcess::CrashExit)
+            qWarning() << "Benchmark runner crashed!";
+        else
+            qWarning() << "Benchmark runner failed with exit code" << proc->exitCode();
+        m_running = false;
+        emit finished(true);
+        return;
+    }
+
+    m_benchmark->readResults(proc, m_mode);
+    ++m_completedRuns;
+    emit progress(m_completedRuns, m_benchmark->maximumRuns());
+    startNextRun();
+}
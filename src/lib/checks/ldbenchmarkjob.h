@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LDBENCHMARKJOB_H
+#define LDBENCHMARKJOB_H
+
+#include "ldbenchmark.h"
+
+#include <QObject>
+
+#include <memory>
+
+class QProcess;
+
+/** Runs an LDBenchmark asynchronously, ie. without blocking the event loop.
+ *  Results in the benchmark are updated after each runner invocation.
+ */
+class LDBenchmarkJob : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LDBenchmarkJob(const std::shared_ptr<LDBenchmark> &benchmark, QObject *parent = nullptr);
+    ~LDBenchmarkJob();
+
+    void start(ElfFileSet *fileSet);
+    /** Abort the benchmark, results obtained so far remain in the benchmark. */
+    void cancel();
+    bool isRunning() const;
+
+signals:
+    /** New results are available in the benchmark. @p maximum is an upper bound, the benchmark can finish earlier. */
+    void progress(int completed, int maximum);
+    /** @p cancelled is @c true if the benchmark was aborted by cancel() or due to an error. */
+    void finished(bool cancelled);
+
+private:
+    void startNextRun();
+    void runFinished();
+
+    std::shared_ptr<LDBenchmark> m_benchmark;
+    QProcess *m_process = nullptr;
+    LDBenchmark::LoadMode m_mode = LDBenchmark::LoadMode::None;
+    int m_completedRuns = 0;
+    bool m_running = false;
+    bool m_cancelled = false;
+};
+
+#endif // LDBENCHMARKJOB_H
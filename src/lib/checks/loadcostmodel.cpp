@@ -0,0 +1,379 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "loadcostmodel.h"
+#include "relrsavingscheck.h"
+
+#include <elf/elffile.h>
+#include <elf/elfheader.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfrelrsection.h>
+#include <elf/elfsectionheader.h>
+#include <elf/elfsegmentheader.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QString>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include <elf.h>
+
+QString LoadCostModel::featureName(int feature)
+{
+    switch (feature) {
+        case Constant: return QStringLiteral("constant");
+        case RelativeRelocations: return QStringLiteral("relative-relocations");
+        case SymbolicRelocations: return QStringLiteral("symbolic-relocations");
+        case PltRelocations: return QStringLiteral("plt-relocations");
+        case Imports: return QStringLiteral("imports");
+        case Exports: return QStringLiteral("exports");
+        case AverageHashChainLength: return QStringLiteral("average-hash-chain-length");
+        case InitFunctions: return QStringLiteral("init-functions");
+        case LoadSegmentSize: return QStringLiteral("load-segment-kib");
+    }
+    return QString();
+}
+
+QVector<double> LoadCostModel::features(ElfFile* file)
+{
+    QVector<double> f(FeatureCount, 0.0);
+    f[Constant] = 1.0;
+
+    const auto dynamicSection = file->dynamicSection();
+    const auto jmpRelEntry = dynamicSection ? dynamicSection->entryWithTag(DT_JMPREL) : nullptr;
+    foreach (auto shdr, file->sectionHeaders()) {
+        if ((shdr->flags() & SHF_ALLOC) == 0)
+            continue;
+        if (shdr->type() == SHT_RELR || shdr->type() == SHT_ANDROID_RELR) {
+            const auto relrSection = file->section<ElfRelrSection>(shdr->sectionIndex());
+            if (relrSection)
+                f[RelativeRelocations] += relrSection->relocationCount();
+            continue;
+        }
+        if (shdr->type() == SHT_ANDROID_REL || shdr->type() == SHT_ANDROID_RELA) {
+            const auto packedSection = file->section<ElfPackedRelocationSection>(shdr->sectionIndex());
+            for (uint64_t i = 0; packedSection && i < packedSection->relocationCount(); ++i) {
+                if (RelrSavingsCheck::isRelativeRelocation(file->header()->machine(), packedSection->relocationType(i)))
+                    ++f[RelativeRelocations];
+                else
+                    ++f[SymbolicRelocations];
+            }
+            continue;
+        }
+        if (shdr->type() != SHT_REL && shdr->type() != SHT_RELA)
+            continue;
+        const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocSection)
+            continue;
+        if (jmpRelEntry && jmpRelEntry->pointer() == shdr->virtualAddress()) {
+            f[PltRelocations] += shdr->entryCount();
+            continue;
+        }
+        // classify by type, IRELATIVE or TLS relocations have no symbol either but are not plain base adjustments
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            if (RelrSavingsCheck::isRelativeRelocation(file->header()->machine(), relocSection->entry(i)->type()))
+                ++f[RelativeRelocations];
+            else
+                ++f[SymbolicRelocations];
+        }
+    }
+
+    const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+    if (symTab) {
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+            if (symTab->entry(i)->sectionIndex() == SHN_UNDEF)
+                ++f[Imports];
+            else
+                ++f[Exports];
+        }
+    }
+
+    if (file->hash()) {
+        const auto hist = file->hash()->histogram();
+        uint64_t entries = 0;
+        uint64_t usedBuckets = 0;
+        for (int i = 1; i < hist.size(); ++i) {
+            entries += i * hist.at(i);
+            usedBuckets += hist.at(i);
+        }
+        if (usedBuckets > 0)
+            f[AverageHashChainLength] = (double)entries / (double)usedBuckets;
+    }
+
+    if (dynamicSection) {
+        if (dynamicSection->entryWithTag(DT_INIT))
+            ++f[InitFunctions];
+        const auto initArraySize = dynamicSection->entryWithTag(DT_INIT_ARRAYSZ);
+        if (initArraySize)
+            f[InitFunctions] += initArraySize->value() / file->addressSize();
+    }
+
+    foreach (auto phdr, file->segmentHeaders()) {
+        if (phdr->type() == PT_LOAD)
+            f[LoadSegmentSize] += phdr->memorySize() / 1024.0;
+    }
+
+    return f;
+}
+
+void LoadCostModel::addSample(ElfFile* file, double lazyCost, double nowCost)
+{
+    addSample(features(file), lazyCost, nowCost);
+}
+
+void LoadCostModel::addSample(const QVector<double>& features, double lazyCost, double nowCost)
+{
+    m_features.push_back(features);
+    m_lazyCosts.push_back(lazyCost);
+    m_nowCosts.push_back(nowCost);
+}
+
+void LoadCostModel::addSamples(const LDBenchmark& benchmark)
+{
+    for (int i = 0; i < benchmark.size(); ++i)
+        addSample(benchmark.file(i), benchmark.median(LDBenchmark::LoadMode::Lazy, i), benchmark.median(LDBenchmark::LoadMode::Now, i));
+}
+
+int LoadCostModel::sampleCount() const
+{
+    return m_features.size();
+}
+
+bool LoadCostModel::fit()
+{
+    if (m_features.size() < 2) {
+        qWarning() << "Not enough samples to fit the load cost model.";
+        return false;
+    }
+    if (m_features.size() < FeatureCount)
+        qWarning() << "Only" << m_features.size() << "samples for" << FeatureCount << "features, the model will be underdetermined.";
+
+    m_lazyCoefficients = fitNonNegative(m_features, m_lazyCosts);
+    m_nowCoefficients = fitNonNegative(m_features, m_nowCosts);
+    m_lazyRSquared = rSquared(m_lazyCoefficients, m_lazyCosts);
+    m_nowRSquared = rSquared(m_nowCoefficients, m_nowCosts);
+    return true;
+}
+
+// non-negative least squares by cyclic coordinate descent
+// Features are standardized first, their raw scales differ by orders of magnitude (relocation counts vs.
+// average chain length), which would otherwise make convergence depend on the units. The intercept
+// (Constant) follows from the centering and is not constrained.
+QVector<double> LoadCostModel::fitNonNegative(const QVector<QVector<double>>& x, const QVector<double>& y)
+{
+    assert(x.size() == y.size());
+    assert(!x.isEmpty());
+    const double n = x.size();
+
+    double yMean = 0.0;
+    foreach (auto v, y)
+        yMean += v;
+    yMean /= n;
+
+    QVector<double> means(FeatureCount, 0.0);
+    QVector<double> deviations(FeatureCount, 0.0);
+    for (int j = 0; j < FeatureCount; ++j) {
+        if (j == Constant)
+            continue;
+        foreach (const auto &sample, x)
+            means[j] += sample.at(j);
+        means[j] /= n;
+        foreach (const auto &sample, x)
+            deviations[j] += (sample.at(j) - means.at(j)) * (sample.at(j) - means.at(j));
+        deviations[j] = std::sqrt(deviations.at(j) / n);
+    }
+
+    const auto z = [&x, &means, &deviations](int i, int j) {
+        return (x.at(i).at(j) - means.at(j)) / deviations.at(j);
+    };
+
+    QVector<double> scaled(FeatureCount, 0.0);
+    QVector<double> residuals(x.size());
+    for (int i = 0; i < x.size(); ++i)
+        residuals[i] = y.at(i) - yMean;
+
+    // standardized columns all have a squared norm of n
+    bool converged = false;
+    for (int iteration = 0; iteration < 10000 && !converged; ++iteration) {
+        double maxChange = 0.0;
+        for (int j = 0; j < FeatureCount; ++j) {
+            if (j == Constant || deviations.at(j) == 0.0)
+                continue;
+            double gradient = 0.0;
+            for (int i = 0; i < x.size(); ++i)
+                gradient += z(i, j) * residuals.at(i);
+            const auto newCoefficient = std::max(0.0, scaled.at(j) + gradient / n);
+            const auto delta = newCoefficient - scaled.at(j);
+            if (delta == 0.0)
+                continue;
+            for (int i = 0; i < x.size(); ++i)
+                residuals[i] -= delta * z(i, j);
+            scaled[j] = newCoefficient;
+            maxChange = std::max(maxChange, std::abs(delta));
+        }
+        converged = maxChange < 1e-9 * std::max(1.0, std::abs(yMean));
+    }
+    if (!converged)
+        qWarning() << "Load cost model fit did not converge.";
+
+    QVector<double> coefficients(FeatureCount, 0.0);
+    coefficients[Constant] = yMean;
+    for (int j = 0; j < FeatureCount; ++j) {
+        if (j == Constant || deviations.at(j) == 0.0)
+            continue;
+        coefficients[j] = scaled.at(j) / deviations.at(j);
+        coefficients[Constant] -= coefficients.at(j) * means.at(j);
+    }
+    return coefficients;
+}
+
+double LoadCostModel::rSquared(const QVector<double>& coefficients, const QVector<double>& y) const
+{
+    double mean = 0.0;
+    foreach (auto v, y)
+        mean += v;
+    mean /= y.size();
+
+    double residualSum = 0.0;
+    double totalSum = 0.0;
+    for (int i = 0; i < y.size(); ++i) {
+        double prediction = 0.0;
+        for (int j = 0; j < FeatureCount; ++j)
+            prediction += coefficients.at(j) * m_features.at(i).at(j);
+        residualSum += (y.at(i) - prediction) * (y.at(i) - prediction);
+        totalSum += (y.at(i) - mean) * (y.at(i) - mean);
+    }
+    return totalSum > 0.0 ? 1.0 - residualSum / totalSum : 0.0;
+}
+
+QVector<double> LoadCostModel::coefficients(LDBenchmark::LoadMode mode) const
+{
+    return mode == LDBenchmark::LoadMode::Lazy ? m_lazyCoefficients : m_nowCoefficients;
+}
+
+double LoadCostModel::rSquared(LDBenchmark::LoadMode mode) const
+{
+    return mode == LDBenchmark::LoadMode::Lazy ? m_lazyRSquared : m_nowRSquared;
+}
+
+double LoadCostModel::predict(LDBenchmark::LoadMode mode, ElfFile* file) const
+{
+    if (coefficients(mode).size() != FeatureCount)
+        return 0.0;
+    return predict(mode, features(file));
+}
+
+double LoadCostModel::predict(LDBenchmark::LoadMode mode, const QVector<double>& f) const
+{
+    const auto c = coefficients(mode);
+    if (c.size() != FeatureCount || f.size() != FeatureCount)
+        return 0.0;
+
+    double cost = 0.0;
+    for (int i = 0; i < FeatureCount; ++i)
+        cost += c.at(i) * f.at(i);
+    return cost;
+}
+
+bool LoadCostModel::save(const QString& fileName) const
+{
+    QFile f(fileName);
+    if (!f.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning() << "Failed to open" << fileName;
+        return false;
+    }
+
+    f.write("feature\tlazy\tnow\n");
+    for (int i = 0; i < FeatureCount && i < m_lazyCoefficients.size() && i < m_nowCoefficients.size(); ++i) {
+        f.write(featureName(i).toUtf8());
+        f.write("\t");
+        f.write(QByteArray::number(m_lazyCoefficients.at(i)));
+        f.write("\t");
+        f.write(QByteArray::number(m_nowCoefficients.at(i)));
+        f.write("\n");
+    }
+    return true;
+}
+
+bool LoadCostModel::load(const QString& fileName)
+{
+    QFile f(fileName);
+    if (!f.open(QFile::ReadOnly)) {
+        qWarning() << "Failed to open" << fileName;
+        return false;
+    }
+
+    if (f.readLine().trimmed() != "feature\tlazy\tnow") {
+        qWarning() << fileName << "is not a load cost model.";
+        return false;
+    }
+
+    QVector<double> lazyCoefficients(FeatureCount, 0.0);
+    QVector<double> nowCoefficients(FeatureCount, 0.0);
+    QVector<bool> found(FeatureCount, false);
+    while (!f.atEnd()) {
+        const auto line = f.readLine().trimmed();
+        if (line.isEmpty())
+            continue;
+        const auto fields = line.split('\t');
+        if (fields.size() != 3) {
+            qWarning() << "Invalid line in load cost model" << fileName << ":" << line;
+            return false;
+        }
+        int feature = 0;
+        while (feature < FeatureCount && featureName(feature).toUtf8() != fields.at(0))
+            ++feature;
+        if (feature == FeatureCount) {
+            qWarning() << "Unknown feature in load cost model" << fileName << ":" << fields.at(0);
+            return false;
+        }
+        bool lazyOk = false, nowOk = false;
+        lazyCoefficients[feature] = fields.at(1).toDouble(&lazyOk);
+        nowCoefficients[feature] = fields.at(2).toDouble(&nowOk);
+        if (!lazyOk || !nowOk) {
+            qWarning() << "Invalid coefficient in load cost model" << fileName << ":" << line;
+            return false;
+        }
+        found[feature] = true;
+    }
+    if (found.contains(false)) {
+        qWarning() << "Incomplete load cost model" << fileName;
+        return false;
+    }
+
+    m_lazyCoefficients = lazyCoefficients;
+    m_nowCoefficients = nowCoefficients;
+    return true;
+}
+
+void LoadCostModel::printModel() const
+{
+    std::cout << "Load cost model fitted to " << m_features.size() << " samples (R² lazy: " << m_lazyRSquared
+              << ", now: " << m_nowRSquared << ")" << std::endl;
+    for (int i = 0; i < FeatureCount && i < m_lazyCoefficients.size() && i < m_nowCoefficients.size(); ++i) {
+        std::cout << "  " << qPrintable(featureName(i)) << ": " << m_lazyCoefficients.at(i) << " µs lazy, "
+                  << m_nowCoefficients.at(i) << " µs now" << std::endl;
+    }
+}
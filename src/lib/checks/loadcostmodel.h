@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOADCOSTMODEL_H
+#define LOADCOSTMODEL_H
+
+#include "ldbenchmark.h"
+
+#include <QVector>
+
+class ElfFile;
+
+class QString;
+
+/** Linear model of the time needed to load a library, based on static features of the file.
+ *  Per-feature cost coefficients are fitted against LDBenchmark measurements, and can then
+ *  be used to predict the load cost of files that have not been measured.
+ */
+class LoadCostModel
+{
+public:
+    LoadCostModel() = default;
+    LoadCostModel(const LoadCostModel&) = default;
+    ~LoadCostModel() = default;
+
+    LoadCostModel& operator=(const LoadCostModel&) = default;
+
+    enum Feature {
+        Constant, ///< intercept, the fixed cost of loading any library
+        RelativeRelocations,
+        SymbolicRelocations,
+        PltRelocations,
+        Imports,
+        Exports,
+        AverageHashChainLength,
+        InitFunctions,
+        LoadSegmentSize, ///< in KiB
+        FeatureCount
+    };
+    static QString featureName(int feature);
+    /** Extract the values of all features from @p file. */
+    static QVector<double> features(ElfFile *file);
+
+    /** Add a measurement, in microseconds. */
+    void addSample(ElfFile *file, double lazyCost, double nowCost);
+    /** Same as the above, for @p features previously extracted by features(). */
+    void addSample(const QVector<double> &features, double lazyCost, double nowCost);
+    /** Add the median measurements of all files in @p benchmark. */
+    void addSamples(const LDBenchmark &benchmark);
+    int sampleCount() const;
+
+    /** Fit the coefficients of both load modes to the samples added so far.
+     *  Coefficients are constrained to be non-negative, as no feature makes loading faster,
+     *  except for the Constant intercept.
+     */
+    bool fit();
+
+    QVector<double> coefficients(LDBenchmark::LoadMode mode) const;
+    /** Coefficient of determination of the last fit. */
+    double rSquared(LDBenchmark::LoadMode mode) const;
+    /** Predicted load time of @p file in microseconds. */
+    double predict(LDBenchmark::LoadMode mode, ElfFile *file) const;
+    /** Same as the above, for @p features previously extracted by features(). */
+    double predict(LDBenchmark::LoadMode mode, const QVector<double> &features) const;
+
+    bool save(const QString &fileName) const;
+    /** Load coefficients written by save(), returns @c false and keeps the current ones if @p fileName is not a complete model. */
+    bool load(const QString &fileName);
+
+    /** Dump the coefficients to stdout, for use in CLI tools. */
+    void printModel() const;
+
+private:
+    static QVector<double> fitNonNegative(const QVector<QVector<double>> &x, const QVector<double> &y);
+    double rSquared(const QVector<double> &coefficients, const QVector<double> &y) const;
+
+    QVector<QVector<double>> m_features;
+    QVector<double> m_lazyCosts;
+    QVector<double> m_nowCosts;
+
+    QVector<double> m_lazyCoefficients;
+    QVector<double> m_nowCoefficients;
+    double m_lazyRSquared = 0.0;
+    double m_nowRSquared = 0.0;
+};
+
+#endif // LOADCOSTMODEL_H
@@ -0,0 +1,290 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "paddingcostcheck.h"
+
+#include <elf/elffileset.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+#include <dwarf/dwarfexpression.h>
+
+#include <dwarf.h>
+#endif
+
+#include <QDebug>
+#include <QFile>
+#include <QVector>
+
+#include <algorithm>
+#include <iostream>
+
+static QByteArray normalizedTypeName(QByteArray name)
+{
+    name.replace(' ', "");
+    name.replace('\t', "");
+    return name;
+}
+
+static bool parseCount(const QByteArray &s, qint64 *count)
+{
+    bool ok = false;
+    *count = s.toLongLong(&ok);
+    return ok && *count >= 0;
+}
+
+void PaddingCostCheck::setElfFileSet(ElfFileSet* fileSet)
+{
+    m_packingCheck.setElfFileSet(fileSet);
+}
+
+bool PaddingCostCheck::loadHeapHistogram(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "Failed to open heap histogram" << fileName << ":" << file.errorString();
+        return false;
+    }
+
+    while (!file.atEnd()) {
+        const auto line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        // type names can contain spaces and commas themselves, so the count is either the first or the last field
+        int sepIdx = -1;
+        for (int i = line.size() - 1; i >= 0 && sepIdx < 0; --i) {
+            if (line.at(i) == ' ' || line.at(i) == '\t' || line.at(i) == ',')
+                sepIdx = i;
+        }
+        if (sepIdx < 0) {
+            qWarning() << "Invalid heap histogram entry:" << line;
+            continue;
+        }
+
+        qint64 count = 0;
+        QByteArray typeName;
+        if (parseCount(line.mid(sepIdx + 1), &count)) {
+            typeName = line.left(sepIdx);
+        } else {
+            sepIdx = 0;
+            while (sepIdx < line.size() && line.at(sepIdx) != ' ' && line.at(sepIdx) != '\t' && line.at(sepIdx) != ',')
+                ++sepIdx;
+            if (!parseCount(line.left(sepIdx), &count)) {
+                qWarning() << "Invalid heap histogram entry:" << line;
+                continue;
+            }
+            typeName = line.mid(sepIdx + 1);
+        }
+
+        typeName = typeName.trimmed();
+        if (typeName.endsWith(','))
+            typeName.chop(1);
+        if (typeName.startsWith(','))
+            typeName.remove(0, 1);
+        m_heapHistogram[normalizedTypeName(typeName)] += count;
+    }
+
+    return true;
+}
+
+void PaddingCostCheck::collect(DwarfInfo* info)
+{
+#if HAVE_DWARF
+    if (!info)
+        return;
+
+    QHash<DwarfDie*, InstanceCount> instances;
+    QHash<QByteArray, DwarfDie*> definitions;
+    QSet<quint64> addresses;
+    foreach (auto die, info->compilationUnits())
+        collectDie(die, instances, definitions, addresses);
+
+    // heap instances are only accounted once, even if the type is defined in multiple files
+    for (auto it = m_heapHistogram.constBegin(); it != m_heapHistogram.constEnd(); ++it) {
+        if (m_heapTypesFound.contains(it.key()))
+            continue;
+        const auto defIt = definitions.constFind(it.key());
+        if (defIt == definitions.constEnd())
+            continue;
+        instances[defIt.value()].heapCount += it.value();
+        m_heapTypesFound.insert(it.key());
+    }
+
+    for (auto it = instances.constBegin(); it != instances.constEnd(); ++it)
+        addInstances(it.key(), it.value(), 0);
+#else
+    Q_UNUSED(info);
+#endif
+}
+
+void PaddingCostCheck::collectDie(DwarfDie* die, QHash<DwarfDie*, InstanceCount>& instances, QHash<QByteArray, DwarfDie*>& definitions, QSet<quint64>& addresses) const
+{
+#if HAVE_DWARF
+    switch (die->tag()) {
+        case DW_TAG_class_type:
+        case DW_TAG_structure_type:
+            if (die->typeSize() > 0)
+                definitions.insert(normalizedTypeName(die->fullyQualifiedName()), die);
+            break;
+        case DW_TAG_variable:
+        {
+            if (die->attribute(DW_AT_declaration).toBool())
+                break;
+            // only variables with a fixed address, ie. globals and static locals, not stack or TLS variables
+            auto location = die->attribute(DW_AT_location).value<DwarfExpression>();
+            if (!location.evaluateSimple())
+                break;
+            // inlined copies of static locals refer to the same address, addresses are all 0 in unlinked object files though
+            const auto address = location.top();
+            if (address != 0) {
+                if (addresses.contains(address))
+                    break;
+                addresses.insert(address);
+            }
+
+            const auto typeDie = die->attribute(DW_AT_type).value<DwarfDie*>();
+            qint64 multiplicity = 1;
+            const auto structDie = instanceType(typeDie, &multiplicity);
+            if (structDie && multiplicity > 0)
+                instances[structDie].staticCount += multiplicity;
+            break;
+        }
+    }
+
+    foreach (auto child, die->children()) {
+        if (child->tag() == DW_TAG_member || child->tag() == DW_TAG_inheritance)
+            continue;
+        collectDie(child, instances, definitions, addresses);
+    }
+#else
+    Q_UNUSED(die);
+    Q_UNUSED(instances);
+    Q_UNUSED(definitions);
+    Q_UNUSED(addresses);
+#endif
+}
+
+DwarfDie* PaddingCostCheck::instanceType(DwarfDie* typeDie, qint64* multiplicity) const
+{
+#if HAVE_DWARF
+    while (typeDie) {
+        switch (typeDie->tag()) {
+            case DW_TAG_typedef:
+            case DW_TAG_const_type:
+            case DW_TAG_volatile_type:
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+            case DW_TAG_array_type:
+                foreach (auto subrangeDie, typeDie->children()) {
+                    if (subrangeDie->tag() != DW_TAG_subrange_type)
+                        continue;
+                    const auto count = subrangeDie->attribute(DW_AT_count);
+                    const auto upperBound = subrangeDie->attribute(DW_AT_upper_bound);
+                    if (!count.isNull())
+                        *multiplicity *= count.toLongLong();
+                    else if (!upperBound.isNull()) // highest allowed index, not the size
+                        *multiplicity *= upperBound.toLongLong() + 1;
+                    else
+                        *multiplicity = 0; // flexible array member
+                }
+                typeDie = typeDie->attribute(DW_AT_type).value<DwarfDie*>();
+                continue;
+            case DW_TAG_class_type:
+            case DW_TAG_structure_type:
+            {
+                const auto structDie = m_packingCheck.findTypeDefinition(typeDie);
+                if (structDie->typeSize() <= 0)
+                    return nullptr;
+                return structDie;
+            }
+            default:
+                return nullptr;
+        }
+    }
+#else
+    Q_UNUSED(typeDie);
+    Q_UNUSED(multiplicity);
+#endif
+    return nullptr;
+}
+
+void PaddingCostCheck::addInstances(DwarfDie* structDie, const InstanceCount& count, int depth)
+{
+#if HAVE_DWARF
+    const auto name = normalizedTypeName(structDie->fullyQualifiedName());
+    auto &cost = m_costs[name];
+    if (cost.size == 0) {
+        cost.name = structDie->fullyQualifiedName();
+        cost.location = structDie->sourceLocation();
+        cost.size = structDie->typeSize();
+        cost.optimalSize = m_packingCheck.optimalStructureSize(structDie);
+    }
+    cost.staticInstances += count.staticCount;
+    cost.heapInstances += count.heapCount;
+
+    // members by value are instances as well, and their padding is not included in our own saving
+    if (depth >= 32)
+        return;
+    foreach (auto memberDie, StructurePackingCheck::structureMembers(structDie)) {
+        qint64 multiplicity = 1;
+        const auto memberTypeDie = instanceType(memberDie->attribute(DW_AT_type).value<DwarfDie*>(), &multiplicity);
+        if (!memberTypeDie || multiplicity <= 0)
+            continue;
+        InstanceCount memberCount;
+        memberCount.staticCount = count.staticCount * multiplicity;
+        memberCount.heapCount = count.heapCount * multiplicity;
+        addInstances(memberTypeDie, memberCount, depth + 1);
+    }
+#else
+    Q_UNUSED(structDie);
+    Q_UNUSED(count);
+    Q_UNUSED(depth);
+#endif
+}
+
+qint64 PaddingCostCheck::TypeCost::wastedBytes() const
+{
+    return std::max(0, size - optimalSize) * (staticInstances + heapInstances);
+}
+
+void PaddingCostCheck::printRanking(int limit) const
+{
+    QVector<TypeCost> costs;
+    costs.reserve(m_costs.size());
+    for (const auto &cost : m_costs) {
+        if (cost.wastedBytes() > 0)
+            costs.push_back(cost);
+    }
+    std::sort(costs.begin(), costs.end(), [](const TypeCost &lhs, const TypeCost &rhs) {
+        return lhs.wastedBytes() > rhs.wastedBytes();
+    });
+    if (limit > 0 && costs.size() > limit)
+        costs.resize(limit);
+
+    qint64 totalWaste = 0;
+    for (const auto &cost : costs) {
+        totalWaste += cost.wastedBytes();
+        std::cout << cost.wastedBytes() << " bytes wasted: " << cost.name.constData()
+                  << " (size: " << cost.size << ", optimal size: " << cost.optimalSize
+                  << ", instances: " << cost.staticInstances << " static, " << cost.heapInstances << " heap)"
+                  << " // location: " << qPrintable(cost.location) << std::endl;
+    }
+    std::cout << "Total: " << totalWaste << " bytes wasted in " << costs.size() << " types." << std::endl;
+}
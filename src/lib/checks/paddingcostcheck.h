@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef PADDINGCOSTCHECK_H
+#define PADDINGCOSTCHECK_H
+
+#include "structurepackingcheck.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+class ElfFileSet;
+class DwarfInfo;
+class DwarfDie;
+
+/** Rank structures by the total amount of memory wasted due to padding.
+ *  The per-type saving determined by StructurePackingCheck is weighted with the number
+ *  of instances, taken from global and static variables (including array dimensions and
+ *  nested members) and optionally from a heap allocation histogram.
+ */
+class PaddingCostCheck
+{
+public:
+    PaddingCostCheck() = default;
+    PaddingCostCheck(const PaddingCostCheck&) = default;
+    ~PaddingCostCheck() = default;
+
+    PaddingCostCheck& operator=(const PaddingCostCheck&) = default;
+
+    /** Set the ELF file set the checked DWARF info belongs to.*/
+    void setElfFileSet(ElfFileSet *fileSet);
+
+    /** Load a heap allocation histogram.
+     *  One type per line, consisting of the fully qualified type name and the number of
+     *  live instances, separated by white space, a tab or a comma. Lines starting with '#' are ignored.
+     */
+    bool loadHeapHistogram(const QString &fileName);
+
+    /** Collect structure instances from the DWARF info of one file. */
+    void collect(DwarfInfo *info);
+    /** Dump the @p limit types wasting the most memory to stdout, all of them if @p limit is not positive. */
+    void printRanking(int limit) const;
+
+private:
+    struct InstanceCount {
+        qint64 staticCount = 0;
+        qint64 heapCount = 0;
+    };
+
+    struct TypeCost {
+        QByteArray name;
+        QString location;
+        int size = 0;
+        int optimalSize = 0;
+        qint64 staticInstances = 0;
+        qint64 heapInstances = 0;
+
+        qint64 wastedBytes() const;
+    };
+
+    void collectDie(DwarfDie *die, QHash<DwarfDie*, InstanceCount> &instances, QHash<QByteArray, DwarfDie*> &definitions, QSet<quint64> &addresses) const;
+    DwarfDie* instanceType(DwarfDie *typeDie, qint64 *multiplicity) const;
+    void addInstances(DwarfDie *structDie, const InstanceCount &count, int depth);
+
+    StructurePackingCheck m_packingCheck;
+    QHash<QByteArray, qint64> m_heapHistogram;
+    QSet<QByteArray> m_heapTypesFound;
+    QHash<QByteArray, TypeCost> m_costs;
+};
+
+#endif // PADDINGCOSTCHECK_H
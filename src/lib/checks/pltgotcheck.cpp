@@ -0,0 +1,324 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "pltgotcheck.h"
+
+#include <demangle/demangler.h>
+#include <disassmbler/instructiondecoder.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfgotentry.h>
+#include <elf/elfgotsection.h>
+#include <elf/elfpltsection.h>
+#include <elf/elfrelocationentry.h>
+#include <elf/elfreverserelocator.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsymboltablesection.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfcudie.h>
+#endif
+
+#include <QSet>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include <elf.h>
+
+PltGotCheck::PltGotCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+}
+
+int PltGotCheck::Sites::indirections() const
+{
+    int sum = 0;
+    for (int i = PltCall; i < KindCount; ++i)
+        sum += count[i];
+    return sum;
+}
+
+PltGotCheck::Sites& PltGotCheck::Sites::operator+=(const Sites& other)
+{
+    for (int i = 0; i < KindCount; ++i)
+        count[i] += other.count[i];
+    crossUnitCalls += other.crossUnitCalls;
+    return *this;
+}
+
+const char* PltGotCheck::kindName(Kind kind)
+{
+    switch (kind) {
+        case DirectCall: return "direct calls";
+        case PltCall: return "PLT calls";
+        case IntraLibraryPltCall: return "PLT calls within the library";
+        case GotCall: return "calls through the GOT";
+        case GotAccess: return "GOT accesses";
+        case IntraLibraryGotAccess: return "GOT accesses within the library";
+        case KindCount: break;
+    }
+    return "";
+}
+
+QHash<uint64_t, ElfRelocationEntry*> PltGotCheck::pltStubs(ElfFile* file, const InstructionDecoder& decoder)
+{
+    QHash<uint64_t, ElfRelocationEntry*> stubs;
+    InstructionDecoder::Instruction insn;
+    foreach (auto shdr, file->sectionHeaders()) {
+        if (strncmp(shdr->name(), ".plt", 4) != 0 || shdr->type() == SHT_NOBITS)
+            continue;
+        const auto entrySize = shdr->entrySize() > 0 ? shdr->entrySize() : 16;
+        const auto stubCount = stubs.size();
+
+        // works for all x86 PLT layouts, the stubs load the GOT slot PC-relative
+        const unsigned char *data = file->section<ElfSection>(shdr->sectionIndex())->rawData();
+        size_t size = shdr->size();
+        auto address = shdr->virtualAddress();
+        while (size > 0 && decoder.decode(&data, &size, &address, &insn)) {
+            if (!insn.dataTarget)
+                continue;
+            const auto reloc = file->reverseRelocator()->find(insn.dataTarget);
+            if (reloc && reloc->symbolIndex() != 0 && reloc->symbol())
+                stubs.insert(shdr->virtualAddress() + (insn.address - shdr->virtualAddress()) / entrySize * entrySize, reloc);
+        }
+
+        // otherwise rely on the PLT/GOT entry mapping
+        const auto pltSection = file->section<ElfPltSection>(shdr->sectionIndex());
+        if (stubs.size() > stubCount || !pltSection)
+            continue;
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto gotEntry = pltSection->entry(i)->gotEntry();
+            const auto reloc = gotEntry ? gotEntry->relocation() : nullptr;
+            if (reloc && reloc->symbolIndex() != 0 && reloc->symbol())
+                stubs.insert(shdr->virtualAddress() + i * entrySize, reloc);
+        }
+    }
+    return stubs;
+}
+
+QVector<PltGotCheck::Result> PltGotCheck::analyze() const
+{
+    QVector<Result> results;
+    results.reserve(m_fileSet->size());
+    for (int i = 0; i < m_fileSet->size(); ++i)
+        results.push_back(analyzeFile(m_fileSet->file(i)));
+    return results;
+}
+
+static bool isFunction(ElfSymbolTableEntry *sym)
+{
+    return sym->type() == STT_FUNC || sym->type() == STT_GNU_IFUNC;
+}
+
+/** Relocation of the GOT slot at @p vaddr, @c nullptr if that isn't a GOT slot for a symbol. */
+static ElfRelocationEntry* gotSlot(ElfFile *file, uint64_t vaddr)
+{
+    const auto sectionIndex = file->indexOfSectionWithVirtualAddress(vaddr);
+    if (sectionIndex < 0 || !file->section<ElfGotSection>(sectionIndex))
+        return nullptr;
+    const auto reloc = file->reverseRelocator()->find(vaddr);
+    if (!reloc || reloc->symbolIndex() == 0 || !reloc->symbol())
+        return nullptr;
+    return reloc;
+}
+
+PltGotCheck::Result PltGotCheck::analyzeFile(ElfFile* file) const
+{
+    Result result;
+    result.file = file;
+
+    const auto symTab = file->symbolTable();
+    InstructionDecoder decoder(file);
+    if (!symTab || !decoder.isValid())
+        return result;
+    result.disassembled = true;
+
+    const auto stubs = pltStubs(file, decoder);
+#if HAVE_DWARF
+    QHash<uint64_t, DwarfCuDie*> cuCache;
+    const auto compilationUnit = [file, &cuCache](uint64_t addr) -> DwarfCuDie* {
+        if (!file->dwarfInfo())
+            return nullptr;
+        const auto it = cuCache.constFind(addr);
+        if (it != cuCache.constEnd())
+            return it.value();
+        const auto cu = file->dwarfInfo()->compilationUnitForAddress(addr);
+        cuCache.insert(addr, cu);
+        return cu;
+    };
+#endif
+
+    QSet<uint64_t> scanned;
+    InstructionDecoder::Instruction insn;
+    for (uint32_t i = 0; i < symTab->header()->entryCount(); ++i) {
+        const auto sym = symTab->entry(i);
+        if (!isFunction(sym) || !sym->hasValidSection() || sym->size() == 0 || (sym->sectionHeader()->flags() & SHF_EXECINSTR) == 0)
+            continue;
+        if (scanned.contains(sym->value()))
+            continue;
+        scanned.insert(sym->value());
+
+        Function function;
+        function.function = sym;
+#if HAVE_DWARF
+        const auto cu = compilationUnit(sym->value());
+#endif
+
+        const unsigned char *data = sym->data();
+        size_t size = sym->size();
+        auto address = sym->value();
+        const auto funcEnd = sym->value() + sym->size();
+        while (size > 0 && decoder.decode(&data, &size, &address, &insn)) {
+            if (insn.isCall || insn.isJump) {
+                // branches within the function
+                if (insn.isJump && insn.branchTarget >= sym->value() && insn.branchTarget < funcEnd)
+                    continue;
+
+                if (insn.branchTarget) {
+                    const auto reloc = stubs.value(insn.branchTarget);
+                    if (reloc) {
+                        const auto kind = reloc->symbol()->hasValidSection() ? IntraLibraryPltCall : PltCall;
+                        ++function.sites.count[kind];
+                        ++result.callees[reloc->symbol()->name()].count[kind];
+                        continue;
+                    }
+
+                    ++function.sites.count[DirectCall];
+#if HAVE_DWARF
+                    const auto target = symTab->entryWithValue(insn.branchTarget);
+                    const auto targetCu = compilationUnit(insn.branchTarget);
+                    if (target && cu && targetCu && cu != targetCu) {
+                        ++function.sites.crossUnitCalls;
+                        auto &callee = result.callees[target->name()];
+                        ++callee.count[DirectCall];
+                        ++callee.crossUnitCalls;
+                    }
+#endif
+                    continue;
+                }
+                if (insn.dataTarget) {
+                    if (const auto reloc = gotSlot(file, insn.dataTarget)) {
+                        ++function.sites.count[GotCall];
+                        ++result.callees[reloc->symbol()->name()].count[GotCall];
+                    }
+                }
+                // indirect calls through registers are out of scope
+                continue;
+            }
+
+            if (!insn.dataTarget)
+                continue;
+            if (const auto reloc = gotSlot(file, insn.dataTarget)) {
+                const auto kind = reloc->symbol()->hasValidSection() ? IntraLibraryGotAccess : GotAccess;
+                ++function.sites.count[kind];
+                ++result.callees[reloc->symbol()->name()].count[kind];
+            }
+        }
+
+        result.sites += function.sites;
+        if (function.sites.indirections() > 0)
+            result.functions.push_back(function);
+    }
+
+    std::sort(result.functions.begin(), result.functions.end(), [](const Function &lhs, const Function &rhs) {
+        return lhs.sites.indirections() > rhs.sites.indirections();
+    });
+    return result;
+}
+
+struct Candidate {
+    ElfFile *file;
+    QByteArray name;
+    int count;
+};
+
+static void printCandidates(const char *title, QVector<Candidate> &candidates, int limit)
+{
+    if (candidates.isEmpty())
+        return;
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &lhs, const Candidate &rhs) {
+        return lhs.count > rhs.count;
+    });
+    std::cout << std::endl << title << std::endl;
+    for (int i = 0; i < candidates.size() && (limit <= 0 || i < limit); ++i) {
+        const auto &c = candidates.at(i);
+        std::cout << "  " << c.count << " sites: " << Demangler::demangleFull(c.name.constData()).constData();
+        if (c.file)
+            std::cout << " (" << qPrintable(c.file->displayName()) << ")";
+        std::cout << std::endl;
+    }
+}
+
+void PltGotCheck::printReport(int limit) const
+{
+    const auto results = analyze();
+
+    QHash<QByteArray, int> pltCallees;
+    QVector<Candidate> visibilityCandidates;
+    QVector<Candidate> ltoCandidates;
+
+    foreach (const auto &result, results) {
+        if (!result.disassembled) {
+            std::cout << qPrintable(result.file->displayName()) << ": not disassembled" << std::endl;
+            continue;
+        }
+
+        std::cout << qPrintable(result.file->displayName()) << ":";
+        for (int i = 0; i < KindCount; ++i)
+            std::cout << (i == 0 ? " " : ", ") << result.sites.count[i] << " " << kindName(static_cast<Kind>(i));
+        std::cout << std::endl;
+        if (result.sites.crossUnitCalls > 0)
+            std::cout << "  " << result.sites.crossUnitCalls << " direct calls across compilation units" << std::endl;
+
+        for (int i = 0; i < result.functions.size() && (limit <= 0 || i < limit); ++i) {
+            const auto &function = result.functions.at(i);
+            std::cout << "  " << Demangler::demangleFull(function.function->name()).constData() << ":";
+            bool first = true;
+            for (int j = PltCall; j < KindCount; ++j) {
+                if (function.sites.count[j] == 0)
+                    continue;
+                std::cout << (first ? " " : ", ") << function.sites.count[j] << " " << kindName(static_cast<Kind>(j));
+                first = false;
+            }
+            std::cout << std::endl;
+        }
+
+        for (auto it = result.callees.constBegin(); it != result.callees.constEnd(); ++it) {
+            pltCallees[it.key()] += it.value().count[PltCall];
+            const auto intraLibrary = it.value().count[IntraLibraryPltCall] + it.value().count[IntraLibraryGotAccess];
+            if (intraLibrary > 0)
+                visibilityCandidates.push_back({ result.file, it.key(), intraLibrary });
+            if (it.value().crossUnitCalls > 0)
+                ltoCandidates.push_back({ result.file, it.key(), it.value().crossUnitCalls });
+        }
+    }
+
+    QVector<Candidate> noPltCandidates;
+    for (auto it = pltCallees.constBegin(); it != pltCallees.constEnd(); ++it) {
+        if (it.value() > 0)
+            noPltCandidates.push_back({ nullptr, it.key(), it.value() });
+    }
+
+    printCandidates("-fno-plt candidates, external functions called through the PLT:", noPltCandidates, limit);
+    printCandidates("Visibility candidates, own symbols used through the PLT/GOT (hidden/protected visibility, -Bsymbolic):", visibilityCandidates, limit);
+    printCandidates("LTO candidates, functions called directly from other compilation units:", ltoCandidates, limit);
+}
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLTGOTCHECK_H
+#define PLTGOTCHECK_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfRelocationEntry;
+class ElfSymbolTableEntry;
+class InstructionDecoder;
+
+/** Disassembles all functions and classifies their calls and PC-relative data accesses by the
+ *  indirection they go through: direct, via a PLT stub, via a GOT slot. Calls and accesses
+ *  to definitions in the same library that still go through the PLT/GOT are reported separately,
+ *  as are direct calls across compilation units, which only LTO could inline.
+ */
+class PltGotCheck
+{
+public:
+    explicit PltGotCheck(ElfFileSet *fileSet);
+    PltGotCheck(const PltGotCheck&) = default;
+    ~PltGotCheck() = default;
+
+    PltGotCheck& operator=(const PltGotCheck&) = default;
+
+    enum Kind {
+        DirectCall,
+        PltCall,
+        IntraLibraryPltCall,
+        GotCall, ///< call through a GOT slot, as with -fno-plt; on AArch64 the slot is loaded first, counting as GOT access
+        GotAccess,
+        IntraLibraryGotAccess,
+        KindCount
+    };
+
+    struct Sites {
+        int count[KindCount] = {};
+        /** Direct calls into a different compilation unit, if DWARF information is available. */
+        int crossUnitCalls = 0;
+
+        /** Everything but direct calls. */
+        int indirections() const;
+        Sites& operator+=(const Sites &other);
+    };
+
+    struct Function {
+        ElfSymbolTableEntry *function = nullptr;
+        Sites sites;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        /** @c false if the code couldn't be disassembled. */
+        bool disassembled = false;
+        Sites sites;
+        /** Functions with indirections, most first. */
+        QVector<Function> functions;
+        /** Called or accessed symbols, by name. */
+        QHash<QByteArray, Sites> callees;
+    };
+
+    /** Analyze all files of the set. */
+    QVector<Result> analyze() const;
+
+    /** Dump the results to stdout, with up to @p limit entries per list. */
+    void printReport(int limit = 25) const;
+
+    static const char* kindName(Kind kind);
+
+    /** Maps the PLT stubs of @p file (in .plt, .plt.sec, .plt.got) to the relocation of the GOT slot they jump through. */
+    static QHash<uint64_t, ElfRelocationEntry*> pltStubs(ElfFile *file, const InstructionDecoder &decoder);
+
+private:
+    Result analyzeFile(ElfFile *file) const;
+
+    ElfFileSet *m_fileSet;
+};
+
+#endif // PLTGOTCHECK_H
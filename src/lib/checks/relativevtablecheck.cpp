@@ -0,0 +1,288 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "relativevtablecheck.h"
+
+#include <demangle/demangler.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfreverserelocator.h>
+#include <elf/elfsectionheader.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QHash>
+#include <QPair>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include <elf.h>
+
+void RelativeVTableCheck::setPageSize(uint64_t pageSize)
+{
+    assert(pageSize > 0);
+    m_pageSize = pageSize;
+}
+
+uint64_t RelativeVTableCheck::VTable::size() const
+{
+    return symbol->size();
+}
+
+uint64_t RelativeVTableCheck::VTable::relativeSize() const
+{
+    return slotCount * sizeof(int32_t);
+}
+
+int RelativeVTableCheck::Result::savedRelocations() const
+{
+    return relocationCount - gotEntryCount;
+}
+
+int64_t RelativeVTableCheck::Result::savedBytes() const
+{
+    return (int64_t)(size + relocationTableSize) - (int64_t)(relativeSize + gotSize);
+}
+
+namespace {
+struct PointerTarget {
+    ElfFile *file;
+    ElfSymbolTableEntry *symbol;
+};
+}
+
+/** Resolve the pointer at @p offset in @p object, following symbolic relocations into other files of @p fileSet.
+ *  The file is @c nullptr if the target is not defined in the file set.
+ */
+static PointerTarget resolvePointer(ElfFileSet *fileSet, ElfFile *file, ElfSymbolTableEntry *object, uint64_t offset)
+{
+    const auto vaddr = object->value() + offset;
+    const auto reloc = file->reverseRelocator()->find(vaddr);
+    if (reloc && reloc->symbolIndex() != 0) {
+        const auto sym = reloc->symbol();
+        if (!sym || sym->hasValidSection())
+            return { file, sym };
+        for (int i = 0; i < fileSet->size(); ++i) {
+            const auto f = fileSet->file(i);
+            if (f == file || !f->hash())
+                continue;
+            const auto def = f->hash()->lookup(sym->name());
+            if (def && def->hasValidSection())
+                return { f, def };
+        }
+        return { nullptr, sym };
+    }
+
+    uint64_t target = 0;
+    if (reloc && reloc->relocationTable()->header()->type() == SHT_RELA) {
+        target = reloc->addend();
+    } else {
+        target = file->readPointer(object->data() + offset);
+    }
+
+    const auto symTab = file->symbolTable();
+    return { file, symTab ? symTab->entryWithValue(target) : nullptr };
+}
+
+static bool hasContent(ElfSymbolTableEntry *entry, uint64_t size)
+{
+    return entry->hasValidSection() && entry->sectionHeader()->type() != SHT_NOBITS && entry->size() >= size;
+}
+
+/** Follow the primary base chain in the RTTI starting at the type info @p typeInfo. */
+static QByteArray hierarchyRoot(ElfFileSet *fileSet, PointerTarget typeInfo)
+{
+    QByteArray root;
+    for (int depth = 0; depth < 64 && typeInfo.symbol; ++depth) {
+        root = typeInfo.symbol->name();
+        if (!typeInfo.file)
+            break;
+        const auto addrSize = typeInfo.file->addressSize();
+        if (!hasContent(typeInfo.symbol, 3 * addrSize))
+            break;
+
+        // Itanium ABI: vptr, name, and for __si_class_type_info the base type info, for
+        // __vmi_class_type_info flags, base count and an array of base type info and offset flags
+        const auto typeInfoClass = resolvePointer(fileSet, typeInfo.file, typeInfo.symbol, 0);
+        if (!typeInfoClass.symbol)
+            break;
+        if (strstr(typeInfoClass.symbol->name(), "__si_class_type_info")) {
+            typeInfo = resolvePointer(fileSet, typeInfo.file, typeInfo.symbol, 2 * addrSize);
+        } else if (strstr(typeInfoClass.symbol->name(), "__vmi_class_type_info")) {
+            const auto baseOffset = 2 * addrSize + 2 * sizeof(uint32_t);
+            if (!hasContent(typeInfo.symbol, baseOffset + addrSize))
+                break;
+            const auto baseCount = typeInfo.file->readUInt32(typeInfo.symbol->data() + 2 * addrSize + sizeof(uint32_t));
+            if (baseCount == 0)
+                break;
+            typeInfo = resolvePointer(fileSet, typeInfo.file, typeInfo.symbol, baseOffset);
+        } else {
+            break;
+        }
+    }
+
+    if (root.startsWith("_ZTI"))
+        return Demangler::demangleFull(QByteArray("_Z" + root.mid(4)).constData());
+    return Demangler::demangleFull(root.constData());
+}
+
+RelativeVTableCheck::Result RelativeVTableCheck::analyze(ElfFileSet* fileSet, int fileIndex) const
+{
+    Result result;
+    result.file = fileSet->file(fileIndex);
+    const auto file = result.file;
+    const auto symTab = file->symbolTable();
+    if (!symTab)
+        return result;
+
+    const auto addrSize = file->addressSize();
+    const auto relocator = file->reverseRelocator();
+    QSet<uint64_t> seenAddresses;
+    QSet<uint64_t> pages;
+    QSet<QByteArray> externalTargets;
+
+    for (uint32_t i = 0; i < symTab->header()->entryCount(); ++i) {
+        const auto entry = symTab->entry(i);
+        if (entry->type() != STT_OBJECT || entry->size() < 2 * addrSize || !hasContent(entry, 0))
+            continue;
+        const auto symbolType = Demangler::symbolType(entry->name());
+        if (symbolType != Demangler::SymbolType::VTable && symbolType != Demangler::SymbolType::ConstructionVTable)
+            continue;
+        if (seenAddresses.contains(entry->value())) // aliases
+            continue;
+        seenAddresses.insert(entry->value());
+
+        VTable vtable;
+        vtable.symbol = entry;
+        vtable.slotCount = entry->size() / addrSize;
+        for (int slot = 0; slot < vtable.slotCount; ++slot) {
+            const auto vaddr = entry->value() + slot * addrSize;
+            if (!relocator->isRelocated(vaddr))
+                continue;
+            ++vtable.relocationCount;
+            vtable.pages.insert(vaddr / m_pageSize);
+            const auto reloc = relocator->find(vaddr);
+            if (!reloc)
+                continue;
+            vtable.relocationTableSize += reloc->relocationTable()->header()->entrySize();
+            const auto sym = reloc->symbol();
+            if (reloc->symbolIndex() != 0 && sym && !sym->hasValidSection())
+                vtable.externalTargets.insert(sym->name());
+        }
+        // the RTTI pointer follows the offset to top, for the primary vtable as well as for construction vtables
+        vtable.hierarchy = hierarchyRoot(fileSet, resolvePointer(fileSet, file, entry, addrSize));
+
+        result.relocationCount += vtable.relocationCount;
+        result.relocationTableSize += vtable.relocationTableSize;
+        result.size += vtable.size();
+        result.relativeSize += vtable.relativeSize();
+        pages += vtable.pages;
+        externalTargets += vtable.externalTargets;
+        result.vtables.push_back(vtable);
+    }
+
+    // GOT entries can be shared by all vtables, and the vtables themselves move to read-only data
+    // each GOT entry needs a GLOB_DAT relocation, Elf_Rela is three words, Elf_Rel two
+    const auto gotRelocationSize = (file->indexOfSection(SHT_RELA) >= 0 ? 3 : 2) * addrSize;
+    result.gotEntryCount = externalTargets.size();
+    result.gotSize = result.gotEntryCount * (addrSize + gotRelocationSize);
+    result.dirtyPages = pages.size();
+    result.relativeDirtyPages = (result.gotEntryCount * addrSize + m_pageSize - 1) / m_pageSize;
+    return result;
+}
+
+namespace {
+struct HierarchyStats {
+    QByteArray name;
+    int vtableCount = 0;
+    int relocationCount = 0;
+    uint64_t size = 0;
+    uint64_t relativeSize = 0;
+    QSet<ElfFile*> files;
+    QSet<QPair<ElfFile*, uint64_t>> pages;
+    QSet<QPair<ElfFile*, QByteArray>> gotEntries;
+
+    int savedRelocations() const { return relocationCount - gotEntries.size(); }
+};
+}
+
+void RelativeVTableCheck::printReport(ElfFileSet* fileSet, int limit) const
+{
+    QHash<QByteArray, HierarchyStats> hierarchies;
+    int totalRelocations = 0;
+    int totalGotEntries = 0;
+    int totalDirtyPages = 0;
+    int totalRelativeDirtyPages = 0;
+    int64_t totalSavedBytes = 0;
+
+    std::cout << "Per library:" << std::endl;
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto result = analyze(fileSet, i);
+        if (result.vtables.isEmpty())
+            continue;
+
+        totalRelocations += result.relocationCount;
+        totalGotEntries += result.gotEntryCount;
+        totalDirtyPages += result.dirtyPages;
+        totalRelativeDirtyPages += result.relativeDirtyPages;
+        totalSavedBytes += result.savedBytes();
+
+        std::cout << "  " << qPrintable(result.file->displayName()) << ": " << result.vtables.size() << " vtables, "
+                  << result.relocationCount << " relocations -> " << result.gotEntryCount << " GOT entries, "
+                  << result.size << " -> " << result.relativeSize << " bytes, "
+                  << result.dirtyPages << " -> " << result.relativeDirtyPages << " dirty pages, saves "
+                  << result.savedBytes() << " bytes" << std::endl;
+
+        foreach (const auto &vtable, result.vtables) {
+            auto &stats = hierarchies[vtable.hierarchy];
+            stats.name = vtable.hierarchy;
+            ++stats.vtableCount;
+            stats.relocationCount += vtable.relocationCount;
+            stats.size += vtable.size();
+            stats.relativeSize += vtable.relativeSize();
+            stats.files.insert(result.file);
+            foreach (auto page, vtable.pages)
+                stats.pages.insert(qMakePair(result.file, page));
+            foreach (const auto &target, vtable.externalTargets)
+                stats.gotEntries.insert(qMakePair(result.file, target));
+        }
+    }
+
+    auto sortedHierarchies = hierarchies.values();
+    std::sort(sortedHierarchies.begin(), sortedHierarchies.end(), [](const HierarchyStats &lhs, const HierarchyStats &rhs) {
+        return lhs.savedRelocations() > rhs.savedRelocations();
+    });
+
+    std::cout << std::endl << "Per class hierarchy:" << std::endl;
+    for (int i = 0; i < sortedHierarchies.size() && (limit <= 0 || i < limit); ++i) {
+        const auto &stats = sortedHierarchies.at(i);
+        std::cout << "  " << (stats.name.isEmpty() ? "<unknown>" : stats.name.constData()) << ": " << stats.vtableCount << " vtables in "
+                  << stats.files.size() << " libraries, " << stats.relocationCount << " relocations -> " << stats.gotEntries.size()
+                  << " GOT entries, " << stats.size << " -> " << stats.relativeSize << " bytes, " << stats.pages.size()
+                  << " relocated pages" << std::endl;
+    }
+
+    std::cout << std::endl << "Total: " << totalRelocations << " relocations -> " << totalGotEntries << " GOT entries, "
+              << totalDirtyPages << " -> " << totalRelativeDirtyPages << " dirty pages ("
+              << ((totalDirtyPages - totalRelativeDirtyPages) * (int64_t)m_pageSize / 1024) << " kB per process), saves "
+              << totalSavedBytes << " bytes" << std::endl;
+}
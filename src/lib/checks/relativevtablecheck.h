@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef RELATIVEVTABLECHECK_H
+#define RELATIVEVTABLECHECK_H
+
+#include <QByteArray>
+#include <QSet>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+
+/** Estimates the savings of the relative vtable ABI (clang -fexperimental-relative-c++-abi-vtables).
+ *  There every vtable slot is a 32bit offset rather than a pointer, so vtables become
+ *  position-independent read-only data. Only references to other libraries remain, via one
+ *  GOT entry per distinct target.
+ */
+class RelativeVTableCheck
+{
+public:
+    RelativeVTableCheck() = default;
+    RelativeVTableCheck(const RelativeVTableCheck&) = default;
+    ~RelativeVTableCheck() = default;
+
+    RelativeVTableCheck& operator=(const RelativeVTableCheck&) = default;
+
+    /** Page size in bytes, 4096 by default. */
+    void setPageSize(uint64_t pageSize);
+
+    struct VTable {
+        ElfSymbolTableEntry *symbol = nullptr;
+        /** Demangled name of the root class of the primary base chain, as found in the RTTI. */
+        QByteArray hierarchy;
+        int slotCount = 0;
+        int relocationCount = 0;
+        /** Size of the relocation entries of this vtable, 0 for RELR or packed relocations. */
+        uint64_t relocationTableSize = 0;
+        /** Pages containing relocated slots. */
+        QSet<uint64_t> pages;
+        /** Symbols in other libraries that would need a GOT entry. */
+        QSet<QByteArray> externalTargets;
+
+        uint64_t size() const;
+        uint64_t relativeSize() const;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        QVector<VTable> vtables;
+        int relocationCount = 0;
+        int gotEntryCount = 0;
+        int dirtyPages = 0;
+        int relativeDirtyPages = 0;
+        uint64_t size = 0;
+        uint64_t relativeSize = 0;
+        uint64_t relocationTableSize = 0;
+        /** Size of the new GOT entries including their relocations. */
+        uint64_t gotSize = 0;
+
+        int savedRelocations() const;
+        int64_t savedBytes() const;
+    };
+
+    /** Analyze all vtables and construction vtables of the file at @p fileIndex in @p fileSet.
+     *  The other files are used to follow class hierarchies across library boundaries.
+     */
+    Result analyze(ElfFileSet *fileSet, int fileIndex) const;
+
+    /** Dump per-library results and the @p limit class hierarchies with the most saved relocations (all for 0). */
+    void printReport(ElfFileSet *fileSet, int limit) const;
+
+private:
+    uint64_t m_pageSize = 4096;
+};
+
+#endif // RELATIVEVTABLECHECK_H
@@ -0,0 +1,229 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "relocateddatacheck.h"
+#include "relrsavingscheck.h"
+
+#include <demangle/demangler.h>
+#include <elf/elffile.h>
+#include <elf/elfheader.h>
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfrelrsection.h>
+#include <elf/elfsectionheader.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QByteArrayList>
+#include <QSet>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include <elf.h>
+
+void RelocatedDataCheck::setPageSize(uint64_t pageSize)
+{
+    assert(pageSize > 0);
+    m_pageSize = pageSize;
+}
+
+const char* RelocatedDataCheck::classificationName(Classification classification)
+{
+    switch (classification) {
+        case OffsetTableCandidate: return "offset table candidate";
+        case LocalSymbolic: return "local symbolic";
+        case External: return "external";
+        case CompilerGenerated: return "compiler generated";
+    }
+    return "";
+}
+
+namespace {
+enum RelocationKind {
+    RelativeRelocation,
+    LocalSymbolicRelocation,
+    ExternalRelocation
+};
+
+struct RelocationTarget {
+    uint64_t offset;
+    RelocationKind kind;
+    bool operator<(const RelocationTarget &other) const { return offset < other.offset; }
+};
+}
+
+static QVector<RelocationTarget> relocationTargets(ElfFile *file)
+{
+    QVector<RelocationTarget> targets;
+    foreach (auto shdr, file->sectionHeaders()) {
+        if ((shdr->flags() & SHF_ALLOC) == 0)
+            continue;
+        if (shdr->type() == SHT_RELR || shdr->type() == SHT_ANDROID_RELR) {
+            const auto relrSection = file->section<ElfRelrSection>(shdr->sectionIndex());
+            if (!relrSection)
+                continue;
+            foreach (auto offset, relrSection->relocationOffsets())
+                targets.push_back({ offset, RelativeRelocation });
+            continue;
+        }
+        if (shdr->type() == SHT_ANDROID_REL || shdr->type() == SHT_ANDROID_RELA) {
+            const auto packedSection = file->section<ElfPackedRelocationSection>(shdr->sectionIndex());
+            if (!packedSection)
+                continue;
+            const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+            const auto offsets = packedSection->relocationOffsets();
+            for (int i = 0; i < offsets.size(); ++i) {
+                RelocationKind kind = ExternalRelocation;
+                const auto symIndex = packedSection->symbolIndex(i);
+                if (RelrSavingsCheck::isRelativeRelocation(file->header()->machine(), packedSection->relocationType(i))) {
+                    kind = RelativeRelocation;
+                } else if (symIndex != 0 && symTab && symIndex < symTab->header()->entryCount()) {
+                    if (symTab->entry(symIndex)->sectionIndex() != SHN_UNDEF)
+                        kind = LocalSymbolicRelocation;
+                }
+                targets.push_back({ offsets.at(i), kind });
+            }
+            continue;
+        }
+        if (shdr->type() != SHT_REL && shdr->type() != SHT_RELA)
+            continue;
+        const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocSection)
+            continue;
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto reloc = relocSection->entry(i);
+            RelocationKind kind = ExternalRelocation;
+            if (RelrSavingsCheck::isRelativeRelocation(file->header()->machine(), reloc->type())) {
+                kind = RelativeRelocation;
+            } else if (reloc->symbolIndex() != 0) {
+                const auto sym = reloc->symbol();
+                if (sym && sym->sectionIndex() != SHN_UNDEF)
+                    kind = LocalSymbolicRelocation;
+            }
+            targets.push_back({ reloc->offset(), kind });
+        }
+    }
+    std::sort(targets.begin(), targets.end());
+    return targets;
+}
+
+QVector<RelocatedDataCheck::Object> RelocatedDataCheck::analyze(ElfFile* file) const
+{
+    QVector<Object> objects;
+    const auto symTab = file->symbolTable();
+    if (!symTab)
+        return objects;
+
+    const auto targets = relocationTargets(file);
+    Demangler demangler;
+    QSet<uint64_t> seenAddresses;
+
+    for (uint32_t i = 0; i < symTab->header()->entryCount(); ++i) {
+        const auto entry = symTab->entry(i);
+        if (entry->type() != STT_OBJECT || entry->size() == 0 || !entry->hasValidSection())
+            continue;
+        const auto shdr = entry->sectionHeader();
+        if ((shdr->flags() & (SHF_WRITE | SHF_ALLOC)) != (SHF_WRITE | SHF_ALLOC) || shdr->type() == SHT_NOBITS || (shdr->flags() & SHF_TLS))
+            continue;
+        if (seenAddresses.contains(entry->value())) // aliases
+            continue;
+        seenAddresses.insert(entry->value());
+
+        Object obj;
+        const RelocationTarget begin = { entry->value(), RelativeRelocation };
+        const RelocationTarget end = { entry->value() + entry->size(), RelativeRelocation };
+        for (auto it = std::lower_bound(targets.constBegin(), targets.constEnd(), begin); it != targets.constEnd() && *it < end; ++it) {
+            ++obj.relocationCount;
+            if ((*it).kind == RelativeRelocation)
+                ++obj.relativeCount;
+            else if ((*it).kind == LocalSymbolicRelocation)
+                ++obj.localSymbolicCount;
+            const auto page = (*it).offset / m_pageSize;
+            if (obj.pages.isEmpty() || obj.pages.last() != page)
+                obj.pages.push_back(page);
+        }
+        obj.pageCount = obj.pages.size();
+        if (obj.relocationCount == 0)
+            continue;
+
+        obj.symbol = entry;
+        obj.name = Demangler::demangleFull(entry->name());
+        auto parts = demangler.demangle(entry->name());
+        if (parts.size() > 1) {
+            parts.removeLast();
+            obj.owner = parts.toList().join("::");
+        }
+
+        if (Demangler::symbolType(entry->name()) != Demangler::SymbolType::Normal)
+            obj.classification = CompilerGenerated;
+        else if (obj.relativeCount == obj.relocationCount)
+            obj.classification = OffsetTableCandidate;
+        else if (obj.relativeCount + obj.localSymbolicCount == obj.relocationCount)
+            obj.classification = LocalSymbolic;
+        else
+            obj.classification = External;
+        objects.push_back(obj);
+    }
+
+    // dirty pages are what costs memory, the relocation count only breaks ties
+    std::sort(objects.begin(), objects.end(), [](const Object &lhs, const Object &rhs) {
+        if (lhs.pageCount != rhs.pageCount)
+            return lhs.pageCount > rhs.pageCount;
+        return lhs.relocationCount > rhs.relocationCount;
+    });
+    return objects;
+}
+
+int RelocatedDataCheck::distinctPageCount(const QVector<Object>& objects)
+{
+    QSet<uint64_t> pages;
+    foreach (const auto &obj, objects) {
+        foreach (auto page, obj.pages)
+            pages.insert(page);
+    }
+    return pages.size();
+}
+
+void RelocatedDataCheck::printReport(ElfFile* file, int limit) const
+{
+    const auto objects = analyze(file);
+
+    int relocationCounts[CompilerGenerated + 1] = {};
+    QVector<Object> classifiedObjects[CompilerGenerated + 1];
+    for (int i = 0; i < objects.size(); ++i) {
+        const auto &obj = objects.at(i);
+        relocationCounts[obj.classification] += obj.relocationCount;
+        classifiedObjects[obj.classification].push_back(obj);
+
+        if (limit > 0 && i >= limit)
+            continue;
+        std::cout << obj.relocationCount << " relocations, " << obj.pageCount << " pages, " << classificationName(obj.classification)
+                  << ", " << obj.symbol->sectionHeader()->name() << ": " << obj.name.constData();
+        if (!obj.owner.isEmpty())
+            std::cout << " (owner: " << obj.owner.constData() << ")";
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl << qPrintable(file->displayName()) << ": " << objects.size() << " relocated data objects on "
+              << distinctPageCount(objects) << " pages" << std::endl;
+    for (int c = OffsetTableCandidate; c <= CompilerGenerated; ++c) {
+        std::cout << "  " << classificationName(static_cast<Classification>(c)) << ": " << classifiedObjects[c].size() << " objects, "
+                  << relocationCounts[c] << " relocations, " << distinctPageCount(classifiedObjects[c]) << " pages" << std::endl;
+    }
+}
@@ -0,0 +1,88 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef RELOCATEDDATACHECK_H
+#define RELOCATEDDATACHECK_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfSymbolTableEntry;
+
+/** Finds data objects in writable sections (.data.rel.ro, .data) that need relocations,
+ *  ie. tables of pointers. If all of those point into the same library they can be replaced
+ *  by tables of offsets in read-only data, saving the relocations and the dirty pages.
+ */
+class RelocatedDataCheck
+{
+public:
+    RelocatedDataCheck() = default;
+    RelocatedDataCheck(const RelocatedDataCheck&) = default;
+    ~RelocatedDataCheck() = default;
+
+    RelocatedDataCheck& operator=(const RelocatedDataCheck&) = default;
+
+    /** Page size in bytes, 4096 by default. */
+    void setPageSize(uint64_t pageSize);
+
+    enum Classification {
+        /** Only relative relocations, can be turned into an offset table. */
+        OffsetTableCandidate,
+        /** Also symbolic relocations against symbols defined in this library, which become
+         *  relative ones with hidden visibility or -Bsymbolic.
+         */
+        LocalSymbolic,
+        /** Points into other libraries. */
+        External,
+        /** Vtables, typeinfo and VTTs, see the relative vtable ABI for those. */
+        CompilerGenerated
+    };
+
+    struct Object {
+        ElfSymbolTableEntry *symbol = nullptr;
+        QByteArray name;
+        /** Demangled class, namespace or function this object belongs to. */
+        QByteArray owner;
+        int relocationCount = 0;
+        int relativeCount = 0;
+        int localSymbolicCount = 0;
+        /** Distinct pages the relocations of this object write to. */
+        int pageCount = 0;
+        /** Indexes of those pages, ie. their address divided by the page size. */
+        QVector<uint64_t> pages;
+        Classification classification = OffsetTableCandidate;
+    };
+
+    /** All relocated data objects of @p file, sorted by the number of pages they dirty, then by relocation count. */
+    QVector<Object> analyze(ElfFile *file) const;
+
+    /** Distinct pages dirtied by @p objects, pages shared by several objects are counted once. */
+    static int distinctPageCount(const QVector<Object> &objects);
+
+    static const char* classificationName(Classification classification);
+
+    /** Dump the @p limit objects dirtying the most pages (all for 0) and a summary to stdout. */
+    void printReport(ElfFile *file, int limit) const;
+
+private:
+    uint64_t m_pageSize = 4096;
+};
+
+#endif // RELOCATEDDATACHECK_H
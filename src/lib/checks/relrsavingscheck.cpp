@@ -0,0 +1,182 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "relrsavingscheck.h"
+#include "loadcostmodel.h"
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfheader.h>
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfrelrsection.h>
+#include <elf/elfsectionheader.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include <elf.h>
+
+void RelrSavingsCheck::setPageSize(uint64_t pageSize)
+{
+    assert(pageSize > 0);
+    m_pageSize = pageSize;
+}
+
+void RelrSavingsCheck::setLoadCostModel(const LoadCostModel* model)
+{
+    m_costModel = model;
+}
+
+uint64_t RelrSavingsCheck::Result::savedBytes() const
+{
+    return relativeTableSize > relrSize ? relativeTableSize - relrSize : 0;
+}
+
+bool RelrSavingsCheck::isRelativeRelocation(uint16_t machine, uint32_t type)
+{
+    switch (machine) {
+        case EM_386:
+            return type == R_386_RELATIVE;
+        case EM_X86_64:
+            return type == R_X86_64_RELATIVE;
+        case EM_ARM:
+            return type == R_ARM_RELATIVE;
+        case EM_AARCH64:
+            return type == R_AARCH64_RELATIVE;
+        case EM_PPC:
+            return type == R_PPC_RELATIVE;
+        case EM_PPC64:
+            return type == R_PPC64_RELATIVE;
+        case EM_S390:
+            return type == R_390_RELATIVE;
+#if defined(EM_RISCV) && defined(R_RISCV_RELATIVE)
+        case EM_RISCV:
+            return type == R_RISCV_RELATIVE;
+#endif
+    }
+    return false;
+}
+
+RelrSavingsCheck::Result RelrSavingsCheck::analyze(ElfFile* file)
+{
+    Result result;
+    result.file = file;
+
+    const auto jmpRelEntry = file->dynamicSection() ? file->dynamicSection()->entryWithTag(DT_JMPREL) : nullptr;
+    const uint64_t wordSize = file->addressSize();
+    QVector<uint64_t> relativeOffsets;
+
+    foreach (auto shdr, file->sectionHeaders()) {
+        if ((shdr->flags() & SHF_ALLOC) == 0)
+            continue;
+        switch (shdr->type()) {
+            case SHT_REL:
+            case SHT_RELA:
+            {
+                // PLT relocations are processed separately, and can't be RELR
+                if (jmpRelEntry && jmpRelEntry->pointer() == shdr->virtualAddress())
+                    break;
+                const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+                if (!relocSection)
+                    break;
+                result.relocationCount += shdr->entryCount();
+                result.relocationTableSize += shdr->size();
+                for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+                    const auto reloc = relocSection->entry(i);
+                    if (!isRelativeRelocation(file->header()->machine(), reloc->type()) || (reloc->offset() % wordSize) != 0)
+                        continue;
+                    ++result.relativeCount;
+                    result.relativeTableSize += shdr->entrySize();
+                    relativeOffsets.push_back(reloc->offset());
+                }
+                break;
+            }
+            case SHT_RELR:
+            case SHT_ANDROID_RELR:
+            {
+                const auto relrSection = file->section<ElfRelrSection>(shdr->sectionIndex());
+                if (relrSection)
+                    result.packedCount += relrSection->relocationCount();
+                break;
+            }
+            case SHT_ANDROID_REL:
+            case SHT_ANDROID_RELA:
+            {
+                const auto packedSection = file->section<ElfPackedRelocationSection>(shdr->sectionIndex());
+                if (packedSection)
+                    result.packedCount += packedSection->relocationCount();
+                break;
+            }
+        }
+    }
+
+    std::sort(relativeOffsets.begin(), relativeOffsets.end());
+    result.relrSize = ElfRelrSection::encodedSize(relativeOffsets, file->addressSize());
+    return result;
+}
+
+void RelrSavingsCheck::printReport(ElfFileSet* fileSet) const
+{
+    uint64_t totalTableSize = 0;
+    uint64_t totalSavedBytes = 0;
+    uint64_t totalSavedPages = 0;
+    uint64_t totalRelative = 0;
+    double totalSavedTime = 0.0;
+
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto result = analyze(fileSet->file(i));
+        if (result.packedCount > 0) {
+            std::cout << qPrintable(result.file->displayName()) << ": already uses packed relocations ("
+                      << result.packedCount << " relocations)" << std::endl;
+            continue;
+        }
+        if (result.relativeCount == 0)
+            continue;
+
+        const auto pagesBefore = (result.relocationTableSize + m_pageSize - 1) / m_pageSize;
+        const auto pagesAfter = (result.relocationTableSize - result.savedBytes() + m_pageSize - 1) / m_pageSize;
+        totalTableSize += result.relocationTableSize;
+        totalSavedBytes += result.savedBytes();
+        totalSavedPages += pagesBefore - pagesAfter;
+        totalRelative += result.relativeCount;
+
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.relativeCount << " of "
+                  << result.relocationCount << " relocations are relative, " << result.relocationTableSize << " -> "
+                  << (result.relocationTableSize - result.savedBytes()) << " bytes (" << result.relrSize << " bytes RELR), "
+                  << pagesBefore << " -> " << pagesAfter << " pages to read";
+
+        // RELR still applies every relative relocation, only reading the smaller table gets cheaper,
+        // so estimate that with the fitted per-KiB cost of the load segments
+        if (m_costModel) {
+            const auto coefficients = m_costModel->coefficients(LDBenchmark::LoadMode::Now);
+            if (coefficients.size() == LoadCostModel::FeatureCount) {
+                const auto savedTime = coefficients.at(LoadCostModel::LoadSegmentSize) * result.savedBytes() / 1024.0;
+                totalSavedTime += savedTime;
+                std::cout << ", estimated ~" << savedTime << " µs for reading less";
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Total: " << totalRelative << " relative relocations, " << totalSavedBytes << " of " << totalTableSize
+              << " relocation table bytes and " << totalSavedPages << " pages saved";
+    if (m_costModel)
+        std::cout << ", estimated ~" << totalSavedTime << " µs load time saved by reading less";
+    std::cout << std::endl;
+}
@@ -0,0 +1,73 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef RELRSAVINGSCHECK_H
+#define RELRSAVINGSCHECK_H
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class LoadCostModel;
+
+/** Estimates the savings of linking with -z pack-relative-relocs.
+ *  All word-aligned relative relocations in REL/RELA sections can be moved into a RELR
+ *  section, which encodes them in a few bits each rather than a full relocation entry.
+ */
+class RelrSavingsCheck
+{
+public:
+    RelrSavingsCheck() = default;
+    RelrSavingsCheck(const RelrSavingsCheck&) = default;
+    ~RelrSavingsCheck() = default;
+
+    RelrSavingsCheck& operator=(const RelrSavingsCheck&) = default;
+
+    /** Page size in bytes, 4096 by default. */
+    void setPageSize(uint64_t pageSize);
+    /** Optional load cost model to estimate the time saved by reading smaller relocation tables. */
+    void setLoadCostModel(const LoadCostModel *model);
+
+    struct Result {
+        ElfFile *file = nullptr;
+        /** Non-PLT relocations in REL/RELA sections. */
+        uint64_t relocationCount = 0;
+        uint64_t relocationTableSize = 0;
+        /** Relocations that can be converted to RELR. */
+        uint64_t relativeCount = 0;
+        uint64_t relativeTableSize = 0;
+        /** Size of the RELR section holding the relative relocations. */
+        uint64_t relrSize = 0;
+        /** Relocations already in RELR or packed sections. */
+        uint64_t packedCount = 0;
+
+        uint64_t savedBytes() const;
+    };
+
+    static Result analyze(ElfFile *file);
+    /** Returns whether @p type is the R_*_RELATIVE relocation type of @p machine. */
+    static bool isRelativeRelocation(uint16_t machine, uint32_t type);
+
+    /** Dump the estimates for all files in @p fileSet to stdout. */
+    void printReport(ElfFileSet *fileSet) const;
+
+private:
+    uint64_t m_pageSize = 4096;
+    const LoadCostModel *m_costModel = nullptr;
+};
+
+#endif // RELRSAVINGSCHECK_H
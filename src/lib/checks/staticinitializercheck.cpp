@@ -0,0 +1,421 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "staticinitializercheck.h"
+#include "ldbenchmark.h"
+
+#include <demangle/demangler.h>
+#include <disassmbler/instructiondecoder.h>
+#include <elf/elfdynamicsection.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfheader.h>
+#include <elf/elfrelocationentry.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfreverserelocator.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsymboltablesection.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfcudie.h>
+#endif
+
+#include <QHash>
+#include <QProcess>
+#include <QSet>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <elf.h>
+
+// upper bound for following direct calls
+static const int MaxFunctions = 256;
+// for code without symbol we disassemble until the first return, but not beyond this
+static const uint64_t MaxUnboundedSize = 4096;
+
+StaticInitializerCheck::StaticInitializerCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+}
+
+void StaticInitializerCheck::setPageSize(uint64_t pageSize)
+{
+    m_pageSize = pageSize;
+}
+
+QByteArray StaticInitializerCheck::Initializer::name() const
+{
+    if (symbol)
+        return Demangler::demangleFull(symbol->name());
+    return QByteArray("0x") + QByteArray::number(qulonglong(address), 16);
+}
+
+int StaticInitializerCheck::Result::instructions() const
+{
+    int sum = 0;
+    foreach (const auto &init, initializers)
+        sum += std::max(init.instructions, 0);
+    return sum;
+}
+
+double StaticInitializerCheck::Result::runtime() const
+{
+    double sum = -1.0;
+    foreach (const auto &init, initializers) {
+        if (init.runtime >= 0.0)
+            sum = std::max(sum, 0.0) + init.runtime;
+    }
+    return sum;
+}
+
+const char* StaticInitializerCheck::kindName(Kind kind)
+{
+    switch (kind) {
+        case PreInitArray: return ".preinit_array";
+        case Init: return "DT_INIT";
+        case InitArray: return ".init_array";
+        case Ctors: return ".ctors";
+        case IfuncResolver: return "IFUNC resolver";
+    }
+    return "";
+}
+
+static bool isIRelativeRelocation(uint16_t machine, uint32_t type)
+{
+    switch (machine) {
+        case EM_386:
+            return type == R_386_IRELATIVE;
+        case EM_X86_64:
+            return type == R_X86_64_IRELATIVE;
+#ifdef R_ARM_IRELATIVE
+        case EM_ARM:
+            return type == R_ARM_IRELATIVE;
+#endif
+        case EM_AARCH64:
+            return type == R_AARCH64_IRELATIVE;
+    }
+    return false;
+}
+
+/** Pointer value at @p vaddr after applying relocations, 0 if unknown. */
+static uint64_t readPointer(ElfFile *file, uint64_t vaddr)
+{
+    const auto reloc = file->reverseRelocator()->find(vaddr);
+    const bool hasAddend = reloc && reloc->relocationTable()->header()->type() == SHT_RELA;
+    if (reloc && reloc->symbolIndex() != 0) {
+        const auto sym = reloc->symbol();
+        if (!sym || !sym->hasValidSection())
+            return 0;
+        return sym->value() + (hasAddend ? reloc->addend() : 0);
+    }
+    if (hasAddend)
+        return reloc->addend();
+
+    // implicit addend, or RELR
+    const auto sectionIndex = file->indexOfSectionWithVirtualAddress(vaddr);
+    if (sectionIndex < 0)
+        return 0;
+    const auto section = file->section<ElfSection>(sectionIndex);
+    if (!section || section->header()->type() == SHT_NOBITS)
+        return 0;
+    const auto offset = vaddr - section->header()->virtualAddress();
+    if (offset + file->addressSize() > section->size())
+        return 0;
+    return file->readPointer(section->rawData() + offset);
+}
+
+// IFUNC symbols point to their resolver
+static bool isFunction(ElfSymbolTableEntry *sym)
+{
+    return sym->type() == STT_FUNC || sym->type() == STT_GNU_IFUNC;
+}
+
+static ElfSymbolTableEntry* functionSymbol(ElfFile *file, uint64_t addr)
+{
+    const auto symTab = file->symbolTable();
+    if (!symTab)
+        return nullptr;
+    auto sym = symTab->entryWithValue(addr);
+    if (!sym || !isFunction(sym))
+        sym = symTab->entryContainingValue(addr);
+    if (sym && isFunction(sym) && sym->value() == addr && sym->hasValidSection())
+        return sym;
+    return nullptr;
+}
+
+QVector<StaticInitializerCheck::Result> StaticInitializerCheck::analyze() const
+{
+    QVector<Result> results;
+    results.reserve(m_fileSet->size());
+    for (int i = m_fileSet->size() - 1; i >= 0; --i)
+        results.push_back(analyzeFile(m_fileSet->file(i)));
+    return results;
+}
+
+StaticInitializerCheck::Result StaticInitializerCheck::analyzeFile(ElfFile* file) const
+{
+    Result result;
+    result.file = file;
+
+    const InstructionDecoder decoder(file);
+    const auto addInitializer = [this, file, &decoder, &result](Kind kind, uint64_t address) {
+        // .ctors is delimited by -1 and 0, unused .init_array slots are 0
+        if (address == 0 || address == ~uint64_t(0) || (file->addressSize() == 4 && address == 0xffffffff))
+            return;
+        Initializer init;
+        init.kind = kind;
+        init.address = address;
+        init.symbol = functionSymbol(file, address);
+#if HAVE_DWARF
+        if (file->dwarfInfo()) {
+            if (const auto cu = file->dwarfInfo()->compilationUnitForAddress(address))
+                init.compilationUnit = cu->name();
+        }
+#endif
+        analyzeCode(file, decoder, init);
+        result.initializers.push_back(init);
+    };
+
+    // IFUNC resolvers run during relocation, ie. before any constructor
+    foreach (auto shdr, file->sectionHeaders()) {
+        if ((shdr->flags() & SHF_ALLOC) == 0 || (shdr->type() != SHT_REL && shdr->type() != SHT_RELA))
+            continue;
+        const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocSection)
+            continue;
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto reloc = relocSection->entry(i);
+            if (!isIRelativeRelocation(file->header()->machine(), reloc->type()))
+                continue;
+            addInitializer(IfuncResolver, shdr->type() == SHT_RELA ? reloc->addend() : readPointer(file, reloc->offset()));
+        }
+    }
+
+    // order as executed by the dynamic loader
+    foreach (auto shdr, file->sectionHeaders()) {
+        if (shdr->type() != SHT_PREINIT_ARRAY)
+            continue;
+        for (uint64_t offset = 0; offset < shdr->size(); offset += file->addressSize())
+            addInitializer(PreInitArray, readPointer(file, shdr->virtualAddress() + offset));
+    }
+    if (file->dynamicSection()) {
+        if (const auto init = file->dynamicSection()->entryWithTag(DT_INIT))
+            addInitializer(Init, init->pointer());
+    }
+    foreach (auto shdr, file->sectionHeaders()) {
+        if (shdr->type() != SHT_INIT_ARRAY)
+            continue;
+        for (uint64_t offset = 0; offset < shdr->size(); offset += file->addressSize())
+            addInitializer(InitArray, readPointer(file, shdr->virtualAddress() + offset));
+    }
+    // legacy .ctors is run backwards, by code in DT_INIT
+    foreach (auto shdr, file->sectionHeaders()) {
+        if (shdr->type() != SHT_PROGBITS || strcmp(shdr->name(), ".ctors") != 0 || shdr->size() < (uint64_t)file->addressSize())
+            continue;
+        for (uint64_t offset = shdr->size() - file->addressSize(); offset > 0; offset -= file->addressSize())
+            addInitializer(Ctors, readPointer(file, shdr->virtualAddress() + offset));
+    }
+
+    return result;
+}
+
+void StaticInitializerCheck::analyzeCode(ElfFile* file, const InstructionDecoder& decoder, Initializer& init) const
+{
+    if (!decoder.isValid())
+        return;
+
+    // calls into the PLT leave this file
+    QVector<std::pair<uint64_t, uint64_t>> pltRanges;
+    foreach (auto shdr, file->sectionHeaders()) {
+        if (strncmp(shdr->name(), ".plt", 4) == 0 || strcmp(shdr->name(), ".iplt") == 0)
+            pltRanges.push_back(std::make_pair(shdr->virtualAddress(), shdr->virtualAddress() + shdr->size()));
+    }
+    const auto isPlt = [&pltRanges](uint64_t addr) {
+        return std::any_of(pltRanges.constBegin(), pltRanges.constEnd(), [addr](const std::pair<uint64_t, uint64_t> &range) {
+            return range.first <= addr && addr < range.second;
+        });
+    };
+
+    init.instructions = 0;
+    QSet<uint64_t> visited;
+    QSet<uint64_t> pages;
+    QVector<uint64_t> pending({ init.address });
+    while (!pending.isEmpty() && visited.size() < MaxFunctions) {
+        const auto funcAddr = pending.takeLast();
+        if (visited.contains(funcAddr))
+            continue;
+        visited.insert(funcAddr);
+
+        const unsigned char *data = nullptr;
+        size_t size = 0;
+        const auto sym = functionSymbol(file, funcAddr);
+        const bool bounded = sym && sym->size() > 0 && sym->sectionHeader()->type() != SHT_NOBITS;
+        if (bounded) {
+            data = sym->data();
+            size = sym->size();
+        } else {
+            const auto sectionIndex = file->indexOfSectionWithVirtualAddress(funcAddr);
+            if (sectionIndex < 0)
+                continue;
+            const auto section = file->section<ElfSection>(sectionIndex);
+            if (!section || section->header()->type() == SHT_NOBITS)
+                continue;
+            const auto offset = funcAddr - section->header()->virtualAddress();
+            data = section->rawData() + offset;
+            size = std::min(section->size() - offset, MaxUnboundedSize);
+        }
+        const auto funcEnd = funcAddr + size;
+        ++init.functions;
+
+        auto address = funcAddr;
+        InstructionDecoder::Instruction insn;
+        while (size > 0 && decoder.decode(&data, &size, &address, &insn)) {
+            ++init.instructions;
+            pages.insert(insn.address / m_pageSize);
+            if (insn.dataTarget)
+                pages.insert(insn.dataTarget / m_pageSize);
+
+            // jumps leaving the function are tail calls
+            const auto target = insn.branchTarget;
+            const bool isTailCall = insn.isJump && target && bounded && (target < funcAddr || target >= funcEnd);
+            if (insn.isCall || isTailCall) {
+                ++init.calls;
+                if (target && isPlt(target))
+                    ++init.externalCalls;
+                else if (target)
+                    pending.push_back(target);
+            }
+
+            if (!bounded && insn.isReturn)
+                break;
+        }
+    }
+    init.pages = pages.size();
+}
+
+static double median(QVector<double> data)
+{
+    if (data.isEmpty())
+        return -1.0;
+    std::sort(data.begin(), data.end());
+    return data.at(data.size() / 2);
+}
+
+void StaticInitializerCheck::measure(QVector<Result>& results, int iterations) const
+{
+    const auto runner = LDBenchmark::runnerPath();
+    if (runner.isEmpty())
+        return;
+
+    QStringList files;
+    for (int i = m_fileSet->size() - 1; i >= 0; --i) {
+        if (!m_fileSet->file(i)->isExecutable())
+            files.push_back(m_fileSet->file(i)->fileName());
+    }
+
+    for (auto &result : results) {
+        if (result.initializers.isEmpty() || result.file->isExecutable())
+            continue;
+
+        QStringList args;
+        args << QStringLiteral("CALL") << files << QStringLiteral("--") << result.file->fileName();
+        foreach (const auto &init, result.initializers)
+            args.push_back(QString::number(init.address, 16));
+
+        QHash<QByteArray, QVector<double>> times;
+        for (int i = 0; i < iterations; ++i) {
+            QProcess proc;
+            proc.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            proc.start(runner, args);
+            proc.waitForFinished(-1);
+            while (proc.canReadLine()) {
+                const auto line = proc.readLine();
+                if (!line.startsWith("LDBENCHMARKCALL\t"))
+                    continue;
+                // tag, file name, address, time in µs
+                const auto fields = line.trimmed().split('\t');
+                if (fields.size() == 4)
+                    times[fields.at(2)].push_back(fields.at(3).toDouble());
+            }
+        }
+
+        for (auto &init : result.initializers)
+            init.runtime = median(times.value(QByteArray::number(qulonglong(init.address), 16)));
+    }
+}
+
+/** Measured runtime if available for both, estimated instructions otherwise. */
+static bool isMoreExpensive(const StaticInitializerCheck::Initializer &lhs, const StaticInitializerCheck::Initializer &rhs)
+{
+    if (lhs.runtime >= 0.0 && rhs.runtime >= 0.0)
+        return lhs.runtime > rhs.runtime;
+    if (lhs.instructions != rhs.instructions)
+        return lhs.instructions > rhs.instructions;
+    return lhs.pages > rhs.pages;
+}
+
+static void printInitializer(const StaticInitializerCheck::Initializer &init)
+{
+    std::cout << StaticInitializerCheck::kindName(init.kind) << " " << init.name().constData();
+    if (!init.compilationUnit.isEmpty())
+        std::cout << " [" << init.compilationUnit.constData() << "]";
+    std::cout << ": ";
+    if (init.instructions >= 0) {
+        std::cout << init.instructions << " instructions in " << init.functions << " functions, " << init.calls
+                  << " calls (" << init.externalCalls << " external), " << init.pages << " pages";
+    } else {
+        std::cout << "not disassembled";
+    }
+    if (init.runtime >= 0.0)
+        std::cout << ", " << init.runtime << " µs";
+    std::cout << std::endl;
+}
+
+void StaticInitializerCheck::printReport(const QVector<Result>& results, int limit)
+{
+    QVector<std::pair<ElfFile*, Initializer>> all;
+    foreach (const auto &result, results) {
+        if (result.initializers.isEmpty())
+            continue;
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.initializers.size() << " initializers, "
+                  << result.instructions() << " instructions";
+        if (result.runtime() >= 0.0)
+            std::cout << ", " << result.runtime() << " µs";
+        std::cout << std::endl;
+
+        auto inits = result.initializers;
+        std::stable_sort(inits.begin(), inits.end(), isMoreExpensive);
+        for (int i = 0; i < inits.size() && (limit <= 0 || i < limit); ++i) {
+            std::cout << "  ";
+            printInitializer(inits.at(i));
+        }
+        foreach (const auto &init, result.initializers)
+            all.push_back(std::make_pair(result.file, init));
+    }
+
+    std::stable_sort(all.begin(), all.end(), [](const std::pair<ElfFile*, Initializer> &lhs, const std::pair<ElfFile*, Initializer> &rhs) {
+        return isMoreExpensive(lhs.second, rhs.second);
+    });
+    std::cout << std::endl << "Most expensive initializers across the load order:" << std::endl;
+    for (int i = 0; i < all.size() && (limit <= 0 || i < limit); ++i) {
+        std::cout << "  " << qPrintable(all.at(i).first->displayName()) << ": ";
+        printInitializer(all.at(i).second);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATICINITIALIZERCHECK_H
+#define STATICINITIALIZERCHECK_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+class InstructionDecoder;
+
+/** Enumerates the code run during loading: static constructors from .preinit_array, DT_INIT, .init_array
+ *  and .ctors, as well as IFUNC resolvers called for IRELATIVE relocations. Estimates their cost by
+ *  disassembling them and the functions they call directly, and can optionally time them at runtime.
+ */
+class StaticInitializerCheck
+{
+public:
+    explicit StaticInitializerCheck(ElfFileSet *fileSet);
+    StaticInitializerCheck(const StaticInitializerCheck&) = default;
+    ~StaticInitializerCheck() = default;
+
+    StaticInitializerCheck& operator=(const StaticInitializerCheck&) = default;
+
+    /** Page size in bytes, 4096 by default. */
+    void setPageSize(uint64_t pageSize);
+
+    enum Kind {
+        PreInitArray,
+        Init,
+        InitArray,
+        Ctors,
+        IfuncResolver
+    };
+
+    struct Initializer {
+        Kind kind = InitArray;
+        uint64_t address = 0;
+        /** Function symbol at address, @c nullptr for stripped files. */
+        ElfSymbolTableEntry *symbol = nullptr;
+        /** Source file of the compilation unit, if debug information is available. */
+        QByteArray compilationUnit;
+        /** Instructions of this function and the functions it calls directly inside the same file,
+         *  -1 if that could not be determined.
+         */
+        int instructions = -1;
+        /** Functions reached that way, including this one. */
+        int functions = 0;
+        /** Call instructions, and those into the PLT. */
+        int calls = 0;
+        int externalCalls = 0;
+        /** Code and data pages referenced by the reached code. */
+        int pages = 0;
+        /** Median runtime in µs as measured by measure(), -1 if not measured. */
+        double runtime = -1.0;
+
+        /** Demangled symbol name, or the address if there is no symbol. */
+        QByteArray name() const;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        /** Initializers in execution order, IFUNC resolvers first as those run during relocation. */
+        QVector<Initializer> initializers;
+
+        int instructions() const;
+        double runtime() const;
+    };
+
+    /** Analyze all files of the set, in load order (dependencies first). */
+    QVector<Result> analyze() const;
+
+    /** Time each initializer of the libraries in @p results by calling it again @p iterations times in a
+     *  benchmark runner child process, after loading the file set. Initializers are not necessarily safe to
+     *  be run twice, the affected runs will be missing then. Executables can't be loaded this way.
+     */
+    void measure(QVector<Result> &results, int iterations) const;
+
+    /** Dump per-file and global rankings of the @p limit most expensive initializers to stdout. */
+    static void printReport(const QVector<Result> &results, int limit);
+
+    static const char* kindName(Kind kind);
+
+private:
+    Result analyzeFile(ElfFile *file) const;
+    void analyzeCode(ElfFile *file, const InstructionDecoder &decoder, Initializer &init) const;
+
+    ElfFileSet *m_fileSet;
+    uint64_t m_pageSize = 4096;
+};
+
+#endif // STATICINITIALIZERCHECK_H
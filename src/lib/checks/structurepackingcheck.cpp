@@ -89,12 +89,10 @@ static bool compareMemberDiesByLocation(DwarfDie *lhs, DwarfDie *rhs)
 }
 #endif
 
-QString StructurePackingCheck::checkOneStructure(DwarfDie* structDie) const
+QVector<DwarfDie*> StructurePackingCheck::structureMembers(DwarfDie* structDie)
 {
-#if HAVE_DWARF
-    assert(structDie->tag() == DW_TAG_class_type || structDie->tag() == DW_TAG_structure_type);
-
     QVector<DwarfDie*> members;
+#if HAVE_DWARF
     foreach (auto child, structDie->children()) {
         if (child->tag() == DW_TAG_member && !child->isStaticMember())
             members.push_back(child);
@@ -102,7 +100,28 @@ QString StructurePackingCheck::checkOneStructure(DwarfDie* structDie) const
             members.push_back(child);
     }
     std::sort(members.begin(), members.end(), compareMemberDiesByLocation);
+#else
+    Q_UNUSED(structDie);
+#endif
+    return members;
+}
 
+int StructurePackingCheck::memberLocation(DwarfDie* memberDie)
+{
+#if HAVE_DWARF
+    return dataMemberLocation(memberDie);
+#else
+    Q_UNUSED(memberDie);
+    return 0;
+#endif
+}
+
+QString StructurePackingCheck::checkOneStructure(DwarfDie* structDie) const
+{
+#if HAVE_DWARF
+    assert(structDie->tag() == DW_TAG_class_type || structDie->tag() == DW_TAG_structure_type);
+
+    const auto members = structureMembers(structDie);
     const int structSize = structDie->typeSize();
     int usedBytes;
     int usedBits;
@@ -380,6 +399,11 @@ static bool isEmptyBaseClass(DwarfDie* inheritanceDie)
     return true;
 }
 
+int StructurePackingCheck::optimalStructureSize(DwarfDie* structDie) const
+{
+    return optimalStructureSize(structDie, structureMembers(structDie));
+}
+
 int StructurePackingCheck::optimalStructureSize(DwarfDie* structDie, const QVector< DwarfDie* >& memberDies) const
 {
     int size = 0;
@@ -42,13 +42,20 @@ public:
     void checkAll(DwarfInfo* info);
     QString checkOneStructure(DwarfDie *structDie) const;
 
+    /** Returns the non-static data members and base classes of @p structDie, sorted by their location. */
+    static QVector<DwarfDie*> structureMembers(DwarfDie *structDie);
+    /** Returns the byte offset of @p memberDie inside its parent structure. */
+    static int memberLocation(DwarfDie *memberDie);
+    /** Look for a better type DIE for the given external one (@p typeDie). */
+    DwarfDie* findTypeDefinition(DwarfDie *typeDie) const;
+    /** Returns the size of @p structDie with its members in optimal order. */
+    int optimalStructureSize(DwarfDie *structDie) const;
+
 private:
     void checkDie(DwarfDie* die);
     std::tuple<int, int> computeStructureMemoryUsage(DwarfDie* structDie, const QVector<DwarfDie*> &memberDies) const;
     QString printStructure(DwarfDie* structDie, const QVector< DwarfDie* >& memberDies) const;
     int optimalStructureSize(DwarfDie* structDie, const QVector<DwarfDie*> &memberDies) const;
-    /** Look for a better type DIE for the given external one (@p typeDie). */
-    DwarfDie* findTypeDefinition(DwarfDie *typeDie) const;
 
     ElfFileSet *m_fileSet = nullptr;
     QSet<QString> m_duplicateCheck;
@@ -0,0 +1,194 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "symbolbindingtrace.h"
+#include "ldbenchmark.h"
+
+#include <demangle/demangler.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QSet>
+
+#include <algorithm>
+#include <iostream>
+
+#include <elf.h>
+
+int SymbolBindingTrace::record(const QString& traceFile, const QString& command, const QStringList& arguments)
+{
+    const auto module = LDBenchmark::auditModulePath();
+    if (module.isEmpty())
+        return -1;
+
+    auto env = QProcessEnvironment::systemEnvironment();
+    env.insert(QStringLiteral("LD_AUDIT"), module);
+    env.insert(QStringLiteral("LDBENCHMARK_SYMBIND_TRACE"), QFileInfo(traceFile).absoluteFilePath());
+    // lazy binding is what we want to observe
+    env.remove(QStringLiteral("LD_BIND_NOW"));
+
+    QProcess proc;
+    proc.setProcessChannelMode(QProcess::ForwardedChannels);
+    proc.setInputChannelMode(QProcess::ForwardedInputChannel);
+    proc.setProcessEnvironment(env);
+    proc.start(command, arguments);
+    if (!proc.waitForStarted()) {
+        qWarning() << "Failed to run" << command << ":" << proc.errorString();
+        return -1;
+    }
+    proc.waitForFinished(-1);
+    if (proc.exitStatus() == QProcess::CrashExit)
+        return -1;
+    return proc.exitCode();
+}
+
+bool SymbolBindingTrace::load(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "Failed to open" << fileName << ":" << file.errorString();
+        return false;
+    }
+
+    m_bindings.clear();
+    m_fileSet = nullptr;
+    QHash<QByteArray, int> index;
+    while (!file.atEnd()) {
+        const auto line = file.readLine();
+        const auto fields = line.trimmed().split('\t');
+        if (fields.size() != 3) {
+            qWarning() << "Ignoring invalid line:" << line;
+            continue;
+        }
+        const auto key = line.trimmed();
+        const auto it = index.constFind(key);
+        if (it != index.constEnd()) {
+            ++m_bindings[it.value()].count;
+            continue;
+        }
+        Binding binding;
+        binding.requester = fields.at(0);
+        binding.provider = fields.at(1);
+        binding.symbol = fields.at(2);
+        binding.count = 1;
+        index.insert(key, m_bindings.size());
+        m_bindings.push_back(binding);
+    }
+
+    std::sort(m_bindings.begin(), m_bindings.end(), [](const Binding &lhs, const Binding &rhs) {
+        return lhs.count > rhs.count;
+    });
+    return true;
+}
+
+void SymbolBindingTrace::resolve(ElfFileSet* fileSet)
+{
+    m_fileSet = fileSet;
+    QHash<QString, ElfFile*> files;
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto file = fileSet->file(i);
+        files.insert(QFileInfo(file->fileName()).canonicalFilePath(), file);
+    }
+
+    QHash<QByteArray, ElfFile*> pathCache;
+    const auto lookupFile = [&files, &pathCache](const QByteArray &path) {
+        const auto it = pathCache.constFind(path);
+        if (it != pathCache.constEnd())
+            return it.value();
+        const auto file = files.value(QFileInfo(QString::fromUtf8(path)).canonicalFilePath());
+        pathCache.insert(path, file);
+        return file;
+    };
+
+    for (auto &binding : m_bindings) {
+        binding.requesterFile = lookupFile(binding.requester);
+        binding.providerFile = lookupFile(binding.provider);
+        binding.definition = nullptr;
+        if (binding.providerFile && binding.providerFile->hash())
+            binding.definition = binding.providerFile->hash()->lookup(binding.symbol.constData());
+    }
+}
+
+QVector<SymbolBindingTrace::Binding> SymbolBindingTrace::bindings() const
+{
+    return m_bindings;
+}
+
+static QByteArray displayName(ElfFile *file, const QByteArray &path)
+{
+    if (file)
+        return file->displayName().toUtf8();
+    return path;
+}
+
+void SymbolBindingTrace::printReport(int limit) const
+{
+    int total = 0;
+    int unresolved = 0;
+    foreach (const auto &binding, m_bindings) {
+        total += binding.count;
+        if (m_fileSet && !binding.definition)
+            ++unresolved;
+    }
+    std::cout << total << " bindings of " << m_bindings.size() << " distinct symbols" << std::endl;
+
+    for (int i = 0; i < m_bindings.size() && (limit <= 0 || i < limit); ++i) {
+        const auto &binding = m_bindings.at(i);
+        std::cout << "  " << binding.count << "x " << Demangler::demangleFull(binding.symbol.constData()).constData() << ": "
+                  << displayName(binding.requesterFile, binding.requester).constData() << " -> "
+                  << displayName(binding.providerFile, binding.provider).constData();
+        if (m_fileSet && !binding.definition)
+            std::cout << " (definition not found)";
+        std::cout << std::endl;
+    }
+
+    if (!m_fileSet)
+        return;
+    if (unresolved > 0)
+        std::cout << unresolved << " bindings could not be matched to a definition in the file set." << std::endl;
+
+    // imported functions actually used, compared to all imported functions
+    QHash<ElfFile*, QSet<QByteArray>> boundSymbols;
+    foreach (const auto &binding, m_bindings) {
+        if (binding.requesterFile)
+            boundSymbols[binding.requesterFile].insert(binding.symbol);
+    }
+    std::cout << std::endl << "Imported functions bound at runtime:" << std::endl;
+    for (int i = 0; i < m_fileSet->size(); ++i) {
+        const auto file = m_fileSet->file(i);
+        const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+        if (!symTab)
+            continue;
+        int imports = 0;
+        for (uint32_t j = 1; j < symTab->header()->entryCount(); ++j) {
+            const auto entry = symTab->entry(j);
+            if (entry->sectionIndex() == SHN_UNDEF && (entry->type() == STT_FUNC || entry->type() == STT_GNU_IFUNC))
+                ++imports;
+        }
+        std::cout << "  " << qPrintable(file->displayName()) << ": " << boundSymbols.value(file).size() << " of "
+                  << imports << std::endl;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SYMBOLBINDINGTRACE_H
+#define SYMBOLBINDINGTRACE_H
+
+#include <QByteArray>
+#include <QVector>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+
+class QString;
+class QStringList;
+
+/** PLT symbol bindings observed at runtime by the ldbenchmark-audit LD_AUDIT module.
+ *  The trace file has one "<requester>\t<provider>\t<symbol>" line per binding, traces of
+ *  several runs can simply be concatenated.
+ */
+class SymbolBindingTrace
+{
+public:
+    SymbolBindingTrace() = default;
+    SymbolBindingTrace(const SymbolBindingTrace&) = default;
+    ~SymbolBindingTrace() = default;
+
+    SymbolBindingTrace& operator=(const SymbolBindingTrace&) = default;
+
+    /** Run @p command with @p arguments, appending its bindings and those of its child processes to @p traceFile.
+     *  Returns the exit code of @p command, or -1 if it could not be run.
+     */
+    static int record(const QString &traceFile, const QString &command, const QStringList &arguments);
+
+    /** Load and aggregate the trace in @p fileName, replacing previous data. */
+    bool load(const QString &fileName);
+
+    /** Match requesters and providers to the files of @p fileSet, and look up the bound definitions. */
+    void resolve(ElfFileSet *fileSet);
+
+    struct Binding {
+        QByteArray requester;
+        QByteArray provider;
+        QByteArray symbol;
+        /** Number of times this binding was done, ie. in how many processes. */
+        int count = 0;
+        ElfFile *requesterFile = nullptr;
+        ElfFile *providerFile = nullptr;
+        ElfSymbolTableEntry *definition = nullptr;
+    };
+
+    /** All bindings, most frequent first. */
+    QVector<Binding> bindings() const;
+
+    /** Dump the @p limit most frequent bindings (all for 0) and the PLT usage per requester to stdout. */
+    void printReport(int limit) const;
+
+private:
+    QVector<Binding> m_bindings;
+    ElfFileSet *m_fileSet = nullptr;
+};
+
+#endif // SYMBOLBINDINGTRACE_H
@@ -0,0 +1,377 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "symbollookupsimulator.h"
+
+#include <elf/elffileset.h>
+#include <elf/elffile.h>
+#include <elf/elfheader.h>
+#include <elf/elfgnusymbolversiondefinition.h>
+#include <elf/elfgnusymbolversiondefinitionauxiliaryentry.h>
+#include <elf/elfgnusymbolversiondefinitionssection.h>
+#include <elf/elfgnusymbolversionrequirementauxiliaryentry.h>
+#include <elf/elfgnusymbolversionrequirementssection.h>
+#include <elf/elfgnusymbolversiontable.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsymboltablesection.h>
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include <elf.h>
+
+SymbolLookupSimulator::SymbolLookupSimulator(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+    m_scope = scopeOrder(fileSet, {});
+}
+
+QVector<int> SymbolLookupSimulator::scopeOrder(ElfFileSet *fileSet, const QHash<int, QVector<QByteArray>> &neededLibraries)
+{
+    QVector<int> scope;
+    if (fileSet->size() == 0)
+        return scope;
+
+    QHash<QByteArray, int> fileIndex;
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto file = fileSet->file(i);
+        fileIndex.insert(file->fileName().toUtf8(), i);
+        if (file->dynamicSection() && !file->dynamicSection()->soName().isEmpty())
+            fileIndex.insert(file->dynamicSection()->soName(), i);
+    }
+
+    // ld.so adds dependencies to the global scope in breadth-first order
+    QVector<bool> visited(fileSet->size(), false);
+    scope.push_back(0);
+    visited[0] = true;
+    for (int i = 0; i < scope.size(); ++i) {
+        const auto file = fileSet->file(scope.at(i));
+        if (!file->dynamicSection())
+            continue;
+        const auto needed = neededLibraries.contains(scope.at(i)) ? neededLibraries.value(scope.at(i)) : file->dynamicSection()->neededLibraries();
+        foreach (const auto &lib, needed) {
+            const auto idx = fileIndex.value(lib, -1);
+            if (idx < 0 || visited.at(idx))
+                continue;
+            visited[idx] = true;
+            scope.push_back(idx);
+        }
+    }
+    return scope;
+}
+
+QVector<int> SymbolLookupSimulator::scopeOrder() const
+{
+    return m_scope;
+}
+
+void SymbolLookupSimulator::setScopeOrder(const QVector<int>& order)
+{
+    m_scope = order;
+}
+
+void SymbolLookupSimulator::hideSymbols(int fileIndex, const QSet<QByteArray>& symbols)
+{
+    m_hiddenSymbols[fileIndex] += symbols;
+}
+
+void SymbolLookupSimulator::setSymbolicBinding(int fileIndex, SymbolicBinding binding)
+{
+    m_symbolicBinding[fileIndex] = binding;
+}
+
+void SymbolLookupSimulator::simulate(BindingMode mode)
+{
+    m_requesterStats.fill(Statistics(), m_fileSet->size());
+    m_providerStats.fill(Statistics(), m_fileSet->size());
+
+    foreach (auto fileIndex, m_scope)
+        resolveRelocations(fileIndex, mode);
+}
+
+static bool isCopyRelocation(uint16_t machine, uint32_t type)
+{
+    switch (machine) {
+        case EM_386:
+            return type == R_386_COPY;
+        case EM_X86_64:
+            return type == R_X86_64_COPY;
+        case EM_ARM:
+            return type == R_ARM_COPY;
+        case EM_AARCH64:
+            return type == R_AARCH64_COPY;
+        case EM_PPC:
+            return type == R_PPC_COPY;
+        case EM_PPC64:
+            return type == R_PPC64_COPY;
+        case EM_MIPS:
+            return type == R_MIPS_COPY;
+    }
+    return false;
+}
+
+static bool hasBindNow(ElfFile *file)
+{
+    if (file->dynamicSection()->entryWithTag(DT_BIND_NOW))
+        return true;
+    const auto flags = file->dynamicSection()->entryWithTag(DT_FLAGS);
+    if (flags && (flags->value() & DF_BIND_NOW))
+        return true;
+    const auto flags1 = file->dynamicSection()->entryWithTag(DT_FLAGS_1);
+    return flags1 && (flags1->value() & DF_1_NOW);
+}
+
+void SymbolLookupSimulator::resolveRelocations(int fileIndex, BindingMode mode)
+{
+    const auto file = m_fileSet->file(fileIndex);
+    if (!file->dynamicSection())
+        return;
+
+    const auto jmpRelEntry = file->dynamicSection()->entryWithTag(DT_JMPREL);
+    const auto jmpRel = jmpRelEntry ? jmpRelEntry->value() : 0;
+    const bool lazy = mode == Lazy && !hasBindNow(file);
+    const auto binding = m_symbolicBinding.value(fileIndex, NoSymbolicBinding);
+    auto &stats = m_requesterStats[fileIndex];
+
+    // ld.so caches the result of the last lookup per object, see RESOLVE_MAP in dl-reloc.c
+    enum TypeClass { NoClass, DataClass, PltClass, CopyClass };
+    uint32_t cachedSymbol = 0;
+    TypeClass cachedClass = NoClass;
+
+    foreach (const auto shdr, file->sectionHeaders()) {
+        if ((shdr->type() != SHT_REL && shdr->type() != SHT_RELA) || !(shdr->flags() & SHF_ALLOC))
+            continue;
+        const auto relocs = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocs)
+            continue;
+        const bool isPlt = jmpRel != 0 && shdr->virtualAddress() == jmpRel;
+
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto reloc = relocs->entry(i);
+            const auto sym = reloc->symbol();
+            if (!sym)
+                continue;
+            // these are resolved without a lookup
+            if (sym->bindType() == STB_LOCAL || sym->visibility() != STV_DEFAULT)
+                continue;
+            // the linker would have bound these already, and turned PLT slots into direct calls
+            if (binding != NoSymbolicBinding && sym->hasValidSection()
+                && (binding == Symbolic || sym->type() == STT_FUNC || sym->type() == STT_GNU_IFUNC))
+                continue;
+            if (isPlt && lazy) {
+                ++stats.deferredLookups;
+                continue;
+            }
+
+            const auto typeClass = isPlt ? PltClass : isCopyRelocation(file->header()->machine(), reloc->type()) ? CopyClass : DataClass;
+            if (reloc->symbolIndex() == cachedSymbol && typeClass == cachedClass) {
+                ++stats.cachedLookups;
+                continue;
+            }
+            cachedSymbol = reloc->symbolIndex();
+            cachedClass = typeClass;
+
+            // copy relocations must not find the copy in the executable itself
+            lookup(sym->name(), fileIndex, typeClass == CopyClass ? fileIndex : -1, typeClass == PltClass);
+        }
+    }
+}
+
+void SymbolLookupSimulator::lookup(const char* name, int requesterIndex, int skipIndex, bool pltLookup)
+{
+    auto &requester = m_requesterStats[requesterIndex];
+    ++requester.lookups;
+
+    foreach (auto providerIndex, m_scope) {
+        if (providerIndex == skipIndex)
+            continue;
+        const auto hash = m_fileSet->file(providerIndex)->hash();
+        if (!hash)
+            continue;
+
+        // hidden symbols are skipped during the walk, as if they were removed from the table
+        ElfHashSection::LookupStatistics lookupStats;
+        const auto hidden = m_hiddenSymbols.constFind(providerIndex);
+        const auto entry = hash->lookup(name, &lookupStats, hidden != m_hiddenSymbols.constEnd() ? &hidden.value() : nullptr, pltLookup);
+
+        for (auto stats : { &requester, &m_providerStats[providerIndex] }) {
+            stats->bloomProbes += lookupStats.bloomProbes;
+            stats->bloomFalsePositives += lookupStats.bloomFalsePositives;
+            stats->chainWalks += lookupStats.chainWalks;
+            stats->strcmpCalls += lookupStats.strcmpCalls;
+            stats->bytesCompared += lookupStats.bytesCompared;
+        }
+
+        if (entry)
+            return;
+    }
+
+    ++requester.failedLookups;
+}
+
+static ElfGNUSymbolVersionTable* versionTable(ElfFile *file)
+{
+    const auto index = file->indexOfSection(SHT_GNU_versym);
+    return index > 0 ? file->section<ElfGNUSymbolVersionTable>(index) : nullptr;
+}
+
+static QByteArray definedVersion(ElfFile *file, uint16_t versionIndex)
+{
+    const auto index = file->indexOfSection(SHT_GNU_verdef);
+    const auto verDefs = index > 0 ? file->section<ElfGNUSymbolVersionDefinitionsSection>(index) : nullptr;
+    const auto verDef = verDefs ? verDefs->definitionForVersionIndex(versionIndex) : nullptr;
+    return verDef && verDef->auxiliarySize() > 0 ? QByteArray(verDef->auxiliaryEntry(0)->name()) : QByteArray();
+}
+
+QByteArray SymbolLookupSimulator::symbolVersion(ElfFile* file, uint32_t index)
+{
+    const auto verSym = versionTable(file);
+    if (!verSym)
+        return QByteArray();
+    const auto versionIndex = verSym->versionIndex(index);
+    if (versionIndex <= VER_NDX_GLOBAL)
+        return QByteArray();
+
+    const auto verNeedIndex = file->indexOfSection(SHT_GNU_verneed);
+    const auto verNeeds = verNeedIndex > 0 ? file->section<ElfGNUSymbolVersionRequirementsSection>(verNeedIndex) : nullptr;
+    if (const auto verNeed = verNeeds ? verNeeds->requirementForVersionIndex(versionIndex) : nullptr)
+        return verNeed->name();
+    return definedVersion(file, versionIndex);
+}
+
+// see check_match() in glibc's dl-lookup.c
+static bool matchesVersion(ElfFile *file, ElfGNUSymbolVersionTable *verSym, ElfSymbolTableEntry *entry, const QByteArray &version)
+{
+    const auto versionIndex = verSym->versionIndex(entry->index());
+    if (version.isEmpty())
+        return versionIndex <= VER_NDX_GLOBAL + 1;
+    // the requested version, or an unversioned definition
+    if (versionIndex <= VER_NDX_GLOBAL)
+        return !verSym->isHidden(entry->index());
+    return definedVersion(file, versionIndex) == version;
+}
+
+ElfSymbolTableEntry* SymbolLookupSimulator::lookupDefinition(const char* name, const QByteArray& version, int* providerIndex, bool pltLookup) const
+{
+    foreach (auto index, m_scope) {
+        const auto file = m_fileSet->file(index);
+        const auto hash = file->hash();
+        if (!hash)
+            continue;
+        const auto hidden = m_hiddenSymbols.constFind(index);
+        auto entry = hash->lookup(name, nullptr, hidden != m_hiddenSymbols.constEnd() ? &hidden.value() : nullptr, pltLookup);
+        if (!entry)
+            continue;
+
+        const auto verSym = versionTable(file);
+        if (verSym && !matchesVersion(file, verSym, entry, version)) {
+            // the hash table lookup stops at the first definition, further ones differ in their version
+            const auto symTab = entry->symbolTable();
+            ElfSymbolTableEntry *match = nullptr;
+            ElfSymbolTableEntry *onlyVersioned = nullptr;
+            int versionedCount = 0;
+            for (uint32_t i = 1; i < symTab->header()->entryCount() && !match; ++i) {
+                const auto candidate = symTab->entry(i);
+                if (strcmp(candidate->name(), name) != 0 || !ElfHashSection::isDefinition(candidate, pltLookup)
+                    || !ElfHashSection::isGlobalDefinition(candidate))
+                    continue;
+                if (matchesVersion(file, verSym, candidate, version)) {
+                    match = candidate;
+                } else if (version.isEmpty() && !verSym->isHidden(i)) {
+                    onlyVersioned = candidate;
+                    ++versionedCount;
+                }
+            }
+            // unversioned references bind to a single non-hidden versioned definition
+            entry = match ? match : versionedCount == 1 ? onlyVersioned : nullptr;
+            if (!entry)
+                continue;
+        }
+
+        if (providerIndex)
+            *providerIndex = index;
+        return entry;
+    }
+    return nullptr;
+}
+
+SymbolLookupSimulator::Statistics SymbolLookupSimulator::requesterStatistics(int fileIndex) const
+{
+    return m_requesterStats.value(fileIndex);
+}
+
+SymbolLookupSimulator::Statistics SymbolLookupSimulator::providerStatistics(int fileIndex) const
+{
+    return m_providerStats.value(fileIndex);
+}
+
+SymbolLookupSimulator::Statistics SymbolLookupSimulator::totalStatistics() const
+{
+    Statistics total;
+    for (const auto &stats : m_requesterStats) {
+        total.lookups += stats.lookups;
+        total.cachedLookups += stats.cachedLookups;
+        total.deferredLookups += stats.deferredLookups;
+        total.failedLookups += stats.failedLookups;
+        total.bloomProbes += stats.bloomProbes;
+        total.bloomFalsePositives += stats.bloomFalsePositives;
+        total.chainWalks += stats.chainWalks;
+        total.strcmpCalls += stats.strcmpCalls;
+        total.bytesCompared += stats.bytesCompared;
+    }
+    return total;
+}
+
+static void printStatistics(const SymbolLookupSimulator::Statistics &stats, bool isRequester)
+{
+    if (isRequester) {
+        std::cout << "lookups: " << stats.lookups << ", cached: " << stats.cachedLookups
+                  << ", deferred: " << stats.deferredLookups << ", failed: " << stats.failedLookups << ", ";
+    }
+    std::cout << "bloom probes: " << stats.bloomProbes << ", bloom false positives: " << stats.bloomFalsePositives
+              << ", chain walks: " << stats.chainWalks << ", strcmp calls: " << stats.strcmpCalls
+              << ", bytes compared: " << stats.bytesCompared << std::endl;
+}
+
+void SymbolLookupSimulator::printReport() const
+{
+    std::cout << "Lookup scope:";
+    foreach (auto fileIndex, m_scope)
+        std::cout << " " << qPrintable(m_fileSet->file(fileIndex)->displayName());
+    std::cout << std::endl << std::endl;
+
+    std::cout << "Cost of resolving the relocations of:" << std::endl;
+    foreach (auto fileIndex, m_scope) {
+        std::cout << "  " << qPrintable(m_fileSet->file(fileIndex)->displayName()) << ": ";
+        printStatistics(m_requesterStats.value(fileIndex), true);
+    }
+    std::cout << std::endl;
+
+    std::cout << "Cost of searching in:" << std::endl;
+    foreach (auto fileIndex, m_scope) {
+        std::cout << "  " << qPrintable(m_fileSet->file(fileIndex)->displayName()) << ": ";
+        printStatistics(m_providerStats.value(fileIndex), false);
+    }
+    std::cout << std::endl;
+
+    std::cout << "Total: ";
+    printStatistics(totalStatistics(), true);
+}
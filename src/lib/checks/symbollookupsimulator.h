@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SYMBOLLOOKUPSIMULATOR_H
+#define SYMBOLLOOKUPSIMULATOR_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFileSet;
+class ElfFile;
+class ElfSymbolTableEntry;
+
+/** Replays the symbol resolution done by the dynamic linker for all files in an ElfFileSet.
+ *  Nothing is executed, the cost of symbol lookups is determined by walking the hash tables
+ *  the same way ld.so does, so this also works for foreign architectures or sysroots, and
+ *  allows to evaluate changes like a different lookup scope order or fewer exported symbols.
+ */
+class SymbolLookupSimulator
+{
+public:
+    explicit SymbolLookupSimulator(ElfFileSet *fileSet);
+    SymbolLookupSimulator(const SymbolLookupSimulator&) = default;
+    ~SymbolLookupSimulator() = default;
+
+    SymbolLookupSimulator& operator=(const SymbolLookupSimulator&) = default;
+
+    enum BindingMode {
+        BindNow, ///< all relocations are resolved at load time, as with LD_BIND_NOW or DF_BIND_NOW
+        Lazy ///< PLT slots are resolved on first use, and are therefore not included
+    };
+
+    struct Statistics {
+        uint64_t lookups = 0;
+        /** Lookups avoided by the dynamic linker's cache for consecutive relocations of the same symbol. */
+        uint64_t cachedLookups = 0;
+        /** PLT slots not resolved at load time in lazy binding mode. */
+        uint64_t deferredLookups = 0;
+        /** Lookups not finding any definition, e.g. for weak undefined symbols. */
+        uint64_t failedLookups = 0;
+        uint64_t bloomProbes = 0;
+        uint64_t bloomFalsePositives = 0;
+        uint64_t chainWalks = 0;
+        uint64_t strcmpCalls = 0;
+        uint64_t bytesCompared = 0;
+    };
+
+    /** Global lookup scope, as indexes into the file set.
+     *  Defaults to breadth-first DT_NEEDED order starting at the first file of the set, as ld.so does it.
+     */
+    QVector<int> scopeOrder() const;
+    void setScopeOrder(const QVector<int> &order);
+
+    /** Breadth-first global lookup scope of @p fileSet as ld.so builds it, using @p neededLibraries
+     *  instead of the DT_NEEDED entries for the files with indexes contained in there.
+     */
+    static QVector<int> scopeOrder(ElfFileSet *fileSet, const QHash<int, QVector<QByteArray>> &neededLibraries);
+
+    /** Treat @p symbols as not exported by the file with index @p fileIndex. */
+    void hideSymbols(int fileIndex, const QSet<QByteArray> &symbols);
+
+    enum SymbolicBinding {
+        NoSymbolicBinding, ///< default ELF semantics, all exported symbols are interposable
+        SymbolicFunctions, ///< references to own functions are bound locally, as with -Bsymbolic-functions
+        Symbolic ///< references to all own symbols are bound locally, as with -Bsymbolic
+    };
+    /** Simulate linking file @p fileIndex with @p binding. */
+    void setSymbolicBinding(int fileIndex, SymbolicBinding binding);
+
+    /** Definition a reference to @p name with symbol version @p version binds to, searching the global
+     *  lookup scope and matching symbol versions the way ld.so does. An empty @p version is an unversioned
+     *  reference, binding to the base or oldest version. The index of the providing file is returned in
+     *  @p providerIndex, if not @c nullptr. @p pltLookup is set for resolving PLT slots.
+     */
+    ElfSymbolTableEntry* lookupDefinition(const char *name, const QByteArray &version, int *providerIndex, bool pltLookup = false) const;
+    /** Name of the symbol version entry @p index of the dynamic symbol table of @p file refers to, empty if unversioned. */
+    static QByteArray symbolVersion(ElfFile *file, uint32_t index);
+
+    /** Run the simulation, replacing previous results. */
+    void simulate(BindingMode mode);
+
+    /** Cost of resolving the relocations of file @p fileIndex. */
+    Statistics requesterStatistics(int fileIndex) const;
+    /** Cost of looking up symbols in file @p fileIndex. */
+    Statistics providerStatistics(int fileIndex) const;
+    /** Cost of all lookups. */
+    Statistics totalStatistics() const;
+
+    /** Dump the results of the last simulation to stdout. */
+    void printReport() const;
+
+private:
+    void resolveRelocations(int fileIndex, BindingMode mode);
+    void lookup(const char *name, int requesterIndex, int skipIndex, bool pltLookup);
+
+    ElfFileSet *m_fileSet;
+    QVector<int> m_scope;
+    QHash<int, QSet<QByteArray>> m_hiddenSymbols;
+    QHash<int, SymbolicBinding> m_symbolicBinding;
+    QVector<Statistics> m_requesterStats;
+    QVector<Statistics> m_providerStats;
+};
+
+#endif // SYMBOLLOOKUPSIMULATOR_H
@@ -0,0 +1,274 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "templateduplicationcheck.h"
+
+#include <elf/elffile.h>
+#include <demangle/demangler.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+
+#include <dwarf.h>
+#include <libdwarf.h>
+#endif
+
+#include <QSet>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+quint64 TemplateDuplicationCheck::Function::redundantCompiledSize() const
+{
+    return cuCount > fileCount ? (cuCount - fileCount) * codeSize : 0;
+}
+
+quint64 TemplateDuplicationCheck::Function::redundantLinkedSize() const
+{
+    return fileCount > 1 ? (fileCount - 1) * codeSize : 0;
+}
+
+void TemplateDuplicationCheck::setThreadCount(int threadCount)
+{
+    m_threadCount = threadCount;
+}
+
+#if HAVE_DWARF
+namespace {
+struct WorkerResult {
+    QHash<QByteArray, TemplateDuplicationCheck::Function> functions;
+    int cuCount = 0;
+};
+}
+
+static bool hasTemplateParameters(DwarfDie *die)
+{
+    foreach (auto child, die->children()) {
+        switch (child->tag()) {
+            case DW_TAG_template_type_parameter:
+            case DW_TAG_template_value_parameter:
+            case DW_TAG_GNU_template_parameter_pack:
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool isTemplate(DwarfDie *die)
+{
+    // out-of-line definitions refer to the declaration inside the class via DW_AT_specification
+    for (auto d = die; d; d = d->inheritedFrom()) {
+        if (hasTemplateParameters(d))
+            return true;
+        for (auto parent = d->parentDie(); parent && !parent->isCompilationUnit(); parent = parent->parentDie()) {
+            if (parent->tag() != DW_TAG_namespace && hasTemplateParameters(parent))
+                return true;
+        }
+    }
+    return false;
+}
+
+static quint64 codeSize(DwarfDie *die, bool *hasCode)
+{
+    Dwarf_Addr lowPc = 0;
+    if (dwarf_lowpc(die->dieHandle(), &lowPc, nullptr) != DW_DLV_OK) {
+        // abstract instance of an inline function, or non-contiguous code
+        *hasCode = !die->attribute(DW_AT_inline).isNull() || !die->attribute(DW_AT_ranges).isNull();
+        return 0;
+    }
+    *hasCode = true;
+
+    Dwarf_Addr highPc = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class formClass = DW_FORM_CLASS_UNKNOWN;
+    if (dwarf_highpc_b(die->dieHandle(), &highPc, &form, &formClass, nullptr) != DW_DLV_OK)
+        return 0;
+    // DWARF 4 allows to specify the high PC relative to the low PC
+    if (formClass == DW_FORM_CLASS_CONSTANT)
+        return highPc;
+    return highPc > lowPc ? highPc - lowPc : 0;
+}
+
+static void scanDie(DwarfDie *die, QSet<QByteArray> &cuFunctions, WorkerResult &result)
+{
+    foreach (auto child, die->children()) {
+        switch (child->tag()) {
+            case DW_TAG_subprogram:
+            {
+                bool hasCode = false;
+                const auto size = codeSize(child, &hasCode);
+                if (!hasCode)
+                    break;
+                auto linkageName = child->attribute(DW_AT_linkage_name).toByteArray();
+                if (linkageName.isEmpty())
+                    linkageName = child->attribute(DW_AT_MIPS_linkage_name).toByteArray();
+                if (linkageName.isEmpty())
+                    break;
+
+                auto &function = result.functions[linkageName];
+                if (function.linkageName.isEmpty()) {
+                    function.linkageName = linkageName;
+                    function.name = child->fullyQualifiedName();
+                    function.isTemplate = isTemplate(child);
+                }
+                // abstract and concrete instances can both be present in the same CU
+                if (!cuFunctions.contains(linkageName)) {
+                    cuFunctions.insert(linkageName);
+                    ++function.cuCount;
+                }
+                function.codeSize = std::max(function.codeSize, size);
+                break;
+            }
+            case DW_TAG_namespace:
+            case DW_TAG_class_type:
+            case DW_TAG_structure_type:
+            case DW_TAG_union_type:
+                scanDie(child, cuFunctions, result);
+                break;
+        }
+    }
+}
+
+static void analyzeCompilationUnits(ElfFile *file, int threadIndex, int threadCount, WorkerResult *result)
+{
+    // libdwarf handles are not thread-safe, so every thread gets its own
+    DwarfInfo info(file);
+    const auto cus = info.compilationUnits();
+    for (int i = threadIndex; i < cus.size(); i += threadCount) {
+        QSet<QByteArray> cuFunctions;
+        scanDie(cus.at(i), cuFunctions, *result);
+        ++result->cuCount;
+    }
+}
+#endif
+
+void TemplateDuplicationCheck::analyze(ElfFile* file)
+{
+#if HAVE_DWARF
+    if (!file || !file->dwarfInfo())
+        return;
+
+    // the file DwarfInfo actually reads from, which might be a separate debug file
+    const auto debugFile = file->separateDebugFile() ? file->separateDebugFile() : file;
+    const int threadCount = m_threadCount > 0 ? m_threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<WorkerResult> results(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        threads.emplace_back(analyzeCompilationUnits, debugFile, i, threadCount, &results[i]);
+    for (auto &thread : threads)
+        thread.join();
+
+    QHash<QByteArray, Function> fileFunctions;
+    for (const auto &result : results) {
+        m_cuCount += result.cuCount;
+        for (auto it = result.functions.constBegin(); it != result.functions.constEnd(); ++it) {
+            auto &function = fileFunctions[it.key()];
+            if (function.linkageName.isEmpty()) {
+                function = it.value();
+                continue;
+            }
+            function.cuCount += it.value().cuCount;
+            function.codeSize = std::max(function.codeSize, it.value().codeSize);
+        }
+    }
+
+    for (auto it = fileFunctions.constBegin(); it != fileFunctions.constEnd(); ++it) {
+        auto &function = m_functions[it.key()];
+        if (function.linkageName.isEmpty()) {
+            function = it.value();
+            function.fileCount = 1;
+            continue;
+        }
+        function.cuCount += it.value().cuCount;
+        function.codeSize = std::max(function.codeSize, it.value().codeSize);
+        ++function.fileCount;
+    }
+#else
+    Q_UNUSED(file);
+#endif
+}
+
+QVector<TemplateDuplicationCheck::Function> TemplateDuplicationCheck::duplicates() const
+{
+    QVector<Function> functions;
+    for (const auto &function : m_functions) {
+        if (function.cuCount > 1 || function.fileCount > 1)
+            functions.push_back(function);
+    }
+    std::sort(functions.begin(), functions.end(), [](const Function &lhs, const Function &rhs) {
+        if (lhs.redundantCompiledSize() == rhs.redundantCompiledSize())
+            return lhs.cuCount > rhs.cuCount;
+        return lhs.redundantCompiledSize() > rhs.redundantCompiledSize();
+    });
+    return functions;
+}
+
+QVector<TemplateDuplicationCheck::Function> TemplateDuplicationCheck::externTemplateCandidates() const
+{
+    QVector<Function> functions;
+    for (const auto &function : m_functions) {
+        if (function.isTemplate && function.cuCount > 1)
+            functions.push_back(function);
+    }
+    std::sort(functions.begin(), functions.end(), [](const Function &lhs, const Function &rhs) {
+        if (lhs.cuCount == rhs.cuCount)
+            return lhs.redundantCompiledSize() > rhs.redundantCompiledSize();
+        return lhs.cuCount > rhs.cuCount;
+    });
+    return functions;
+}
+
+static void printFunction(const TemplateDuplicationCheck::Function &function)
+{
+    const auto name = function.name.isEmpty() ? Demangler::demangleFull(function.linkageName.constData()) : function.name;
+    std::cout << "  " << name.constData() << ": " << function.cuCount << " CU(s), " << function.fileCount << " file(s), "
+              << function.codeSize << " bytes code, " << function.redundantCompiledSize() << " bytes compiled redundantly";
+    if (function.redundantLinkedSize() > 0)
+        std::cout << ", " << function.redundantLinkedSize() << " bytes linked redundantly";
+    std::cout << std::endl;
+}
+
+void TemplateDuplicationCheck::printReport(int limit) const
+{
+    const auto dups = duplicates();
+    quint64 compiledSize = 0;
+    quint64 linkedSize = 0;
+    for (const auto &function : dups) {
+        compiledSize += function.redundantCompiledSize();
+        linkedSize += function.redundantLinkedSize();
+    }
+
+    std::cout << "Analyzed " << m_cuCount << " compilation units, found " << m_functions.size() << " functions, "
+              << dups.size() << " of which are compiled more than once." << std::endl;
+    std::cout << "Redundantly compiled code: " << compiledSize << " bytes, redundantly linked code: " << linkedSize << " bytes." << std::endl << std::endl;
+
+    std::cout << "Most duplicated functions:" << std::endl;
+    for (int i = 0; i < dups.size() && (limit <= 0 || i < limit); ++i)
+        printFunction(dups.at(i));
+    std::cout << std::endl;
+
+    std::cout << "Extern template candidates:" << std::endl;
+    const auto candidates = externTemplateCandidates();
+    for (int i = 0; i < candidates.size() && (limit <= 0 || i < limit); ++i)
+        printFunction(candidates.at(i));
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEMPLATEDUPLICATIONCHECK_H
+#define TEMPLATEDUPLICATIONCHECK_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+class ElfFile;
+
+/** Finds functions compiled in multiple compilation units, such as inline functions and template instantiations.
+ *  Functions are identified by their DW_AT_linkage_name, code size is determined from DW_AT_low_pc/DW_AT_high_pc.
+ *  Compilation units are processed in parallel, using a separate DWARF handle per thread.
+ */
+class TemplateDuplicationCheck
+{
+public:
+    TemplateDuplicationCheck() = default;
+    TemplateDuplicationCheck(const TemplateDuplicationCheck&) = default;
+    ~TemplateDuplicationCheck() = default;
+
+    TemplateDuplicationCheck& operator=(const TemplateDuplicationCheck&) = default;
+
+    struct Function {
+        QByteArray linkageName;
+        QByteArray name;
+        /** Number of compilation units containing a definition of this function. */
+        int cuCount = 0;
+        /** Number of files containing a definition of this function. */
+        int fileCount = 0;
+        /** Code size of a single copy. */
+        quint64 codeSize = 0;
+        /** Whether this is a template or a member of a class template. */
+        bool isTemplate = false;
+
+        /** Code compiled in vain, assuming the linker keeps one copy per file. */
+        quint64 redundantCompiledSize() const;
+        /** Code present multiple times at runtime. */
+        quint64 redundantLinkedSize() const;
+    };
+
+    /** Number of threads to use, defaults to the number of CPU cores. */
+    void setThreadCount(int threadCount);
+
+    /** Analyze the DWARF information of @p file. Can be called repeatedly to accumulate multiple files. */
+    void analyze(ElfFile *file);
+
+    /** All functions defined in more than one compilation unit or file, sorted by redundant compiled code size. */
+    QVector<Function> duplicates() const;
+    /** Templates that would benefit most from an explicit extern template instantiation. */
+    QVector<Function> externTemplateCandidates() const;
+
+    /** Dump a report to stdout, showing the @p limit highest ranked entries of each category. */
+    void printReport(int limit) const;
+
+private:
+    QHash<QByteArray, Function> m_functions;
+    int m_threadCount = 0;
+    int m_cuCount = 0;
+};
+
+#endif // TEMPLATEDUPLICATIONCHECK_H
@@ -0,0 +1,152 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tinyfunctioncheck.h"
+#include "pltgotcheck.h"
+#include "symbollookupsimulator.h"
+
+#include <demangle/demangler.h>
+#include <disassmbler/instructiondecoder.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsymboltablesection.h>
+
+#include <QHash>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include <elf.h>
+
+TinyFunctionCheck::TinyFunctionCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+}
+
+void TinyFunctionCheck::setSizeThreshold(uint64_t size)
+{
+    m_sizeThreshold = size;
+}
+
+QVector<TinyFunctionCheck::Result> TinyFunctionCheck::analyze() const
+{
+    QVector<Result> results;
+    if (m_fileSet->size() == 0)
+        return results;
+
+    PltGotCheck pltGotCheck(m_fileSet);
+    const auto callSites = pltGotCheck.analyze();
+    const SymbolLookupSimulator simulator(m_fileSet);
+
+    QHash<ElfSymbolTableEntry*, int> resultIndex;
+    foreach (const auto &callerResult, callSites) {
+        // the undefined entries of the caller carry the symbol versions the calls bind to
+        QHash<QByteArray, uint32_t> references;
+        const auto dynSymIndex = callerResult.file->indexOfSection(SHT_DYNSYM);
+        const auto dynSym = dynSymIndex > 0 ? callerResult.file->section<ElfSymbolTableSection>(dynSymIndex) : nullptr;
+        for (uint32_t i = 1; dynSym && !callerResult.callees.isEmpty() && i < dynSym->header()->entryCount(); ++i) {
+            if (dynSym->entry(i)->sectionIndex() == SHN_UNDEF)
+                references.insert(dynSym->entry(i)->name(), i);
+        }
+
+        for (auto it = callerResult.callees.constBegin(); it != callerResult.callees.constEnd(); ++it) {
+            const auto count = it.value().count[PltGotCheck::PltCall] + it.value().count[PltGotCheck::GotCall];
+            if (count == 0)
+                continue;
+
+            // bind the same way ld.so does, first definition of the requested version in the lookup scope wins
+            const auto reference = references.constFind(it.key());
+            const auto version = reference != references.constEnd() ? SymbolLookupSimulator::symbolVersion(callerResult.file, reference.value()) : QByteArray();
+            int defIndex = -1;
+            const auto def = simulator.lookupDefinition(it.key().constData(), version, &defIndex, it.value().count[PltGotCheck::GotCall] == 0);
+            // canonical PLT entries of the executable are no definitions we could inline
+            if (!def || !def->hasValidSection())
+                continue;
+            const auto defFile = m_fileSet->file(defIndex);
+            // IFUNC symbol sizes are those of the resolver, not the selected implementation
+            if (defFile == callerResult.file || def->type() != STT_FUNC || def->size() == 0 || def->size() > m_sizeThreshold)
+                continue;
+
+            auto idx = resultIndex.value(def, -1);
+            if (idx < 0) {
+                Result result;
+                result.function = def;
+                result.file = defFile;
+                idx = results.size();
+                resultIndex.insert(def, idx);
+                results.push_back(result);
+            }
+            results[idx].callSites += count;
+            results[idx].callers.push_back(callerResult.file);
+        }
+    }
+
+    // one decoder per library, not per function
+    QHash<ElfFile*, QVector<int>> resultsByFile;
+    for (int i = 0; i < results.size(); ++i)
+        resultsByFile[results.at(i).file].push_back(i);
+    for (auto it = resultsByFile.constBegin(); it != resultsByFile.constEnd(); ++it) {
+        const InstructionDecoder decoder(it.key());
+        if (!decoder.isValid())
+            continue;
+        foreach (auto idx, it.value()) {
+            auto &result = results[idx];
+            result.instructions = 0;
+            const unsigned char *data = result.function->data();
+            size_t size = result.function->size();
+            auto address = result.function->value();
+            InstructionDecoder::Instruction insn;
+            while (size > 0 && decoder.decode(&data, &size, &address, &insn))
+                ++result.instructions;
+        }
+    }
+
+    std::sort(results.begin(), results.end(), [](const Result &lhs, const Result &rhs) {
+        if (lhs.callSites == rhs.callSites)
+            return lhs.function->size() < rhs.function->size();
+        return lhs.callSites > rhs.callSites;
+    });
+    return results;
+}
+
+void TinyFunctionCheck::printReport(int limit) const
+{
+    const auto results = analyze();
+    if (results.isEmpty())
+        return;
+
+    int callSites = 0;
+    foreach (const auto &result, results)
+        callSites += result.callSites;
+    std::cout << results.size() << " exported functions of at most " << m_sizeThreshold << " bytes are called from "
+              << callSites << " call sites in other libraries, consider inline definitions in their headers:" << std::endl;
+
+    for (int i = 0; i < results.size() && (limit <= 0 || i < limit); ++i) {
+        const auto &result = results.at(i);
+        std::cout << "  " << Demangler::demangleFull(result.function->name()).constData() << " ("
+                  << qPrintable(result.file->displayName()) << "): " << result.function->size() << " bytes";
+        if (result.instructions >= 0)
+            std::cout << ", " << result.instructions << " instructions";
+        std::cout << ", " << result.callSites << " call sites in";
+        foreach (auto caller, result.callers)
+            std::cout << " " << qPrintable(caller->displayName());
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TINYFUNCTIONCHECK_H
+#define TINYFUNCTIONCHECK_H
+
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+
+/** Finds small exported functions called through the PLT/GOT from other libraries of the set.
+ *  For those the stub, the indirect jump and the relocation cost about as much as the function
+ *  itself, an inline definition in the header would avoid that.
+ */
+class TinyFunctionCheck
+{
+public:
+    explicit TinyFunctionCheck(ElfFileSet *fileSet);
+    TinyFunctionCheck(const TinyFunctionCheck&) = default;
+    ~TinyFunctionCheck() = default;
+
+    TinyFunctionCheck& operator=(const TinyFunctionCheck&) = default;
+
+    /** Functions up to @p size bytes are considered, 32 by default. */
+    void setSizeThreshold(uint64_t size);
+
+    struct Result {
+        /** The definition the calls bind to, and the library containing it. */
+        ElfSymbolTableEntry *function = nullptr;
+        ElfFile *file = nullptr;
+        /** -1 if the code couldn't be disassembled. */
+        int instructions = -1;
+        /** Call sites in other libraries, through the PLT or the GOT. */
+        int callSites = 0;
+        QVector<ElfFile*> callers;
+    };
+
+    /** Returns the small functions with external callers, most call sites first. */
+    QVector<Result> analyze() const;
+
+    /** Dump the results to stdout, listing up to @p limit functions. */
+    void printReport(int limit = 25) const;
+
+private:
+    ElfFileSet *m_fileSet;
+    uint64_t m_sizeThreshold = 32;
+};
+
+#endif // TINYFUNCTIONCHECK_H
@@ -0,0 +1,304 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tlscheck.h"
+#include "pltgotcheck.h"
+
+#include <demangle/demangler.h>
+#include <disassmbler/instructiondecoder.h>
+#include <elf/elfdynamicsection.h>
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfheader.h>
+#include <elf/elfrelocationentry.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfsegmentheader.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsymboltablesection.h>
+
+#include <QSet>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include <elf.h>
+
+// static TLS reserved by glibc for libraries dlopen()ed later (glibc.rtld.optional_static_tls)
+static const uint64_t OptionalStaticTls = 512;
+
+TlsCheck::TlsCheck(ElfFileSet* fileSet) :
+    m_fileSet(fileSet)
+{
+    assert(fileSet);
+}
+
+bool TlsCheck::Result::usesDynamicModel() const
+{
+    return relocations[ModuleId] > 0 || relocations[Descriptor] > 0 || callSites > 0;
+}
+
+bool TlsCheck::Result::usesInitialExec() const
+{
+    return hasStaticTlsFlag || relocations[StaticOffset] > 0;
+}
+
+bool TlsCheck::Result::canUseInitialExec() const
+{
+    return loadedAtStartup || tlsSize <= OptionalStaticTls;
+}
+
+const char* TlsCheck::tlsRelocationName(TlsRelocation type)
+{
+    switch (type) {
+        case ModuleId: return "DTPMOD";
+        case ModuleOffset: return "DTPOFF";
+        case StaticOffset: return "TPOFF";
+        case Descriptor: return "TLSDESC";
+        case TlsRelocationCount: break;
+    }
+    return "";
+}
+
+static int tlsRelocation(uint16_t machine, uint32_t type)
+{
+    switch (machine) {
+        case EM_386:
+            switch (type) {
+                case R_386_TLS_DTPMOD32: return TlsCheck::ModuleId;
+                case R_386_TLS_DTPOFF32: return TlsCheck::ModuleOffset;
+                case R_386_TLS_TPOFF:
+                case R_386_TLS_TPOFF32: return TlsCheck::StaticOffset;
+                case R_386_TLS_DESC: return TlsCheck::Descriptor;
+            }
+            break;
+        case EM_X86_64:
+            switch (type) {
+                case R_X86_64_DTPMOD64: return TlsCheck::ModuleId;
+                case R_X86_64_DTPOFF64:
+                case R_X86_64_DTPOFF32: return TlsCheck::ModuleOffset;
+                case R_X86_64_TPOFF64:
+                case R_X86_64_TPOFF32: return TlsCheck::StaticOffset;
+                case R_X86_64_TLSDESC: return TlsCheck::Descriptor;
+            }
+            break;
+        case EM_ARM:
+            switch (type) {
+                case R_ARM_TLS_DTPMOD32: return TlsCheck::ModuleId;
+                case R_ARM_TLS_DTPOFF32: return TlsCheck::ModuleOffset;
+                case R_ARM_TLS_TPOFF32: return TlsCheck::StaticOffset;
+                case R_ARM_TLS_DESC: return TlsCheck::Descriptor;
+            }
+            break;
+        case EM_AARCH64:
+            switch (type) {
+                case R_AARCH64_TLS_DTPMOD: return TlsCheck::ModuleId;
+                case R_AARCH64_TLS_DTPREL: return TlsCheck::ModuleOffset;
+                case R_AARCH64_TLS_TPREL: return TlsCheck::StaticOffset;
+                case R_AARCH64_TLSDESC: return TlsCheck::Descriptor;
+            }
+            break;
+    }
+    return -1;
+}
+
+static bool isTlsGetAddr(const char *name)
+{
+    // i386 uses a variant with register arguments
+    return strcmp(name, "__tls_get_addr") == 0 || strcmp(name, "___tls_get_addr") == 0;
+}
+
+QVector<TlsCheck::Result> TlsCheck::analyze() const
+{
+    QVector<Result> results;
+    if (m_fileSet->size() == 0)
+        return results;
+
+    // everything else is dlopen()ed, and might only get dynamic TLS
+    const auto loadedAtStartup = m_fileSet->file(0)->isExecutable();
+    results.reserve(m_fileSet->size());
+    for (int i = 0; i < m_fileSet->size(); ++i)
+        results.push_back(analyzeFile(m_fileSet->file(i), loadedAtStartup));
+    return results;
+}
+
+TlsCheck::Result TlsCheck::analyzeFile(ElfFile* file, bool loadedAtStartup) const
+{
+    Result result;
+    result.file = file;
+    result.loadedAtStartup = loadedAtStartup;
+
+    foreach (auto phdr, file->segmentHeaders()) {
+        if (phdr->type() != PT_TLS)
+            continue;
+        result.tlsSize = phdr->memorySize();
+        result.tlsInitSize = phdr->fileSize();
+        result.tlsAlignment = phdr->alignment();
+    }
+    if (file->dynamicSection()) {
+        const auto flags = file->dynamicSection()->entryWithTag(DT_FLAGS);
+        result.hasStaticTlsFlag = flags && (flags->value() & DF_STATIC_TLS);
+    }
+
+    // GOT slots pointing to __tls_get_addr
+    QSet<uint64_t> gotSlots;
+    foreach (auto shdr, file->sectionHeaders()) {
+        // non-allocated ones are left over from static linking, e.g. with --emit-relocs
+        if ((shdr->type() != SHT_REL && shdr->type() != SHT_RELA) || (shdr->flags() & SHF_ALLOC) == 0)
+            continue;
+        const auto relocSection = file->section<ElfRelocationSection>(shdr->sectionIndex());
+        if (!relocSection)
+            continue;
+        for (uint64_t i = 0; i < shdr->entryCount(); ++i) {
+            const auto reloc = relocSection->entry(i);
+            const auto type = tlsRelocation(file->header()->machine(), reloc->type());
+            if (type >= 0) {
+                ++result.relocations[type];
+                if (type == ModuleId && reloc->symbolIndex() == 0)
+                    ++result.ownModuleRelocations;
+            }
+            if (reloc->symbolIndex() != 0 && reloc->symbol() && isTlsGetAddr(reloc->symbol()->name()))
+                gotSlots.insert(reloc->offset());
+        }
+    }
+
+    findCallers(file, gotSlots, result);
+    return result;
+}
+
+static bool isFunction(ElfSymbolTableEntry *sym)
+{
+    return sym->type() == STT_FUNC || sym->type() == STT_GNU_IFUNC;
+}
+
+void TlsCheck::findCallers(ElfFile* file, const QSet<uint64_t>& gotSlots, Result& result) const
+{
+    const auto symTab = file->symbolTable();
+    if (!symTab)
+        return;
+
+    // direct call targets: PLT stubs using one of the GOT slots, or a local definition
+    QSet<uint64_t> stubs;
+    for (uint32_t i = 0; i < symTab->header()->entryCount(); ++i) {
+        const auto sym = symTab->entry(i);
+        if (sym->hasValidSection() && isTlsGetAddr(sym->name()))
+            stubs.insert(sym->value());
+    }
+    // nothing to call
+    if (stubs.isEmpty() && gotSlots.isEmpty()) {
+        result.callSites = 0;
+        return;
+    }
+
+    InstructionDecoder decoder(file);
+    if (!decoder.isValid())
+        return;
+    result.callSites = 0;
+
+    const auto pltStubs = PltGotCheck::pltStubs(file, decoder);
+    for (auto it = pltStubs.constBegin(); it != pltStubs.constEnd(); ++it) {
+        if (gotSlots.contains(it.value()->offset()))
+            stubs.insert(it.key());
+    }
+
+    InstructionDecoder::Instruction insn;
+    QSet<uint64_t> scanned;
+    for (uint32_t i = 0; i < symTab->header()->entryCount(); ++i) {
+        const auto sym = symTab->entry(i);
+        if (!isFunction(sym) || !sym->hasValidSection() || sym->size() == 0 || (sym->sectionHeader()->flags() & SHF_EXECINSTR) == 0)
+            continue;
+        if (scanned.contains(sym->value()))
+            continue;
+        scanned.insert(sym->value());
+
+        Caller caller;
+        caller.function = sym;
+        const unsigned char *data = sym->data();
+        size_t size = sym->size();
+        auto address = sym->value();
+        while (size > 0 && decoder.decode(&data, &size, &address, &insn)) {
+            if (!insn.isCall && !insn.isJump)
+                continue;
+            // call __tls_get_addr@plt, or call *__tls_get_addr@GOTPCREL(%rip) with -fno-plt
+            if ((insn.branchTarget && stubs.contains(insn.branchTarget)) || (insn.dataTarget && gotSlots.contains(insn.dataTarget)))
+                ++caller.callSites;
+        }
+        if (caller.callSites == 0)
+            continue;
+        result.callSites += caller.callSites;
+        result.callers.push_back(caller);
+    }
+
+    std::sort(result.callers.begin(), result.callers.end(), [](const Caller &lhs, const Caller &rhs) {
+        return lhs.callSites > rhs.callSites;
+    });
+}
+
+static uint64_t alignedSize(uint64_t size, uint64_t alignment)
+{
+    if (alignment <= 1)
+        return size;
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+void TlsCheck::printReport(int limit) const
+{
+    const auto results = analyze();
+    uint64_t staticTls = 0;
+
+    foreach (const auto &result, results) {
+        const bool hasRelocations = std::any_of(std::begin(result.relocations), std::end(result.relocations), [](int count) { return count > 0; });
+        if (result.tlsSize == 0 && !hasRelocations && result.callSites <= 0)
+            continue;
+        if (result.loadedAtStartup)
+            staticTls += alignedSize(result.tlsSize, result.tlsAlignment);
+
+        std::cout << qPrintable(result.file->displayName()) << ": " << result.tlsSize << " bytes TLS per thread ("
+                  << result.tlsInitSize << " initialized), alignment " << result.tlsAlignment << std::endl;
+
+        std::cout << "  relocations:";
+        for (int i = 0; i < TlsRelocationCount; ++i)
+            std::cout << " " << tlsRelocationName(static_cast<TlsRelocation>(i)) << ": " << result.relocations[i];
+        std::cout << " (" << result.ownModuleRelocations << " DTPMOD for its own TLS)" << std::endl;
+
+        if (result.callSites < 0) {
+            std::cout << "  __tls_get_addr calls: unknown" << std::endl;
+        } else if (result.callSites > 0) {
+            std::cout << "  __tls_get_addr calls: " << result.callSites << " in " << result.callers.size() << " functions" << std::endl;
+            for (int i = 0; i < result.callers.size() && (limit <= 0 || i < limit); ++i) {
+                const auto &caller = result.callers.at(i);
+                std::cout << "    " << Demangler::demangleFull(caller.function->name()).constData() << ": " << caller.callSites << std::endl;
+            }
+        }
+
+        if (result.usesInitialExec()) {
+            std::cout << "  Uses initial-exec, needs static TLS." << std::endl;
+        } else if (result.usesDynamicModel() && result.tlsSize > 0) {
+            if (result.loadedAtStartup)
+                std::cout << "  Could use initial-exec, it is loaded at startup." << std::endl;
+            else if (result.canUseInitialExec())
+                std::cout << "  Could use initial-exec, its TLS fits into the static TLS reserved for dlopen() (" << OptionalStaticTls << " bytes) if no other library uses that." << std::endl;
+            else
+                std::cout << "  Can't use initial-exec when loaded with dlopen(), its TLS exceeds the static TLS reserved for that (" << OptionalStaticTls << " bytes)." << std::endl;
+        }
+    }
+
+    if (staticTls > 0)
+        std::cout << std::endl << "Static TLS of the files loaded at startup: " << staticTls << " bytes per thread" << std::endl;
+}
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TLSCHECK_H
+#define TLSCHECK_H
+
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+class ElfSymbolTableEntry;
+
+template<class T> class QSet;
+
+/** Analyzes thread-local storage: the size of the PT_TLS segments, which is paid per thread, the
+ *  TLS relocations indicating the access model, and the functions calling __tls_get_addr for
+ *  general-dynamic and local-dynamic accesses. Suggests libraries that could use initial-exec instead.
+ */
+class TlsCheck
+{
+public:
+    explicit TlsCheck(ElfFileSet *fileSet);
+    TlsCheck(const TlsCheck&) = default;
+    ~TlsCheck() = default;
+
+    TlsCheck& operator=(const TlsCheck&) = default;
+
+    /** Dynamic TLS relocation types, independent of the architecture. */
+    enum TlsRelocation {
+        ModuleId, ///< DTPMOD, for general-dynamic and local-dynamic accesses
+        ModuleOffset, ///< DTPOFF
+        StaticOffset, ///< TPOFF, for initial-exec accesses
+        Descriptor, ///< TLSDESC
+        TlsRelocationCount
+    };
+
+    struct Caller {
+        ElfSymbolTableEntry *function = nullptr;
+        int callSites = 0;
+    };
+
+    struct Result {
+        ElfFile *file = nullptr;
+        /** PT_TLS segment, all 0 if the file has no TLS. */
+        uint64_t tlsSize = 0;
+        uint64_t tlsInitSize = 0;
+        uint64_t tlsAlignment = 0;
+        int relocations[TlsRelocationCount] = {};
+        /** DTPMOD relocations without symbol, ie. for TLS of the file itself.
+         *  Linked files contain those instead of the TLSLD/TLSGD relocations of object files.
+         */
+        int ownModuleRelocations = 0;
+        /** DF_STATIC_TLS is set. */
+        bool hasStaticTlsFlag = false;
+        /** Part of the initial load order rather than opened with dlopen(). */
+        bool loadedAtStartup = false;
+        /** Functions calling __tls_get_addr, most call sites first. Call sites are -1 if the code
+         *  couldn't be disassembled. Only functions in the symbol table are considered.
+         */
+        QVector<Caller> callers;
+        int callSites = -1;
+
+        bool usesDynamicModel() const;
+        bool usesInitialExec() const;
+        /** Loaded at startup, or TLS small enough for the static TLS reserved for dlopen(). */
+        bool canUseInitialExec() const;
+    };
+
+    /** Analyze all files of the set. */
+    QVector<Result> analyze() const;
+
+    /** Dump the results to stdout, listing up to @p limit callers per file. */
+    void printReport(int limit = 10) const;
+
+    static const char* tlsRelocationName(TlsRelocation type);
+
+private:
+    Result analyzeFile(ElfFile *file, bool loadedAtStartup) const;
+    void findCallers(ElfFile *file, const QSet<uint64_t> &gotSlots, Result &result) const;
+
+    ElfFileSet *m_fileSet;
+};
+
+#endif // TLSCHECK_H
@@ -16,6 +16,7 @@
 */
 
 #include "disassembler.h"
+#include "instructiondecoder.h"
 #include "config-elf-dissector.h"
 
 #include <elf/elfsymboltableentry.h>
@@ -216,26 +217,8 @@ QString Disassembler::disassembleCapstone(const unsigned char* data, uint64_t si
 {
 #ifdef HAVE_CAPSTONE
     csh handle;
-    cs_err err;
-    switch (file()->header()->machine()) {
-        case EM_386:
-            err = cs_open(CS_ARCH_X86, CS_MODE_32, &handle);
-            break;
-        case EM_X86_64:
-            err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
-            break;
-        case EM_ARM:
-            err = cs_open(CS_ARCH_ARM, CS_MODE_LITTLE_ENDIAN, &handle);
-            break;
-        case EM_AARCH64:
-            err = cs_open(CS_ARCH_ARM64, CS_MODE_LITTLE_ENDIAN, &handle);
-            break;
-        default:
-            qWarning() << "Unsupported architecture!";
-            return {};
-    }
-    if (err != CS_ERR_OK) {
-        qWarning() << "Error opening Capstone handle:" << err;
+    if (!InstructionDecoder::openHandle(file(), &handle)) {
+        qWarning() << "Unsupported architecture!";
         return {};
     }
     std::unique_ptr<csh, decltype(&cs_close)> handleGuard(&handle, &cs_close);
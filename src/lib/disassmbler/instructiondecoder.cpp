@@ -0,0 +1,179 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include "instructiondecoder.h"
+
+#include <elf/elffile.h>
+#include <elf/elfheader.h>
+
+#include <QDebug>
+
+#ifdef HAVE_CAPSTONE
+#include <capstone.h>
+#endif
+
+#include <cstring>
+
+#include <elf.h>
+
+InstructionDecoder::InstructionDecoder(ElfFile* file) :
+    m_file(file)
+{
+#ifdef HAVE_CAPSTONE
+    csh handle;
+    if (!openHandle(file, &handle))
+        return;
+    m_handle = handle;
+    cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+    m_insn = cs_malloc(handle);
+#endif
+}
+
+InstructionDecoder::~InstructionDecoder()
+{
+#ifdef HAVE_CAPSTONE
+    if (m_insn)
+        cs_free(m_insn, 1);
+    if (m_handle) {
+        csh handle = m_handle;
+        cs_close(&handle);
+    }
+#endif
+}
+
+bool InstructionDecoder::openHandle(ElfFile* file, size_t* handle)
+{
+#ifdef HAVE_CAPSTONE
+    cs_err err;
+    switch (file->header()->machine()) {
+        case EM_386:
+            err = cs_open(CS_ARCH_X86, CS_MODE_32, handle);
+            break;
+        case EM_X86_64:
+            err = cs_open(CS_ARCH_X86, CS_MODE_64, handle);
+            break;
+        case EM_ARM:
+            err = cs_open(CS_ARCH_ARM, CS_MODE_LITTLE_ENDIAN, handle);
+            break;
+        case EM_AARCH64:
+            err = cs_open(CS_ARCH_ARM64, CS_MODE_LITTLE_ENDIAN, handle);
+            break;
+        default:
+            return false;
+    }
+    if (err != CS_ERR_OK) {
+        qWarning() << "Error opening Capstone handle:" << err;
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(file);
+    Q_UNUSED(handle);
+    return false;
+#endif
+}
+
+bool InstructionDecoder::isValid() const
+{
+    return m_insn;
+}
+
+#ifdef HAVE_CAPSTONE
+static bool isInsnGroup(cs_insn *insn, uint8_t group)
+{
+    for (uint8_t i = 0; i < insn->detail->groups_count; ++i) {
+        if (insn->detail->groups[i] == group)
+            return true;
+    }
+    return false;
+}
+#endif
+
+bool InstructionDecoder::decode(const unsigned char** data, size_t* size, uint64_t* address, Instruction* insn) const
+{
+#ifdef HAVE_CAPSTONE
+    // an ADRP page only applies to the instructions following it
+    if (*address != m_nextAddress)
+        m_pageRegister = 0;
+    if (!m_insn || !cs_disasm_iter(m_handle, data, size, address, m_insn))
+        return false;
+    m_nextAddress = *address;
+
+    *insn = {};
+    insn->address = m_insn->address;
+    insn->size = m_insn->size;
+    insn->isCall = isInsnGroup(m_insn, CS_GRP_CALL);
+    insn->isJump = isInsnGroup(m_insn, CS_GRP_JUMP);
+    insn->isReturn = isInsnGroup(m_insn, CS_GRP_RET);
+
+    const auto isBranch = insn->isCall || insn->isJump;
+    switch (m_file->header()->machine()) {
+        case EM_386:
+        case EM_X86_64:
+            for (int i = 0; i < m_insn->detail->x86.op_count; ++i) {
+                const auto op = m_insn->detail->x86.operands[i];
+                if (op.type == X86_OP_IMM && isBranch)
+                    insn->branchTarget = op.imm;
+                else if (op.type == X86_OP_MEM && op.mem.base == X86_REG_RIP)
+                    insn->dataTarget = *address + op.mem.disp;
+            }
+            break;
+        case EM_ARM:
+            if (isBranch && m_insn->detail->arm.op_count == 1 && m_insn->detail->arm.operands[0].type == ARM_OP_IMM)
+                insn->branchTarget = m_insn->detail->arm.operands[0].imm;
+            break;
+        case EM_AARCH64:
+        {
+            const auto &detail = m_insn->detail->arm64;
+            if (isBranch && detail.op_count == 1 && detail.operands[0].type == ARM64_OP_IMM) {
+                insn->branchTarget = detail.operands[0].imm;
+                m_pageRegister = 0;
+                break;
+            }
+            // ADRP only provides the 4k page, the following load, store or add the offset into it
+            if (m_insn->id == ARM64_INS_ADRP && detail.op_count == 2 && detail.operands[0].type == ARM64_OP_REG && detail.operands[1].type == ARM64_OP_IMM) {
+                m_pageRegister = detail.operands[0].reg;
+                m_page = detail.operands[1].imm;
+                break;
+            }
+            if (!m_pageRegister)
+                break;
+            for (int i = 0; i < detail.op_count; ++i) {
+                const auto &op = detail.operands[i];
+                if (op.type == ARM64_OP_MEM && op.mem.base == m_pageRegister && op.mem.index == ARM64_REG_INVALID)
+                    insn->dataTarget = m_page + op.mem.disp;
+            }
+            if (m_insn->id == ARM64_INS_ADD && detail.op_count == 3 && detail.operands[1].type == ARM64_OP_REG
+                && detail.operands[1].reg == m_pageRegister && detail.operands[2].type == ARM64_OP_IMM)
+                insn->dataTarget = m_page + detail.operands[2].imm;
+            // the page register is overwritten, except by stores, which have their source first
+            if (isBranch || (detail.op_count > 0 && detail.operands[0].type == ARM64_OP_REG && detail.operands[0].reg == m_pageRegister
+                && strncmp(m_insn->mnemonic, "st", 2) != 0))
+                m_pageRegister = 0;
+            break;
+        }
+    }
+    return true;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    Q_UNUSED(address);
+    Q_UNUSED(insn);
+    return false;
+#endif
+}
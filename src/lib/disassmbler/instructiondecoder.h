@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef INSTRUCTIONDECODER_H
+#define INSTRUCTIONDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+class ElfFile;
+
+struct cs_insn;
+
+/** Decodes machine code for analysis, ie. without producing a textual representation.
+ *  This needs Capstone, without it (or for unsupported architectures) isValid() returns @c false.
+ */
+class InstructionDecoder
+{
+public:
+    explicit InstructionDecoder(ElfFile *file);
+    InstructionDecoder(const InstructionDecoder&) = delete;
+    ~InstructionDecoder();
+
+    InstructionDecoder& operator=(const InstructionDecoder&) = delete;
+
+    bool isValid() const;
+
+    /** Opens a Capstone handle for the architecture of @p file, shared with the disassembler.
+     *  Returns @c false for unsupported architectures, on errors or without Capstone.
+     */
+    static bool openHandle(ElfFile *file, size_t *handle);
+
+    struct Instruction
+    {
+        uint64_t address = 0;
+        uint16_t size = 0;
+        bool isCall = false;
+        bool isJump = false;
+        bool isReturn = false;
+        /** Target of a direct call or jump, 0 otherwise. */
+        uint64_t branchTarget = 0;
+        /** Address referenced PC-relative, 0 otherwise. For AArch64 this is set on the load, store
+         *  or add combining the preceding ADRP page with its offset, not on the ADRP itself.
+         */
+        uint64_t dataTarget = 0;
+    };
+
+    /** Decodes the instruction at @p data, located at @p address, and advances @p data,
+     *  @p size and @p address past it. Returns @c false if no instruction could be decoded.
+     */
+    bool decode(const unsigned char **data, size_t *size, uint64_t *address, Instruction *insn) const;
+
+private:
+    ElfFile *m_file;
+    size_t m_handle = 0;
+    cs_insn *m_insn = nullptr;
+    // AArch64 ADRP seen in the current instruction sequence
+    mutable uint64_t m_page = 0;
+    mutable unsigned int m_pageRegister = 0;
+    mutable uint64_t m_nextAddress = 0;
+};
+
+#endif // INSTRUCTIONDECODER_H
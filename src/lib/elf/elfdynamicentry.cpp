@@ -18,6 +18,7 @@
 #include "elfdynamicentry.h"
 #include "elfdynamicsection.h"
 #include "elfstringtablesection.h"
+#include "elfrelrsection.h"
 #include <QObject>
 
 #include <elf.h>
@@ -73,6 +74,9 @@ QString ElfDynamicEntry::tagName() const
         case DT_FLAGS: return QStringLiteral("Flags");
         case DT_PREINIT_ARRAY: return QStringLiteral("Preinit function address array");
         case DT_PREINIT_ARRAYSZ: return QStringLiteral("Preinit function address array size");
+        case DT_RELRSZ: return QStringLiteral("Relr reloc size");
+        case DT_RELR: return QStringLiteral("Relr reloc address");
+        case DT_RELRENT: return QStringLiteral("Relr reloc entry size");
 #if 0
         #define DT_GNU_PRELINKED 0x6ffffdf5     /* Prelinking timestamp */
         #define DT_GNU_CONFLICTSZ 0x6ffffdf6    /* Size of conflict section */
@@ -141,6 +145,7 @@ bool ElfDynamicEntry::isAddress() const
         case DT_FINI:
         case DT_REL:
         case DT_JMPREL:
+        case DT_RELR:
         case DT_INIT_ARRAY:
         case DT_FINI_ARRAY:
         case DT_PREINIT_ARRAY:
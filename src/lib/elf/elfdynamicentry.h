@@ -52,6 +52,8 @@ public:
      *  it's written in write mode.
      */
     virtual void setValue(uint64_t value) = 0;
+    /** Changes the tag of this entry, writing to the file the same way as setValue(). */
+    virtual void setTag(int64_t tag) = 0;
     virtual uint64_t pointer() const = 0;
 
 protected:
@@ -45,6 +45,11 @@ public:
         m_entry->d_un.d_val = value;
     }
 
+    void setTag(int64_t tag) override
+    {
+        m_entry->d_tag = tag;
+    }
+
     uint64_t pointer() const override
     {
         return m_entry->d_un.d_ptr;
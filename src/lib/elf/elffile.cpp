@@ -31,6 +31,8 @@
 #include "elfnotesection.h"
 #include "elfpltsection.h"
 #include "elfrelocationsection.h"
+#include "elfrelrsection.h"
+#include "elfpackedrelocationsection.h"
 #include "elfsysvhashsection.h"
 #include "elfsegmentheader_impl.h"
 #include "elfnoteentry.h"
@@ -41,9 +43,14 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QtEndian>
 
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 #include <elf.h>
+#include <sys/mman.h>
 
 struct ElfFileException {};
 
@@ -102,6 +109,36 @@ int ElfFile::byteOrder() const
     return m_data[EI_DATA];
 }
 
+uint32_t ElfFile::readUInt32(const unsigned char* data) const
+{
+    return byteOrder() == ELFDATA2MSB ? qFromBigEndian<uint32_t>(data) : qFromLittleEndian<uint32_t>(data);
+}
+
+uint64_t ElfFile::readPointer(const unsigned char* data) const
+{
+    if (addressSize() == 4)
+        return readUInt32(data);
+    return byteOrder() == ELFDATA2MSB ? qFromBigEndian<uint64_t>(data) : qFromLittleEndian<uint64_t>(data);
+}
+
+void ElfFile::writeUInt32(unsigned char* data, uint32_t value) const
+{
+    if (byteOrder() == ELFDATA2MSB)
+        qToBigEndian<uint32_t>(value, data);
+    else
+        qToLittleEndian<uint32_t>(value, data);
+}
+
+void ElfFile::writePointer(unsigned char* data, uint64_t value) const
+{
+    if (addressSize() == 4)
+        writeUInt32(data, value);
+    else if (byteOrder() == ELFDATA2MSB)
+        qToBigEndian<uint64_t>(value, data);
+    else
+        qToLittleEndian<uint64_t>(value, data);
+}
+
 uint8_t ElfFile::osAbi() const
 {
     return m_data[EI_OSABI];
@@ -112,6 +149,21 @@ ElfHeader* ElfFile::header() const
     return m_header.get();
 }
 
+bool ElfFile::isExecutable() const
+{
+    if (header()->type() == ET_EXEC)
+        return true;
+
+    // PIE executables are ET_DYN, like libraries, but request a program interpreter
+    // some libraries (e.g. libc) can be run too, their DT_SONAME tells them apart
+    const auto it = std::find_if(m_segmentHeaders.cbegin(), m_segmentHeaders.cend(), [](ElfSegmentHeader *phdr) {
+        return phdr->type() == PT_INTERP;
+    });
+    if (it == m_segmentHeaders.cend())
+        return false;
+    return !m_dynamicSection || m_dynamicSection->soName().isEmpty();
+}
+
 int ElfFile::sectionCount() const
 {
     assert(m_sectionHeaders.size() == m_sections.size());
@@ -158,6 +210,13 @@ void ElfFile::close()
     m_data = nullptr;
 }
 
+void ElfFile::dropMappedPages()
+{
+    // the mapping is shared, its content stays in the page cache and all addresses remain valid
+    if (m_data && madvise(m_data, m_file.size(), MADV_DONTNEED) != 0)
+        qWarning() << "Failed to drop mapped pages of" << m_file.fileName() << ":" << strerror(errno);
+}
+
 void ElfFile::parse()
 {
     static_assert(EV_CURRENT == 1, "ELF version changed");
@@ -270,6 +329,22 @@ void ElfFile::parseSection(uint16_t index)
             section = relocSec;
             break;
         }
+        case SHT_RELR:
+        case SHT_ANDROID_RELR:
+        {
+            auto relrSec = new ElfRelrSection(this, shdr);
+            m_reverseReloc.addRelrSection(relrSec);
+            section = relrSec;
+            break;
+        }
+        case SHT_ANDROID_REL:
+        case SHT_ANDROID_RELA:
+        {
+            auto packedSec = new ElfPackedRelocationSection(this, shdr);
+            m_reverseReloc.addPackedRelocationSection(packedSec);
+            section = packedSec;
+            break;
+        }
         case SHT_NOTE:
             section = new ElfNoteSection(this, shdr);
             break;
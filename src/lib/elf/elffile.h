@@ -49,6 +49,10 @@ public:
     /** Open the file and parse its content. Must be called before the file can be used. */
     bool open(QIODevice::OpenMode openMode);
     void close();
+    /** Drop the pages of the file mapping from this process, they are read in again on the next access.
+     *  Pages still mapped cannot be evicted from the page cache, which cold cache benchmarks rely on.
+     */
+    void dropMappedPages();
 
 
     /** Returns @c true if the file could be loaded and is parsed correctly. */
@@ -70,11 +74,23 @@ public:
     int addressSize() const;
     /** Endianess. */
     int byteOrder() const;
+    /** Reads a 32 bit value from @p data in the byte order of this file. */
+    uint32_t readUInt32(const unsigned char *data) const;
+    /** Reads an address sized value from @p data in the byte order of this file. */
+    uint64_t readPointer(const unsigned char *data) const;
+    /** Writes the 32 bit @p value to @p data in the byte order of this file. */
+    void writeUInt32(unsigned char *data, uint32_t value) const;
+    /** Writes the address sized @p value to @p data in the byte order of this file. */
+    void writePointer(unsigned char *data, uint64_t value) const;
     /** OS ABI. */
     uint8_t osAbi() const;
 
     /** Returns the ELF header. */
     ElfHeader* header() const;
+    /** Returns @c true for executables, including position independent ones.
+     *  Only relies on the ELF and program headers, so this also works for section-stripped files.
+     */
+    bool isExecutable() const;
 
     /** Returns the number of sections.
      *  Use this rather than header()->sectionHeaderCount() to include sections merged
@@ -49,10 +49,29 @@ void ElfFileSet::addFile(const QString& fileName)
     addFile(f);
 }
 
-static void resolvePlaceholder(QVector<QByteArray> &paths, const QByteArray &originPath)
+void ElfFileSet::setSysroot(const QString& sysroot)
 {
-    for (auto it = paths.begin(); it != paths.end(); ++it)
-        (*it).replace("$ORIGIN", originPath);
+    assert(m_files.isEmpty());
+    m_sysroot = QDir::cleanPath(sysroot).toUtf8();
+    if (m_sysroot == "/")
+        m_sysroot.clear();
+
+    // the host's library and debug search paths are meaningless for a foreign system
+    m_baseSearchPaths.clear();
+    m_ldLibraryPaths.clear();
+    parseLdConf();
+    m_globalDebugSearchPath.clear();
+    m_globalDebugSearchPath.push_back(QString::fromUtf8(m_sysroot) + QStringLiteral("/usr/lib/debug"));
+}
+
+static void resolvePlaceholder(QVector<QByteArray> &paths, const QByteArray &originPath, const QByteArray &sysroot)
+{
+    for (auto it = paths.begin(); it != paths.end(); ++it) {
+        if ((*it).contains("$ORIGIN"))
+            (*it).replace("$ORIGIN", originPath);
+        else if ((*it).startsWith('/'))
+            (*it).prepend(sysroot);
+    }
 }
 
 void ElfFileSet::addFile(ElfFile* file)
@@ -69,8 +88,8 @@ void ElfFileSet::addFile(ElfFile* file)
     auto rpaths = file->dynamicSection()->rpaths();
     auto runpaths = file->dynamicSection()->runpaths();
     auto originPath = QFileInfo(file->fileName()).absolutePath().toUtf8();
-    resolvePlaceholder(rpaths, originPath);
-    resolvePlaceholder(runpaths, originPath);
+    resolvePlaceholder(rpaths, originPath, m_sysroot);
+    resolvePlaceholder(runpaths, originPath, m_sysroot);
 
     QVector<QByteArray> searchPaths;
     searchPaths.reserve(rpaths.size() + m_ldLibraryPaths.size() + runpaths.size() + m_baseSearchPaths.size());
@@ -81,7 +100,7 @@ void ElfFileSet::addFile(ElfFile* file)
     searchPaths += m_baseSearchPaths;
 
     foreach (const auto &lib, file->dynamicSection()->neededLibraries()) {
-        if (std::find_if(m_files.cbegin(), m_files.cend(), [lib](ElfFile *file){ return file->dynamicSection()->soName() == lib; }) != m_files.cend())
+        if (std::find_if(m_files.cbegin(), m_files.cend(), [lib](ElfFile *file){ return file->dynamicSection() && file->dynamicSection()->soName() == lib; }) != m_files.cend())
             continue;
         bool dependencyFound = false;
         foreach (const auto &dir, searchPaths) {
@@ -100,10 +119,11 @@ void ElfFileSet::addFile(ElfFile* file)
 
         // deal with NEEDED entries containing absolute paths
         if (!dependencyFound && lib.startsWith('/')) {
-            if (std::find_if(m_files.cbegin(), m_files.cend(), [lib](ElfFile *file){ return file->fileName() == lib; }) != m_files.cend())
+            const auto libPath = QString::fromUtf8(m_sysroot + lib);
+            if (std::find_if(m_files.cbegin(), m_files.cend(), [libPath](ElfFile *file){ return file->fileName() == libPath; }) != m_files.cend())
                 continue;
-            if (QFile::exists(lib)) {
-                ElfFile *dep = new ElfFile(lib);
+            if (QFile::exists(libPath)) {
+                ElfFile *dep = new ElfFile(libPath);
                 ElfFile *firstFile = m_files.at(0);
                 if (dep->open(QIODevice::ReadOnly) && dep->isValid() && dep->type() == firstFile->type() && dep->header()->machine() == firstFile->header()->machine()) {
                     dependencyFound = true;
@@ -135,7 +155,7 @@ static bool hasUnresolvedDependencies(ElfFile *file, const QVector<ElfFile*> &re
         return false;
 
     foreach (const auto &lib, file->dynamicSection()->neededLibraries()) {
-        const auto it = std::find_if(resolved.constBegin() + startIndex, resolved.constEnd(), [lib](ElfFile *file){ return file->dynamicSection()->soName() == lib; });
+        const auto it = std::find_if(resolved.constBegin() + startIndex, resolved.constEnd(), [lib](ElfFile *file){ return file->dynamicSection() && file->dynamicSection()->soName() == lib; });
         if (it == resolved.constEnd()) {
             return true;
         }
@@ -187,13 +207,13 @@ void ElfFileSet::topologicalSort()
 
 void ElfFileSet::parseLdConf()
 {
-    parseLdConf(QStringLiteral("/etc/ld.so.conf"));
+    parseLdConf(QString::fromUtf8(m_sysroot) + QStringLiteral("/etc/ld.so.conf"));
 
     // built-in defaults
-    m_baseSearchPaths.push_back("/lib64");
-    m_baseSearchPaths.push_back("/lib");
-    m_baseSearchPaths.push_back("/usr/lib64");
-    m_baseSearchPaths.push_back("/usr/lib");
+    m_baseSearchPaths.push_back(m_sysroot + "/lib64");
+    m_baseSearchPaths.push_back(m_sysroot + "/lib");
+    m_baseSearchPaths.push_back(m_sysroot + "/usr/lib64");
+    m_baseSearchPaths.push_back(m_sysroot + "/usr/lib");
 }
 
 void ElfFileSet::parseLdConf(const QString& fileName)
@@ -211,7 +231,9 @@ void ElfFileSet::parseLdConf(const QString& fileName)
         if (line.startsWith('#'))
             continue;
         if (line.startsWith("include")) {
-            const auto fileGlob = line.mid(8);
+            auto fileGlob = line.mid(8).trimmed();
+            if (fileGlob.startsWith('/'))
+                fileGlob.prepend(m_sysroot);
             if (QFileInfo::exists(fileGlob)) {
                 parseLdConf(fileGlob);
             } else {
@@ -224,8 +246,8 @@ void ElfFileSet::parseLdConf(const QString& fileName)
             continue;
         }
         if (line.startsWith('/')) {
-            if (QFileInfo::exists(line))
-                m_baseSearchPaths.push_back(line);
+            if (QFileInfo::exists(m_sysroot + line))
+                m_baseSearchPaths.push_back(m_sysroot + line);
             continue;
         }
         qWarning() << "unable to handle ld.so.conf line:" << line;
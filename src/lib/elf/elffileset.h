@@ -33,6 +33,11 @@ public:
     int size() const;
     void addFile(const QString &fileName);
 
+    /** Resolve dependencies inside @p sysroot rather than the host system.
+     *  Must be called before adding any files.
+     */
+    void setSysroot(const QString &sysroot);
+
     ElfFile* file(int index) const;
 
     void topologicalSort();
@@ -46,6 +51,7 @@ private:
     QVector<ElfFile*> m_files;
     QVector<QByteArray> m_baseSearchPaths;
     QVector<QByteArray> m_ldLibraryPaths;
+    QByteArray m_sysroot;
 
     QVector<QString> m_globalDebugSearchPath;
 };
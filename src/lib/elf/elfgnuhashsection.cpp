@@ -85,11 +85,16 @@ uint64_t ElfGnuHashSection::filterMask(uint32_t index) const
     return *(reinterpret_cast<const uint32_t*>(rawData()) + 4 + index);
 }
 
-ElfSymbolTableEntry* ElfGnuHashSection::lookup(const char* name) const
+ElfSymbolTableEntry* ElfGnuHashSection::lookup(const char* name, LookupStatistics* stats, const QSet<QByteArray>* hiddenSymbols, bool pltLookup) const
 {
+    LookupStatistics dummyStats;
+    if (!stats)
+        stats = &dummyStats;
+
     auto h1 = hash(name);
 
     {
+        ++stats->bloomProbes;
         const uint32_t h2 = h1 >> shift2();
         const uint32_t c = file()->addressSize() * 8;
         const uint32_t n = (h1 / c) & (maskWordsCount() - 1);
@@ -103,22 +108,35 @@ ElfSymbolTableEntry* ElfGnuHashSection::lookup(const char* name) const
     }
 
     auto n = bucket(h1 % bucketCount());
-    if (n == 0)
+    if (n == 0) {
+        ++stats->bloomFalsePositives;
         return nullptr;
+    }
 
     const auto symTab = linkedSection<ElfSymbolTableSection>();
     assert(symTab);
     auto hashValue = value(n);
 
     for (h1 &= ~1; true; ++n) {
-        const auto entry = symTab->entry(n);
         const auto h2 = *hashValue++;
-        if ((h1 == (h2 & ~1)) && strcmp(name, entry->name()) == 0)
-            return entry;
+        // hidden symbols wouldn't be in the table at all
+        const bool hidden = hiddenSymbols && isHidden(symTab->entry(n), *hiddenSymbols);
+        if (!hidden)
+            ++stats->chainWalks;
+        if (!hidden && h1 == (h2 & ~1)) {
+            const auto entry = symTab->entry(n);
+            if (isDefinition(entry, pltLookup)) {
+                ++stats->strcmpCalls;
+                stats->bytesCompared += commonPrefixLength(name, entry->name()) + 1;
+                if (strcmp(name, entry->name()) == 0)
+                    return isGlobalDefinition(entry) ? entry : nullptr;
+            }
+        }
         if (h2 & 1)
             break;
     }
 
+    ++stats->bloomFalsePositives;
     return nullptr;
 }
 
@@ -39,7 +39,8 @@ public:
     uint32_t shift2() const;
 
     static uint32_t hash(const char* name);
-    ElfSymbolTableEntry *lookup(const char* name) const final override;
+    using ElfHashSection::lookup;
+    ElfSymbolTableEntry *lookup(const char* name, LookupStatistics *stats, const QSet<QByteArray> *hiddenSymbols = nullptr, bool pltLookup = false) const final override;
 
     QVector<uint32_t> histogram() const final override;
     double averagePrefixLength() const final override;
@@ -16,6 +16,13 @@
 */
 
 #include "elfhashsection.h"
+#include "elfsymboltableentry.h"
+
+#include <QSet>
+
+#include <cstring>
+
+#include <elf.h>
 
 ElfHashSection::ElfHashSection(ElfFile* file, ElfSectionHeader* shdr) :
     ElfSection(file, shdr)
@@ -24,6 +31,11 @@ ElfHashSection::ElfHashSection(ElfFile* file, ElfSectionHeader* shdr) :
 
 ElfHashSection::~ElfHashSection() = default;
 
+ElfSymbolTableEntry* ElfHashSection::lookup(const char* name) const
+{
+    return lookup(name, nullptr);
+}
+
 int ElfHashSection::commonPrefixLength(const char* s1, const char* s2)
 {
     int l = 0;
@@ -34,3 +46,39 @@ int ElfHashSection::commonPrefixLength(const char* s1, const char* s2)
     }
     return l;
 }
+
+bool ElfHashSection::isHidden(ElfSymbolTableEntry* entry, const QSet<QByteArray>& hiddenSymbols)
+{
+    return hiddenSymbols.contains(QByteArray::fromRawData(entry->name(), strlen(entry->name())));
+}
+
+bool ElfHashSection::isDefinition(ElfSymbolTableEntry* entry, bool pltLookup)
+{
+    // see check_match() in glibc's dl-lookup.c
+    if (entry->value() == 0 && entry->sectionIndex() != SHN_ABS && entry->type() != STT_TLS)
+        return false;
+    if (pltLookup && entry->sectionIndex() == SHN_UNDEF)
+        return false;
+    switch (entry->type()) {
+        case STT_NOTYPE:
+        case STT_OBJECT:
+        case STT_FUNC:
+        case STT_COMMON:
+        case STT_TLS:
+        case STT_GNU_IFUNC:
+            return true;
+    }
+    return false;
+}
+
+bool ElfHashSection::isGlobalDefinition(ElfSymbolTableEntry* entry)
+{
+    // see do_lookup_x() in glibc's dl-lookup.c
+    switch (entry->bindType()) {
+        case STB_GLOBAL:
+        case STB_WEAK:
+        case STB_GNU_UNIQUE:
+            return true;
+    }
+    return false;
+}
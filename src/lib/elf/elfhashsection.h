@@ -24,6 +24,9 @@
 
 class ElfSymbolTableEntry;
 
+class QByteArray;
+template<class T> class QSet;
+
 /** Interface for hash table sections for symbol lookup. */
 class ElfHashSection : public ElfSection
 {
@@ -34,15 +37,40 @@ public:
     virtual uint32_t bucketCount() const = 0;
     virtual uint32_t chainCount() const = 0;
 
-    virtual ElfSymbolTableEntry *lookup(const char* name) const = 0;
+    /** Look up @p name the same way the dynamic linker does, ie. ignoring undefined entries. */
+    ElfSymbolTableEntry *lookup(const char* name) const;
+
+    /** Counters for the work done during a symbol lookup. */
+    struct LookupStatistics {
+        uint64_t bloomProbes = 0;
+        uint64_t bloomFalsePositives = 0;
+        uint64_t chainWalks = 0;
+        uint64_t strcmpCalls = 0;
+        uint64_t bytesCompared = 0;
+    };
+    /** Same as the above, additionally records the work needed for this in @p stats, if not @c nullptr.
+     *  Entries named in @p hiddenSymbols are treated as if they were not in the table, apart from
+     *  the GNU hash Bloom filter bits they set. @p pltLookup is set for resolving PLT slots, which
+     *  can't bind to the canonical PLT entries of an executable.
+     */
+    virtual ElfSymbolTableEntry *lookup(const char* name, LookupStatistics *stats, const QSet<QByteArray> *hiddenSymbols = nullptr, bool pltLookup = false) const = 0;
 
     /** Histogram of the hash chain lengths. */
     virtual QVector<uint32_t> histogram() const = 0;
     /** Average length of common prefixes in case of hash collisions. */
     virtual double averagePrefixLength() const = 0;
 
+    /** Checks if the dynamic linker would consider @p entry as a definition, before comparing names.
+     *  Undefined functions with a value are canonical PLT entries, those are definitions except
+     *  for @p pltLookup.
+     */
+    static bool isDefinition(ElfSymbolTableEntry *entry, bool pltLookup = false);
+    /** Checks if the dynamic linker accepts @p entry after its name matched, local symbols end the lookup in this file. */
+    static bool isGlobalDefinition(ElfSymbolTableEntry *entry);
+
 protected:
     static int commonPrefixLength(const char *s1, const char *s2);
+    static bool isHidden(ElfSymbolTableEntry *entry, const QSet<QByteArray> &hiddenSymbols);
 };
 
 #endif // ELFHASHSECTION_H
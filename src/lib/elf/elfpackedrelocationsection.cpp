@@ -0,0 +1,161 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "elfpackedrelocationsection.h"
+#include "elffile.h"
+
+#include <QPair>
+
+#include <algorithm>
+#include <cstring>
+
+#include <elf.h>
+
+// see bionic/linker/linker_sleb128.h and linker_reloc_iterators.h
+enum {
+    RelocationGroupedByInfo = 1,
+    RelocationGroupedByOffsetDelta = 2,
+    RelocationGroupedByAddend = 4,
+    RelocationGroupHasAddend = 8
+};
+
+class Sleb128Decoder
+{
+public:
+    Sleb128Decoder(const unsigned char *begin, const unsigned char *end) : m_it(begin), m_end(end) {}
+
+    int64_t next()
+    {
+        int64_t value = 0;
+        unsigned shift = 0;
+        unsigned char byte;
+        do {
+            if (m_it >= m_end) {
+                m_overflow = true;
+                return 0;
+            }
+            byte = *m_it++;
+            if (shift < 64)
+                value |= (int64_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        if (shift < 64 && (byte & 0x40))
+            value |= -((int64_t)1 << shift);
+        return value;
+    }
+
+    bool hasOverflow() const { return m_overflow; }
+
+private:
+    const unsigned char *m_it;
+    const unsigned char *m_end;
+    bool m_overflow = false;
+};
+
+ElfPackedRelocationSection::ElfPackedRelocationSection(ElfFile* file, ElfSectionHeader* shdr) :
+    ElfSection(file, shdr)
+{
+    m_valid = decode();
+    if (!m_valid) {
+        m_offsets.clear();
+        m_infos.clear();
+    }
+}
+
+ElfPackedRelocationSection::~ElfPackedRelocationSection() = default;
+
+bool ElfPackedRelocationSection::decode()
+{
+    if (size() < 4 || memcmp(rawData(), "APS2", 4) != 0)
+        return false;
+
+    const auto withAddend = header()->type() == SHT_ANDROID_RELA;
+    Sleb128Decoder decoder(rawData() + 4, rawData() + size());
+
+    const auto count = decoder.next();
+    uint64_t offset = decoder.next();
+    if (count < 0 || decoder.hasOverflow())
+        return false;
+    QVector<QPair<uint64_t, uint64_t>> relocations; // offset, info
+    relocations.reserve((int)count);
+
+    uint64_t info = 0;
+    while (relocations.size() < count) {
+        const auto groupSize = decoder.next();
+        const auto groupFlags = decoder.next();
+        if (groupSize <= 0 || decoder.hasOverflow() || relocations.size() + groupSize > count)
+            return false;
+        if (!withAddend && (groupFlags & RelocationGroupHasAddend))
+            return false;
+
+        const int64_t offsetDelta = (groupFlags & RelocationGroupedByOffsetDelta) ? decoder.next() : 0;
+        if (groupFlags & RelocationGroupedByInfo)
+            info = decoder.next();
+        if ((groupFlags & RelocationGroupHasAddend) && (groupFlags & RelocationGroupedByAddend))
+            decoder.next(); // we don't need addend values
+
+        for (int64_t i = 0; i < groupSize; ++i) {
+            offset += (groupFlags & RelocationGroupedByOffsetDelta) ? offsetDelta : decoder.next();
+            if (!(groupFlags & RelocationGroupedByInfo))
+                info = decoder.next();
+            if ((groupFlags & RelocationGroupHasAddend) && !(groupFlags & RelocationGroupedByAddend))
+                decoder.next();
+            if (decoder.hasOverflow())
+                return false;
+
+            relocations.push_back(qMakePair(offset, info));
+        }
+    }
+
+    std::sort(relocations.begin(), relocations.end(), [](const QPair<uint64_t, uint64_t> &lhs, const QPair<uint64_t, uint64_t> &rhs) {
+        return lhs.first < rhs.first;
+    });
+    m_offsets.reserve(relocations.size());
+    m_infos.reserve(relocations.size());
+    foreach (const auto &reloc, relocations) {
+        m_offsets.push_back(reloc.first);
+        m_infos.push_back(reloc.second);
+    }
+    return true;
+}
+
+bool ElfPackedRelocationSection::isValid() const
+{
+    return m_valid;
+}
+
+uint64_t ElfPackedRelocationSection::relocationCount() const
+{
+    return m_offsets.size();
+}
+
+QVector<uint64_t> ElfPackedRelocationSection::relocationOffsets() const
+{
+    return m_offsets;
+}
+
+uint32_t ElfPackedRelocationSection::relocationType(int index) const
+{
+    const auto info = m_infos.at(index);
+    return file()->type() == ELFCLASS64 ? ELF64_R_TYPE(info) : ELF32_R_TYPE(info);
+}
+
+uint32_t ElfPackedRelocationSection::symbolIndex(int index) const
+{
+    const auto info = m_infos.at(index);
+    return file()->type() == ELFCLASS64 ? ELF64_R_SYM(info) : ELF32_R_SYM(info);
+}
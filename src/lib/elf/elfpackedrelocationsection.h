@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ELFPACKEDRELOCATIONSECTION_H
+#define ELFPACKEDRELOCATIONSECTION_H
+
+#include "elfsection.h"
+
+#include <QVector>
+
+#ifndef SHT_ANDROID_REL
+#define SHT_ANDROID_REL 0x60000001
+#define SHT_ANDROID_RELA 0x60000002
+#endif
+#ifndef SHT_ANDROID_RELR
+#define SHT_ANDROID_RELR 0x6fffff00
+#endif
+
+/** Android packed relocation section (APS2 format), as produced by --pack-dyn-relocs=android.
+ *  Relocation targets, types and symbol indexes are decoded, addends are skipped
+ *  and no ElfRelocationEntry objects are created.
+ */
+class ElfPackedRelocationSection : public ElfSection
+{
+public:
+    explicit ElfPackedRelocationSection(ElfFile *file, ElfSectionHeader *shdr);
+    ~ElfPackedRelocationSection();
+
+    /** Returns @c false if this section does not start with the APS2 magic or is truncated. */
+    bool isValid() const;
+
+    uint64_t relocationCount() const;
+    /** Addresses of all relocated words, in ascending order. */
+    QVector<uint64_t> relocationOffsets() const;
+    /** Relocation type of the relocation at @p index in relocationOffsets(). */
+    uint32_t relocationType(int index) const;
+    /** Symbol index of the relocation at @p index in relocationOffsets(). */
+    uint32_t symbolIndex(int index) const;
+
+private:
+    bool decode();
+
+    QVector<uint64_t> m_offsets;
+    QVector<uint64_t> m_infos;
+    bool m_valid = false;
+};
+
+#endif // ELFPACKEDRELOCATIONSECTION_H
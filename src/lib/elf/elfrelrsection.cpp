@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "elfrelrsection.h"
+#include "elffile.h"
+
+ElfRelrSection::ElfRelrSection(ElfFile* file, ElfSectionHeader* shdr) :
+    ElfSection(file, shdr)
+{
+}
+
+ElfRelrSection::~ElfRelrSection() = default;
+
+uint64_t ElfRelrSection::word(uint64_t index) const
+{
+    if (file()->addressSize() == 8)
+        return *(reinterpret_cast<const uint64_t*>(rawData()) + index);
+    return *(reinterpret_cast<const uint32_t*>(rawData()) + index);
+}
+
+uint64_t ElfRelrSection::relocationCount() const
+{
+    uint64_t count = 0;
+    const auto wordCount = size() / file()->addressSize();
+    for (uint64_t i = 0; i < wordCount; ++i) {
+        const auto entry = word(i);
+        if ((entry & 1) == 0)
+            ++count;
+        else
+            count += __builtin_popcountll(entry) - 1;
+    }
+    return count;
+}
+
+QVector<uint64_t> ElfRelrSection::relocationOffsets() const
+{
+    QVector<uint64_t> offsets;
+    const uint64_t wordSize = file()->addressSize();
+    const auto bitsPerWord = wordSize * 8;
+    const auto wordCount = size() / wordSize;
+
+    uint64_t base = 0;
+    for (uint64_t i = 0; i < wordCount; ++i) {
+        const auto entry = word(i);
+        if ((entry & 1) == 0) {
+            offsets.push_back(entry);
+            base = entry + wordSize;
+            continue;
+        }
+        for (uint64_t bit = 1; bit < bitsPerWord; ++bit) {
+            if ((entry >> bit) & 1)
+                offsets.push_back(base + (bit - 1) * wordSize);
+        }
+        base += (bitsPerWord - 1) * wordSize;
+    }
+
+    return offsets;
+}
+
+uint64_t ElfRelrSection::encodedSize(const QVector<uint64_t>& offsets, int addressSize)
+{
+    // same greedy encoding as the linkers use
+    const uint64_t wordSize = addressSize;
+    const auto bitmapBits = wordSize * 8 - 1;
+    uint64_t words = 0;
+
+    for (int i = 0; i < offsets.size();) {
+        ++words;
+        auto base = offsets.at(i) + wordSize;
+        ++i;
+        while (true) {
+            bool hasBits = false;
+            while (i < offsets.size() && offsets.at(i) >= base && offsets.at(i) - base < bitmapBits * wordSize && (offsets.at(i) - base) % wordSize == 0) {
+                hasBits = true;
+                ++i;
+            }
+            if (!hasBits)
+                break;
+            ++words;
+            base += bitmapBits * wordSize;
+        }
+    }
+
+    return words * wordSize;
+}
@@ -0,0 +1,57 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ELFRELRSECTION_H
+#define ELFRELRSECTION_H
+
+#include "elfsection.h"
+
+#include <QVector>
+
+#include <elf.h>
+
+#ifndef SHT_RELR
+#define SHT_RELR 19
+#endif
+#ifndef DT_RELRSZ
+#define DT_RELRSZ 35
+#define DT_RELR 36
+#define DT_RELRENT 37
+#endif
+
+/** Compact relative relocation section (SHT_RELR), as produced by -z pack-relative-relocs.
+ *  Each entry is either an address, or a bitmap of the following words to relocate.
+ */
+class ElfRelrSection : public ElfSection
+{
+public:
+    explicit ElfRelrSection(ElfFile *file, ElfSectionHeader *shdr);
+    ~ElfRelrSection();
+
+    /** Number of relocations encoded in this section. */
+    uint64_t relocationCount() const;
+    /** Addresses of all relocated words, in ascending order. */
+    QVector<uint64_t> relocationOffsets() const;
+
+    /** Size of the RELR encoding of the given sorted relative relocation @p offsets. */
+    static uint64_t encodedSize(const QVector<uint64_t> &offsets, int addressSize);
+
+private:
+    uint64_t word(uint64_t index) const;
+};
+
+#endif // ELFRELRSECTION_H
@@ -17,13 +17,15 @@
 
 #include "elfreverserelocator.h"
 #include "elfrelocationsection.h"
+#include "elfrelrsection.h"
+#include "elfpackedrelocationsection.h"
 
 #include <cassert>
 
 int ElfReverseRelocator::size() const
 {
     indexRelocations();
-    return m_relocations.size();
+    return m_relocations.size() + m_packedRelocations.size();
 }
 
 ElfRelocationEntry* ElfReverseRelocator::find(uint64_t vaddr) const
@@ -40,6 +42,13 @@ ElfRelocationEntry* ElfReverseRelocator::find(uint64_t vaddr) const
     return *it;
 }
 
+bool ElfReverseRelocator::isRelocated(uint64_t vaddr) const
+{
+    if (find(vaddr))
+        return true;
+    return std::binary_search(m_packedRelocations.cbegin(), m_packedRelocations.cend(), vaddr);
+}
+
 int ElfReverseRelocator::relocationCount(uint64_t beginVAddr, uint64_t length) const
 {
     indexRelocations();
@@ -47,27 +56,39 @@ int ElfReverseRelocator::relocationCount(uint64_t beginVAddr, uint64_t length) c
     const auto beginIt = std::lower_bound(m_relocations.cbegin(), m_relocations.cend(), beginVAddr, [](ElfRelocationEntry *entry, uint64_t vaddr) {
         return entry->offset() < vaddr;
     });
-
-    if (beginIt == m_relocations.cend())
-        return 0;
-
-    const auto endIt = std::lower_bound(m_relocations.cbegin(), m_relocations.cend(), beginVAddr + length, [](ElfRelocationEntry *entry, uint64_t vaddr) {
+    const auto endIt = std::lower_bound(beginIt, m_relocations.cend(), beginVAddr + length, [](ElfRelocationEntry *entry, uint64_t vaddr) {
         return entry->offset() < vaddr;
     });
 
-    return std::distance(beginIt, endIt);
+    const auto packedBeginIt = std::lower_bound(m_packedRelocations.cbegin(), m_packedRelocations.cend(), beginVAddr);
+    const auto packedEndIt = std::lower_bound(packedBeginIt, m_packedRelocations.cend(), beginVAddr + length);
+
+    return std::distance(beginIt, endIt) + std::distance(packedBeginIt, packedEndIt);
 }
 
 void ElfReverseRelocator::addRelocationSection(ElfRelocationSection* section)
 {
-    assert(m_relocations.isEmpty());
+    assert(!m_indexed);
     m_relocSections.push_back(section);
 }
 
+void ElfReverseRelocator::addRelrSection(ElfRelrSection* section)
+{
+    assert(!m_indexed);
+    m_relrSections.push_back(section);
+}
+
+void ElfReverseRelocator::addPackedRelocationSection(ElfPackedRelocationSection* section)
+{
+    assert(!m_indexed);
+    m_packedSections.push_back(section);
+}
+
 void ElfReverseRelocator::indexRelocations() const
 {
-    if (!m_relocations.isEmpty())
+    if (m_indexed)
         return;
+    m_indexed = true;
 
     int totalSize = 0;
     std::for_each(m_relocSections.constBegin(), m_relocSections.constEnd(), [&totalSize](ElfRelocationSection* section) {
@@ -85,4 +106,10 @@ void ElfReverseRelocator::indexRelocations() const
     std::sort(m_relocations.begin(), m_relocations.end(), [](ElfRelocationEntry *lhs, ElfRelocationEntry *rhs) {
         return lhs->offset() < rhs->offset();
     });
+
+    for (const auto sec : m_relrSections)
+        m_packedRelocations += sec->relocationOffsets();
+    for (const auto sec : m_packedSections)
+        m_packedRelocations += sec->relocationOffsets();
+    std::sort(m_packedRelocations.begin(), m_packedRelocations.end());
 }
@@ -22,30 +22,42 @@
 
 class ElfRelocationEntry;
 class ElfRelocationSection;
+class ElfRelrSection;
+class ElfPackedRelocationSection;
 
 /** Look up if a given address is relocated. */
 class ElfReverseRelocator
 {
 public:
-    /** Total amount of relocations. */
+    /** Total amount of relocations, including RELR and packed relocations. */
     int size() const;
 
     /** Finds the relocation entry for the given virtual address.
-     *  Returns @c nullptr if @p vaddr isn't relocated.
+     *  Returns @c nullptr if @p vaddr isn't relocated, or only by a RELR or packed relocation
+     *  which have no relocation entry objects, use isRelocated() for those.
      */
     ElfRelocationEntry* find(uint64_t vaddr) const;
+    /** Returns whether @p vaddr is the target of any relocation. */
+    bool isRelocated(uint64_t vaddr) const;
 
     /** Counts the amount of relocations within the given address range. */
     int relocationCount(uint64_t beginVAddr, uint64_t length) const;
 
     // internal for ElfFile
     void addRelocationSection(ElfRelocationSection* section);
+    void addRelrSection(ElfRelrSection *section);
+    void addPackedRelocationSection(ElfPackedRelocationSection *section);
 
 private:
     void indexRelocations() const;
 
     QVector<ElfRelocationSection*> m_relocSections;
+    QVector<ElfRelrSection*> m_relrSections;
+    QVector<ElfPackedRelocationSection*> m_packedSections;
     mutable QVector<ElfRelocationEntry*> m_relocations;
+    // targets of RELR and packed relocations, which we don't have entry objects for
+    mutable QVector<uint64_t> m_packedRelocations;
+    mutable bool m_indexed = false;
 };
 
 #endif // ELFREVERSERELOCATOR_H
@@ -61,8 +61,12 @@ uint32_t ElfSysvHashSection::hash(const char* name)
     return h;
 }
 
-ElfSymbolTableEntry* ElfSysvHashSection::lookup(const char* name) const
+ElfSymbolTableEntry* ElfSysvHashSection::lookup(const char* name, LookupStatistics* stats, const QSet<QByteArray>* hiddenSymbols, bool pltLookup) const
 {
+    LookupStatistics dummyStats;
+    if (!stats)
+        stats = &dummyStats;
+
     const auto x = hash(name);
 
     const auto symTab = linkedSection<ElfSymbolTableSection>();
@@ -70,8 +74,16 @@ ElfSymbolTableEntry* ElfSysvHashSection::lookup(const char* name) const
     auto y = bucket(x % bucketCount());
     while (y != STN_UNDEF) {
         const auto entry = symTab->entry(y);
-        if (strcmp(entry->name(), name) == 0)
-            return entry;
+        // hidden symbols wouldn't be in the table at all
+        const bool hidden = hiddenSymbols && isHidden(entry, *hiddenSymbols);
+        if (!hidden)
+            ++stats->chainWalks;
+        if (!hidden && isDefinition(entry, pltLookup)) {
+            ++stats->strcmpCalls;
+            stats->bytesCompared += commonPrefixLength(name, entry->name()) + 1;
+            if (strcmp(entry->name(), name) == 0)
+                return isGlobalDefinition(entry) ? entry : nullptr;
+        }
         y = chain(y);
     }
 
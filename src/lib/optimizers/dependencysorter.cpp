@@ -16,22 +16,37 @@
 */
 
 #include "dependencysorter.h"
-#include <checks/dependenciescheck.h>
+#include <checks/symbollookupsimulator.h>
 #include <elf/elffileset.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
 
 #include <QDebug>
-#include <QHash>
+#include <QFile>
+#include <QFileInfo>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
 #include <elf.h>
 
-void DependencySorter::sortDtNeeded(ElfFileSet* fileSet)
+bool DependencySorter::Result::isModified() const
 {
-    assert(fileSet->size() > 0);
+    return originalOrder != optimizedOrder;
+}
 
-    auto file = fileSet->file(0);
-    if (!file->dynamicSection())
-        return;
+void DependencySorter::setRemoveUnused(bool removeUnused)
+{
+    m_removeUnused = removeUnused;
+}
+
+QVector<DependencySorter::Result> DependencySorter::sortDtNeeded(ElfFileSet* fileSet) const
+{
+    assert(fileSet->size() > 0);
 
     // TODO index SO_NAME, this probably should be moved to ElfFileSet, we have that in a bunch of places now
     QHash<QByteArray, int> nameIndex;
@@ -40,71 +55,242 @@ void DependencySorter::sortDtNeeded(ElfFileSet* fileSet)
         if (!f->dynamicSection())
             continue;
         const auto soName = f->dynamicSection()->soName();
+        if (soName.isEmpty())
+            continue;
         if (nameIndex.contains(soName)) {
-            qWarning() << "Suspicious DT_NEEDED entry '" << soName << "' in " << f->fileName() << ", aborting.";
-            return;
+            // ld.so would use the first one too
+            qWarning() << "Duplicate SONAME" << soName << "in" << f->fileName() << ", ignoring.";
+            continue;
         }
-
-        if (!soName.isEmpty())
-            nameIndex.insert(soName, i);
+        nameIndex.insert(soName, i);
     }
 
-    // count usages
-    QVector<int> usageCounts;
+    QVector<Result> results;
+    for (int i = 0; i < fileSet->size(); ++i)
+        results.push_back(sortDtNeeded(fileSet, i, nameIndex));
+    return results;
+}
+
+static uint64_t lookupCost(const ElfHashSection::LookupStatistics &stats)
+{
+    return stats.bloomProbes + stats.chainWalks + stats.strcmpCalls;
+}
+
+DependencySorter::Result DependencySorter::sortDtNeeded(ElfFileSet* fileSet, int fileIndex, const QHash<QByteArray, int>& nameIndex) const
+{
+    Result result;
+    result.fileIndex = fileIndex;
+
+    const auto file = fileSet->file(fileIndex);
+    if (!file->dynamicSection())
+        return result;
+
     const auto needed = file->dynamicSection()->neededLibraries();
-    usageCounts.resize(needed.size());
-    for (int i = 0; i < needed.size(); ++i) {
-        auto depFile = fileSet->file(nameIndex.value(needed.at(i)));
-        assert(depFile);
-        assert(file != depFile);
+    result.originalOrder = needed;
+    result.optimizedOrder = needed;
 
-        usageCounts[i] = DependenciesCheck::usedSymbolCount(file, depFile);
+    QVector<ElfHashSection*> hashTabs;
+    hashTabs.reserve(needed.size());
+    foreach (const auto &lib, needed) {
+        const auto depIdx = nameIndex.value(lib, -1);
+        if (depIdx < 0 || depIdx == fileIndex || !fileSet->file(depIdx)->hash()) {
+            qWarning() << "Can't resolve DT_NEEDED entry" << lib << "of" << file->fileName() << ", skipping.";
+            return result;
+        }
+        hashTabs.push_back(fileSet->file(depIdx)->hash());
     }
-    qDebug() << usageCounts;
 
-    // sort, check if change is needed
-    QVector<int> sortedNeededIndex;
-    sortedNeededIndex.resize(needed.size());
-    std::iota(sortedNeededIndex.begin(), sortedNeededIndex.end(), 0);
-    assert(sortedNeededIndex.size() == usageCounts.size());
-    qDebug() << sortedNeededIndex;
+    const auto symtab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+    if (!symtab)
+        return result;
 
-    std::sort(sortedNeededIndex.begin(), sortedNeededIndex.end(), [usageCounts](int lhs, int rhs) {
-        return usageCounts.at(lhs) > usageCounts.at(rhs);
-    });
+    // lookup cost and result for each undefined symbol in each dependency
+    QVector<QVector<uint64_t>> costs(needed.size());
+    QVector<QVector<bool>> provides(needed.size());
+    QVector<int> firstProvider;
+    for (uint i = 1; i < symtab->header()->entryCount(); ++i) {
+        const auto userEntry = symtab->entry(i);
+        if (userEntry->hasValidSection() || strlen(userEntry->name()) == 0)
+            continue;
+        int provider = -1;
+        for (int dep = 0; dep < needed.size(); ++dep) {
+            ElfHashSection::LookupStatistics stats;
+            const auto providerEntry = hashTabs.at(dep)->lookup(userEntry->name(), &stats);
+            const auto isProvider = providerEntry && providerEntry->value() > 0;
+            costs[dep].push_back(lookupCost(stats));
+            provides[dep].push_back(isProvider);
+            if (isProvider && provider < 0)
+                provider = dep;
+        }
+        firstProvider.push_back(provider);
+    }
 
-    qDebug() << sortedNeededIndex;
+    // weight: lookups satisfied by a dependency, penalty: average cost of a failed lookup in it
+    QVector<int> weights(needed.size(), 0);
+    QVector<double> missCosts(needed.size(), 1.0);
+    QVector<bool> used(needed.size(), false);
+    // symbols defined in more than one dependency must keep resolving to the same definition
+    QVector<QVector<int>> predecessors(needed.size());
+    for (int dep = 0; dep < needed.size(); ++dep) {
+        uint64_t missCost = 0;
+        int missCount = 0;
+        for (int sym = 0; sym < firstProvider.size(); ++sym) {
+            if (firstProvider.at(sym) == dep)
+                ++weights[dep];
+            if (provides.at(dep).at(sym)) {
+                used[dep] = true;
+                if (firstProvider.at(sym) != dep && !predecessors.at(dep).contains(firstProvider.at(sym)))
+                    predecessors[dep].push_back(firstProvider.at(sym));
+            } else {
+                missCost += costs.at(dep).at(sym);
+                ++missCount;
+            }
+        }
+        if (missCount > 0 && missCost > 0)
+            missCosts[dep] = (double)missCost / missCount;
+    }
 
-    // since we modify the file in-place, get the necessary string table values before we do that
-    QVector<uint64_t> neededValues;
-    neededValues.resize(needed.size());
-    int neededIndex = 0;
-    for (uint i = 0; i < file->dynamicSection()->header()->entryCount(); ++i) {
-        auto dynEntry = file->dynamicSection()->entry(i);
-        if (dynEntry->tag() != DT_NEEDED)
+    // greedy ordering by satisfied lookups per probe cost, respecting the above constraints
+    QVector<int> remaining;
+    for (int dep = 0; dep < needed.size(); ++dep) {
+        if (m_removeUnused && !used.at(dep))
+            result.removedLibraries.push_back(needed.at(dep));
+        else
+            remaining.push_back(dep);
+    }
+    QVector<int> order;
+    while (!remaining.isEmpty()) {
+        int best = -1;
+        for (int i = 0; i < remaining.size(); ++i) {
+            const auto dep = remaining.at(i);
+            const auto blocked = std::any_of(predecessors.at(dep).constBegin(), predecessors.at(dep).constEnd(), [&order](int pred) {
+                return !order.contains(pred);
+            });
+            if (blocked)
+                continue;
+            if (best < 0 || weights.at(dep) * missCosts.at(remaining.at(best)) > weights.at(remaining.at(best)) * missCosts.at(dep))
+                best = i;
+        }
+        assert(best >= 0);
+        order.push_back(remaining.at(best));
+        remaining.remove(best);
+    }
+
+    result.optimizedOrder.clear();
+    foreach (auto dep, order)
+        result.optimizedOrder.push_back(needed.at(dep));
+
+    QVector<int> originalOrder(needed.size());
+    std::iota(originalOrder.begin(), originalOrder.end(), 0);
+    const auto scopeCost = [&costs, &provides, &firstProvider](const QVector<int> &scope) {
+        uint64_t cost = 0;
+        for (int sym = 0; sym < firstProvider.size(); ++sym) {
+            foreach (auto dep, scope) {
+                cost += costs.at(dep).at(sym);
+                if (provides.at(dep).at(sym))
+                    break;
+            }
+        }
+        return cost;
+    };
+    result.originalCost = scopeCost(originalOrder);
+    result.optimizedCost = scopeCost(order);
+
+    return result;
+}
+
+void DependencySorter::printResults(ElfFileSet* fileSet, const QVector<Result>& results)
+{
+    uint64_t originalCost = 0;
+    uint64_t optimizedCost = 0;
+    foreach (const auto &result, results) {
+        originalCost += result.originalCost;
+        optimizedCost += result.optimizedCost;
+        if (!result.isModified())
             continue;
-        neededValues[neededIndex++] = dynEntry->value();
+
+        std::cout << qPrintable(fileSet->file(result.fileIndex)->displayName()) << ":" << std::endl;
+        std::cout << "  before:";
+        foreach (const auto &lib, result.originalOrder)
+            std::cout << " " << lib.constData();
+        std::cout << std::endl << "  after: ";
+        foreach (const auto &lib, result.optimizedOrder)
+            std::cout << " " << lib.constData();
+        std::cout << std::endl;
+        foreach (const auto &lib, result.removedLibraries)
+            std::cout << "  removed unused " << lib.constData() << std::endl;
+        std::cout << "  estimated lookup cost: " << result.originalCost << " -> " << result.optimizedCost << " probes" << std::endl;
     }
 
-    // open target file
-    ElfFile newFile(file->fileName());
+    std::cout << "Total estimated lookup cost in local scopes: " << originalCost << " -> " << optimizedCost << " probes";
+    if (originalCost > 0)
+        std::cout << " (" << (100.0 * ((double)originalCost - (double)optimizedCost) / (double)originalCost) << "% saved)";
+    std::cout << std::endl;
+}
+
+bool DependencySorter::write(ElfFile* file, const Result& result, const QString& outputFileName)
+{
+    if (QFileInfo(outputFileName).canonicalFilePath() == QFileInfo(file->fileName()).canonicalFilePath()) {
+        qWarning() << "Refusing to overwrite" << file->fileName();
+        return false;
+    }
+
+    // the string table is not changed, so we can reuse the existing DT_NEEDED values
+    QHash<QByteArray, uint64_t> neededValues;
+    const auto dynSection = file->dynamicSection();
+    for (uint i = 0; i < dynSection->header()->entryCount(); ++i) {
+        const auto dynEntry = dynSection->entry(i);
+        if (dynEntry->tag() == DT_NEEDED)
+            neededValues.insert(dynEntry->stringValue(), dynEntry->value());
+    }
+
+    QFile::remove(outputFileName);
+    if (!QFile::copy(file->fileName(), outputFileName)) {
+        qWarning() << "Can't copy" << file->fileName() << "to" << outputFileName;
+        return false;
+    }
+
+    ElfFile newFile(outputFileName);
     if (!newFile.open(QFile::ReadWrite) || !newFile.isValid()) {
-        qWarning() << "Can't open" << file->fileName() << "for writing.";
-        return;
+        qWarning() << "Can't open" << outputFileName << "for writing.";
+        return false;
     }
 
-    // write change
-    neededIndex = 0;
+    QVector<QPair<int64_t, uint64_t>> entries;
     auto newDynSection = newFile.dynamicSection();
+    int neededIndex = 0;
     for (uint i = 0; i < newDynSection->header()->entryCount(); ++i) {
-        auto dynEntry = newDynSection->entry(i);
-        if (dynEntry->tag() != DT_NEEDED)
+        const auto dynEntry = newDynSection->entry(i);
+        if (dynEntry->tag() == DT_NEEDED) {
+            if (neededIndex < result.optimizedOrder.size())
+                entries.push_back(qMakePair<int64_t, uint64_t>(DT_NEEDED, neededValues.value(result.optimizedOrder.at(neededIndex++))));
             continue;
+        }
+        if (dynEntry->tag() == DT_NULL)
+            break;
+        entries.push_back(qMakePair(dynEntry->tag(), dynEntry->value()));
+    }
+    assert(neededIndex == result.optimizedOrder.size());
 
-        dynEntry->setValue(neededValues.at(sortedNeededIndex.at(neededIndex)));
-
-        qDebug() << needed.at(sortedNeededIndex.at(neededIndex));
-        ++neededIndex;
+    // removed entries leave a gap at the end, which is what DT_NULL padding is for anyway
+    for (uint i = 0; i < newDynSection->header()->entryCount(); ++i) {
+        auto dynEntry = newDynSection->entry(i);
+        if (i < (uint)entries.size()) {
+            dynEntry->setTag(entries.at(i).first);
+            dynEntry->setValue(entries.at(i).second);
+        } else {
+            dynEntry->setTag(DT_NULL);
+            dynEntry->setValue(0);
+        }
     }
 
+    return true;
+}
+
+QVector<int> DependencySorter::scopeOrder(ElfFileSet* fileSet, const QVector<Result>& results)
+{
+    QHash<int, QVector<QByteArray>> neededLibraries;
+    foreach (const auto &result, results)
+        neededLibraries.insert(result.fileIndex, result.optimizedOrder);
+    return SymbolLookupSimulator::scopeOrder(fileSet, neededLibraries);
 }
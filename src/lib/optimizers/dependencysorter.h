@@ -18,13 +18,66 @@
 #ifndef DEPENDENCYSORTER_H
 #define DEPENDENCYSORTER_H
 
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include <cstdint>
+
 class ElfFileSet;
+class ElfFile;
 
-/** Sorts DT_NEEDED entries of .dynamic by symbol lookup hit probability. */
+class QString;
+
+/** Sorts DT_NEEDED entries of .dynamic by symbol lookup hit probability.
+ *  Each dependency is weighted by the number of lookups it satisfies and by the cost
+ *  of a failing lookup in its hash table, which is what every library placed in front
+ *  of the actual provider adds to a lookup.
+ */
 class DependencySorter
 {
 public:
-    void sortDtNeeded(ElfFileSet* fileSet);
+    DependencySorter() = default;
+    DependencySorter(const DependencySorter&) = default;
+    ~DependencySorter() = default;
+
+    DependencySorter& operator=(const DependencySorter&) = default;
+
+    /** Drop DT_NEEDED entries of which no symbol is used. Note that this breaks libraries
+     *  that are only linked for the side-effects of their static initializers.
+     */
+    void setRemoveUnused(bool removeUnused);
+
+    struct Result {
+        int fileIndex = -1;
+        QVector<QByteArray> originalOrder;
+        QVector<QByteArray> optimizedOrder;
+        QVector<QByteArray> removedLibraries;
+        /** Estimated lookup cost in the local scope of this file, in hash table probes. */
+        uint64_t originalCost = 0;
+        uint64_t optimizedCost = 0;
+
+        bool isModified() const;
+    };
+
+    /** Compute the optimal DT_NEEDED order for every file in @p fileSet, without changing anything. */
+    QVector<Result> sortDtNeeded(ElfFileSet* fileSet) const;
+
+    /** Dump the changes and cost estimates in @p results to stdout, for use in CLI tools. */
+    static void printResults(ElfFileSet *fileSet, const QVector<Result> &results);
+
+    /** Write a copy of @p file to @p outputFileName with the DT_NEEDED entries changed according to @p result.
+     *  Entries following removed DT_NEEDED entries are moved up, the end of .dynamic is filled with DT_NULL.
+     */
+    static bool write(ElfFile *file, const Result &result, const QString &outputFileName);
+
+    /** Breadth-first global lookup scope as ld.so would build it with the changes of @p results applied. */
+    static QVector<int> scopeOrder(ElfFileSet *fileSet, const QVector<Result> &results);
+
+private:
+    Result sortDtNeeded(ElfFileSet *fileSet, int fileIndex, const QHash<QByteArray, int> &nameIndex) const;
+
+    bool m_removeUnused = false;
 };
 
 #endif // DEPENDENCYSORTER_H
@@ -0,0 +1,350 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "gnuhashoptimizer.h"
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfgnuhashsection.h>
+#include <elf/elfheader.h>
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfsectionheader.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+#include <elf/elfsysvhashsection.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+#include <elf.h>
+
+GnuHashOptimizer::GnuHashOptimizer(ElfFile* file) :
+    m_file(file)
+{
+    assert(file);
+    const auto hashIndex = file->indexOfSection(SHT_GNU_HASH);
+    if (hashIndex < 0)
+        return;
+    const auto hashSection = file->section<ElfGnuHashSection>(hashIndex);
+    const auto symTab = hashSection->linkedSection<ElfSymbolTableSection>();
+    if (!symTab)
+        return;
+
+    m_symbolIndex = hashSection->symbolIndex();
+    for (uint32_t i = m_symbolIndex; i < symTab->header()->entryCount(); ++i) {
+        const auto name = symTab->entry(i)->name();
+        m_exports.push_back({ QByteArray(name), ElfGnuHashSection::hash(name) });
+    }
+}
+
+bool GnuHashOptimizer::isValid() const
+{
+    return m_symbolIndex > 0 && m_file->header()->machine() != EM_MIPS;
+}
+
+static bool isSameFile(ElfFile *lhs, ElfFile *rhs)
+{
+    return QFileInfo(lhs->fileName()).canonicalFilePath() == QFileInfo(rhs->fileName()).canonicalFilePath();
+}
+
+int GnuHashOptimizer::addImports(ElfFileSet* fileSet)
+{
+    int count = 0;
+    for (int i = 0; i < fileSet->size(); ++i) {
+        const auto file = fileSet->file(i);
+        if (isSameFile(file, m_file))
+            continue;
+        const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+        if (!symTab)
+            continue;
+        for (uint32_t j = 1; j < symTab->header()->entryCount(); ++j) {
+            const auto entry = symTab->entry(j);
+            if (entry->sectionIndex() != SHN_UNDEF || strlen(entry->name()) == 0)
+                continue;
+            m_imports.push_back({ QByteArray(entry->name()), ElfGnuHashSection::hash(entry->name()) });
+            ++count;
+        }
+    }
+    return count;
+}
+
+int GnuHashOptimizer::addExportsAsImports()
+{
+    m_imports += m_exports;
+    return m_exports.size();
+}
+
+int GnuHashOptimizer::removeExports(const QSet<QByteArray>& names)
+{
+    const auto it = std::remove_if(m_exports.begin(), m_exports.end(), [&names](const Symbol &symbol) {
+        return names.contains(symbol.name);
+    });
+    const int count = std::distance(it, m_exports.end());
+    m_exports.erase(it, m_exports.end());
+    m_exportsRemoved |= count > 0;
+    return count;
+}
+
+double GnuHashOptimizer::Estimate::probesPerLookup() const
+{
+    if (lookups == 0)
+        return 0.0;
+    return (double)(stats.bloomProbes + stats.chainWalks + stats.strcmpCalls) / (double)lookups;
+}
+
+double GnuHashOptimizer::Estimate::bloomFalsePositiveRate() const
+{
+    if (misses == 0)
+        return 0.0;
+    return (double)stats.bloomFalsePositives / (double)misses;
+}
+
+GnuHashOptimizer::Parameters GnuHashOptimizer::currentParameters() const
+{
+    Parameters params;
+    const auto hashIndex = m_file->indexOfSection(SHT_GNU_HASH);
+    if (hashIndex < 0)
+        return params;
+    const auto hashSection = m_file->section<ElfGnuHashSection>(hashIndex);
+    params.bucketCount = hashSection->bucketCount();
+    params.maskWordsCount = hashSection->maskWordsCount();
+    params.shift2 = hashSection->shift2();
+    return params;
+}
+
+uint64_t GnuHashOptimizer::tableSize(const Parameters& params) const
+{
+    return 4 * sizeof(uint32_t) + params.maskWordsCount * m_file->addressSize() + (params.bucketCount + m_exports.size()) * sizeof(uint32_t);
+}
+
+GnuHashOptimizer::Estimate GnuHashOptimizer::simulate(const Parameters& params) const
+{
+    assert(params.bucketCount > 0);
+    assert(params.maskWordsCount > 0 && (params.maskWordsCount & (params.maskWordsCount - 1)) == 0);
+    assert(params.shift2 < 32);
+
+    Estimate estimate;
+    estimate.parameters = params;
+    estimate.tableSize = tableSize(params);
+
+    // build the table the same way the linker does, see ElfGnuHashSection::lookup for the lookup side
+    const uint32_t c = m_file->addressSize() * 8;
+    QVector<uint64_t> bloom(params.maskWordsCount, 0);
+    QVector<QVector<int>> buckets(params.bucketCount);
+    for (int i = 0; i < m_exports.size(); ++i) {
+        const auto h = m_exports.at(i).hash;
+        bloom[(h / c) & (params.maskWordsCount - 1)] |= (1ull << (h & (c - 1))) | (1ull << ((h >> params.shift2) & (c - 1)));
+        buckets[h % params.bucketCount].push_back(i);
+    }
+
+    auto &stats = estimate.stats;
+    foreach (const auto &import, m_imports) {
+        ++estimate.lookups;
+        ++stats.bloomProbes;
+        const auto h1 = import.hash;
+        const auto bitmask = bloom.at((h1 / c) & (params.maskWordsCount - 1));
+        if (((bitmask >> (h1 & (c - 1))) & (bitmask >> ((h1 >> params.shift2) & (c - 1))) & 1) == 0) {
+            ++estimate.misses;
+            continue;
+        }
+
+        bool found = false;
+        foreach (auto idx, buckets.at(h1 % params.bucketCount)) {
+            ++stats.chainWalks;
+            const auto &symbol = m_exports.at(idx);
+            if ((symbol.hash & ~1u) != (h1 & ~1u))
+                continue;
+            ++stats.strcmpCalls;
+            int prefix = 0;
+            while (prefix < symbol.name.size() && prefix < import.name.size() && symbol.name.at(prefix) == import.name.at(prefix))
+                ++prefix;
+            stats.bytesCompared += prefix + 1;
+            if (symbol.name == import.name) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            ++estimate.misses;
+            ++stats.bloomFalsePositives;
+        }
+    }
+
+    return estimate;
+}
+
+static uint64_t lookupCost(const GnuHashOptimizer::Estimate &estimate)
+{
+    return estimate.stats.bloomProbes + estimate.stats.chainWalks + estimate.stats.strcmpCalls;
+}
+
+GnuHashOptimizer::Estimate GnuHashOptimizer::optimize() const
+{
+    const auto current = currentParameters();
+    auto best = simulate(current);
+    const auto sizeLimit = tableSize(current);
+
+    // trade bloom filter size against bucket count within the space of the existing table
+    for (uint32_t maskWords = 1; tableSize({ 1, maskWords, 0 }) <= sizeLimit; maskWords *= 2) {
+        Parameters params;
+        params.maskWordsCount = maskWords;
+        params.bucketCount = (sizeLimit - tableSize({ 0, maskWords, 0 })) / sizeof(uint32_t);
+        // more buckets than symbols only adds empty buckets, and an odd count spreads better
+        params.bucketCount = std::min<uint32_t>(params.bucketCount, std::max(1, m_exports.size()));
+        if (params.bucketCount > 1 && (params.bucketCount % 2) == 0)
+            --params.bucketCount;
+
+        // shift2 selects the second bloom bit from the 32 bit hash value
+        for (params.shift2 = 1; params.shift2 < 32; ++params.shift2) {
+            const auto estimate = simulate(params);
+            if (lookupCost(estimate) < lookupCost(best) || (lookupCost(estimate) == lookupCost(best) && estimate.tableSize < best.tableSize))
+                best = estimate;
+        }
+    }
+
+    return best;
+}
+
+bool GnuHashOptimizer::write(const Parameters& params, const QString& outputFileName) const
+{
+    if (!isValid() || params.bucketCount == 0 || params.maskWordsCount == 0 || (params.maskWordsCount & (params.maskWordsCount - 1)) != 0 || params.shift2 >= 32) {
+        qWarning() << "Invalid hash table parameters for" << m_file->fileName();
+        return false;
+    }
+    if (m_exportsRemoved) {
+        qWarning() << "Can't write a hash table with removed exports for" << m_file->fileName();
+        return false;
+    }
+    if (tableSize(params) > tableSize(currentParameters())) {
+        qWarning() << "New hash table does not fit into the existing .gnu.hash section of" << m_file->fileName();
+        return false;
+    }
+    // the symbol indexes in APS2 packed relocations would need re-encoding after the .dynsym reordering
+    foreach (const auto shdr, m_file->sectionHeaders()) {
+        if (shdr->type() == SHT_ANDROID_REL || shdr->type() == SHT_ANDROID_RELA) {
+            qWarning() << "Can't reorder .dynsym with Android packed relocations in" << m_file->fileName();
+            return false;
+        }
+    }
+    if (QFileInfo(outputFileName).canonicalFilePath() == QFileInfo(m_file->fileName()).canonicalFilePath()) {
+        qWarning() << "Refusing to overwrite" << m_file->fileName();
+        return false;
+    }
+
+    QFile::remove(outputFileName);
+    if (!QFile::copy(m_file->fileName(), outputFileName)) {
+        qWarning() << "Can't copy" << m_file->fileName() << "to" << outputFileName;
+        return false;
+    }
+
+    ElfFile newFile(outputFileName);
+    if (!newFile.open(QFile::ReadWrite) || !newFile.isValid()) {
+        qWarning() << "Can't open" << outputFileName << "for writing.";
+        return false;
+    }
+
+    const auto hashSection = newFile.section<ElfGnuHashSection>(newFile.indexOfSection(SHT_GNU_HASH));
+    const auto symTab = hashSection->linkedSection<ElfSymbolTableSection>();
+    assert(symTab);
+    const auto symTabIndex = symTab->header()->sectionIndex();
+    const auto symCount = symTab->header()->entryCount();
+    assert(symCount == m_symbolIndex + m_exports.size());
+
+    // the hashed part of .dynsym has to be sorted by bucket
+    QVector<uint32_t> newOrder(m_exports.size());
+    std::iota(newOrder.begin(), newOrder.end(), 0);
+    std::stable_sort(newOrder.begin(), newOrder.end(), [this, &params](uint32_t lhs, uint32_t rhs) {
+        return m_exports.at(lhs).hash % params.bucketCount < m_exports.at(rhs).hash % params.bucketCount;
+    });
+    QVector<uint32_t> newIndex(symCount);
+    std::iota(newIndex.begin(), newIndex.end(), 0);
+    for (int i = 0; i < newOrder.size(); ++i)
+        newIndex[m_symbolIndex + newOrder.at(i)] = m_symbolIndex + i;
+
+    const auto permute = [this, &newOrder](unsigned char *data, uint64_t entrySize) {
+        const auto begin = data + m_symbolIndex * entrySize;
+        const QByteArray oldData(reinterpret_cast<const char*>(begin), newOrder.size() * entrySize);
+        for (int i = 0; i < newOrder.size(); ++i)
+            memcpy(begin + i * entrySize, oldData.constData() + newOrder.at(i) * entrySize, entrySize);
+    };
+    permute(symTab->rawData(), symTab->header()->entrySize());
+
+    foreach (const auto shdr, newFile.sectionHeaders()) {
+        if (shdr->link() != symTabIndex)
+            continue;
+        if (shdr->type() == SHT_GNU_versym) {
+            permute(newFile.rawData() + shdr->sectionOffset(), sizeof(uint16_t));
+        } else if (shdr->type() == SHT_REL || shdr->type() == SHT_RELA) {
+            // r_info is address sized and follows r_offset, with the symbol index in the upper bits
+            auto data = newFile.rawData() + shdr->sectionOffset() + newFile.addressSize();
+            for (uint64_t j = 0; j < shdr->entryCount(); ++j, data += shdr->entrySize()) {
+                const auto info = newFile.readPointer(data);
+                if (newFile.type() == ELFCLASS64)
+                    newFile.writePointer(data, ELF64_R_INFO(newIndex.at(ELF64_R_SYM(info)), ELF64_R_TYPE(info)));
+                else
+                    newFile.writePointer(data, ELF32_R_INFO(newIndex.at(ELF32_R_SYM(info)), ELF32_R_TYPE(info)));
+            }
+        } else if (shdr->type() == SHT_HASH) {
+            auto table = newFile.rawData() + shdr->sectionOffset();
+            const auto bucketCount = newFile.readUInt32(table);
+            auto buckets = table + 2 * sizeof(uint32_t);
+            auto chains = buckets + bucketCount * sizeof(uint32_t);
+            memset(buckets, 0, (bucketCount + newFile.readUInt32(table + sizeof(uint32_t))) * sizeof(uint32_t));
+            for (uint32_t j = symCount - 1; j > 0; --j) {
+                const auto b = ElfSysvHashSection::hash(symTab->entry(j)->name()) % bucketCount;
+                newFile.writeUInt32(chains + j * sizeof(uint32_t), newFile.readUInt32(buckets + b * sizeof(uint32_t)));
+                newFile.writeUInt32(buckets + b * sizeof(uint32_t), j);
+            }
+        }
+    }
+
+    // rebuild .gnu.hash, in the byte order of the file
+    auto data = hashSection->rawData();
+    memset(data, 0, hashSection->size());
+    newFile.writeUInt32(data, params.bucketCount);
+    newFile.writeUInt32(data + sizeof(uint32_t), m_symbolIndex);
+    newFile.writeUInt32(data + 2 * sizeof(uint32_t), params.maskWordsCount);
+    newFile.writeUInt32(data + 3 * sizeof(uint32_t), params.shift2);
+
+    const uint32_t c = newFile.addressSize() * 8;
+    auto bloom = data + 4 * sizeof(uint32_t);
+    auto buckets = bloom + params.maskWordsCount * newFile.addressSize();
+    auto values = buckets + params.bucketCount * sizeof(uint32_t);
+    for (int i = 0; i < newOrder.size(); ++i) {
+        const auto h = m_exports.at(newOrder.at(i)).hash;
+        const auto word = bloom + ((h / c) & (params.maskWordsCount - 1)) * newFile.addressSize();
+        const auto bits = (1ull << (h & (c - 1))) | (1ull << ((h >> params.shift2) & (c - 1)));
+        newFile.writePointer(word, newFile.readPointer(word) | bits);
+
+        const auto b = h % params.bucketCount;
+        const auto bucket = buckets + b * sizeof(uint32_t);
+        if (newFile.readUInt32(bucket) == 0)
+            newFile.writeUInt32(bucket, m_symbolIndex + i);
+        auto value = h & ~1u;
+        if (i == newOrder.size() - 1 || m_exports.at(newOrder.at(i + 1)).hash % params.bucketCount != b)
+            value |= 1;
+        newFile.writeUInt32(values + i * sizeof(uint32_t), value);
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNUHASHOPTIMIZER_H
+#define GNUHASHOPTIMIZER_H
+
+#include <elf/elfhashsection.h>
+
+#include <QByteArray>
+#include <QSet>
+#include <QVector>
+
+#include <cstdint>
+
+class ElfFile;
+class ElfFileSet;
+
+class QString;
+
+/** Evaluates alternative .gnu.hash parameters for a library against the symbols its
+ *  dependents actually import, and rebuilds the table with the best ones.
+ */
+class GnuHashOptimizer
+{
+public:
+    explicit GnuHashOptimizer(ElfFile *file);
+    GnuHashOptimizer(const GnuHashOptimizer&) = default;
+    ~GnuHashOptimizer() = default;
+
+    GnuHashOptimizer& operator=(const GnuHashOptimizer&) = default;
+
+    /** Returns @c false if @p file has no .gnu.hash section that can be rebuilt. */
+    bool isValid() const;
+
+    /** Adds the undefined symbols of all files in @p fileSet except the optimized library
+     *  as lookups to replay. Returns the number of imports added.
+     */
+    int addImports(ElfFileSet *fileSet);
+    /** Adds the symbols exported by the library itself, as an approximation if no dependents are available. */
+    int addExportsAsImports();
+    /** Drop @p names from the simulated table, to evaluate a smaller export set.
+     *  Such a table can't be written. Returns the number of removed symbols.
+     */
+    int removeExports(const QSet<QByteArray> &names);
+
+    struct Parameters {
+        uint32_t bucketCount = 0;
+        uint32_t maskWordsCount = 0;
+        uint32_t shift2 = 0;
+    };
+
+    struct Estimate {
+        Parameters parameters;
+        uint64_t tableSize = 0;
+        uint64_t lookups = 0;
+        uint64_t misses = 0;
+        ElfHashSection::LookupStatistics stats;
+
+        /** Bloom filter probes, hash chain entries and string comparisons per lookup. */
+        double probesPerLookup() const;
+        /** Fraction of lookups for symbols not in the table that pass the bloom filter. */
+        double bloomFalsePositiveRate() const;
+    };
+
+    /** Parameters of the existing table. */
+    Parameters currentParameters() const;
+    /** Size of a table with @p params, for the symbols hashed by the existing table. */
+    uint64_t tableSize(const Parameters &params) const;
+
+    /** Replay all imports against a table built with @p params. */
+    Estimate simulate(const Parameters &params) const;
+    /** Best parameters that fit into the space of the existing table. */
+    Estimate optimize() const;
+
+    /** Write a copy of the library to @p outputFileName with .gnu.hash rebuilt for @p params.
+     *  This reorders the hashed part of .dynsym, and updates .gnu.version, .hash and all
+     *  dynamic relocations accordingly.
+     */
+    bool write(const Parameters &params, const QString &outputFileName) const;
+
+private:
+    struct Symbol {
+        QByteArray name;
+        uint32_t hash;
+    };
+
+    ElfFile *m_file;
+    uint32_t m_symbolIndex = 0;
+    QVector<Symbol> m_exports;
+    QVector<Symbol> m_imports;
+    bool m_exportsRemoved = false;
+};
+
+#endif // GNUHASHOPTIMIZER_H
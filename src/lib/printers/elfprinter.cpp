@@ -18,6 +18,9 @@
 #include "elfprinter.h"
 #include "printerutils_p.h"
 
+#include <elf/elfpackedrelocationsection.h>
+#include <elf/elfrelrsection.h>
+
 #include <elf.h>
 
 #include <QByteArray>
@@ -69,6 +72,11 @@ static const LookupTableEntry<uint32_t> section_type_table[] {
     { SHT_PREINIT_ARRAY, "array of preconstructors" },
     { SHT_GROUP, "section group" },
     { SHT_SYMTAB_SHNDX, "extended section indices" },
+    { SHT_RELR, "relative relocations" },
+
+    { SHT_ANDROID_REL, "Android packed relocation entries, no addends" },
+    { SHT_ANDROID_RELA, "Android packed relocation entries with addends" },
+    { SHT_ANDROID_RELR, "Android relative relocations" },
 
     { SHT_GNU_ATTRIBUTES, "GNU object attributes" },
     { SHT_GNU_HASH, "GNU-style hash table" },
@@ -34,6 +34,7 @@
 
 #include <disassmbler/disassembler.h>
 #include <demangle/demangler.h>
+#include <checks/dirtypagescheck.h>
 #include <checks/structurepackingcheck.h>
 #include <navigator/codenavigatorprinter.h>
 
@@ -137,7 +138,13 @@ QVariant DataVisitor::doVisit(ElfFile* file, int arg) const
                 s += "<td>0x" + QString::number(phdr->alignment(), 16) + "</td>";
                 s += QLatin1String("</tr>");
             }
-            s += QLatin1String("</table");
+            s += QLatin1String("</table>");
+
+            if (!file->isSeparateDebugFile()) {
+                DirtyPagesCheck dirtyPagesCheck;
+                s += QLatin1String("<br/><b>Private Pages</b><br/>");
+                s += dirtyPagesCheck.printResult(dirtyPagesCheck.analyze(file));
+            }
             return s;
         }
         case ElfModel::FileRole:
@@ -18,6 +18,7 @@
 #include "loadbenchmarkmodel.h"
 
 #include <checks/ldbenchmark.h>
+#include <checks/loadcostmodel.h>
 #include <elf/elffile.h>
 
 LoadBenchmarkModel::LoadBenchmarkModel(QObject* parent): QAbstractTableModel(parent)
@@ -30,9 +31,59 @@ void LoadBenchmarkModel::setBenchmark(const std::shared_ptr< LDBenchmark >& data
 {
     beginResetModel();
     m_data = data;
+    m_features.clear();
+    m_lazyPredictions.clear();
+    m_nowPredictions.clear();
+    if (m_data) {
+        m_features.reserve(m_data->size());
+        for (int i = 0; i < m_data->size(); ++i)
+            m_features.push_back(LoadCostModel::features(m_data->file(i)));
+        refit();
+    }
     endResetModel();
 }
 
+void LoadBenchmarkModel::benchmarkUpdated()
+{
+    if (!m_data || m_data->size() == 0)
+        return;
+    // only the measurements change while the benchmark is running
+    emit dataChanged(index(0, 1), index(rowCount() - 1, 4));
+    emit dataChanged(index(0, 8), index(rowCount() - 1, 10));
+}
+
+void LoadBenchmarkModel::benchmarkFinished()
+{
+    if (!m_data || m_data->size() == 0)
+        return;
+
+    refit();
+    emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+}
+
+void LoadBenchmarkModel::refit()
+{
+    m_lazyPredictions.clear();
+    m_nowPredictions.clear();
+
+    LoadCostModel costModel;
+    for (int i = 0; i < m_data->size(); ++i) {
+        if (m_data->statistics(LDBenchmark::LoadMode::Lazy, i).samples == 0 || m_data->statistics(LDBenchmark::LoadMode::Now, i).samples == 0)
+            continue;
+        costModel.addSample(m_features.at(i), m_data->median(LDBenchmark::LoadMode::Lazy, i), m_data->median(LDBenchmark::LoadMode::Now, i));
+    }
+    // nothing measured yet, e.g. right after the benchmark started
+    if (costModel.sampleCount() == 0 || !costModel.fit())
+        return;
+
+    m_lazyPredictions.reserve(m_features.size());
+    m_nowPredictions.reserve(m_features.size());
+    foreach (const auto &features, m_features) {
+        m_lazyPredictions.push_back(costModel.predict(LDBenchmark::LoadMode::Lazy, features));
+        m_nowPredictions.push_back(costModel.predict(LDBenchmark::LoadMode::Now, features));
+    }
+}
+
 QVariant LoadBenchmarkModel::data(const QModelIndex& index, int role) const
 {
     if (!m_data || !index.isValid())
@@ -46,6 +97,23 @@ QVariant LoadBenchmarkModel::data(const QModelIndex& index, int role) const
             case 3: return m_data->median(LDBenchmark::LoadMode::Now, index.row());
             case 4: return m_data->min(LDBenchmark::LoadMode::Now, index.row());
             case 5: return m_data->file(index.row())->reverseRelocator()->size();
+            case 6:
+                if (m_lazyPredictions.isEmpty())
+                    return {};
+                return m_lazyPredictions.at(index.row());
+            case 7:
+                if (m_nowPredictions.isEmpty())
+                    return {};
+                return m_nowPredictions.at(index.row());
+            case 8:
+            case 9:
+            case 10:
+            {
+                const auto phase = m_data->statistics(LDBenchmark::LoadMode::Now, index.row()).phases[index.column() - 8];
+                if (phase < 0.0)
+                    return {};
+                return phase;
+            }
         }
     }
     return {};
@@ -54,7 +122,7 @@ QVariant LoadBenchmarkModel::data(const QModelIndex& index, int role) const
 int LoadBenchmarkModel::columnCount(const QModelIndex& parent) const
 {
     Q_UNUSED(parent);
-    return 6;
+    return 11;
 }
 
 int LoadBenchmarkModel::rowCount(const QModelIndex& parent) const
@@ -74,6 +142,11 @@ QVariant LoadBenchmarkModel::headerData(int section, Qt::Orientation orientation
             case 3: return tr("Now Median");
             case 4: return tr("Now Min");
             case 5: return tr("Relocs");
+            case 6: return tr("Lazy Model");
+            case 7: return tr("Now Model");
+            case 8: return tr("Now Search");
+            case 9: return tr("Now Map");
+            case 10: return tr("Now Relocation");
         }
     }
     return QAbstractItemModel::headerData(section, orientation, role);
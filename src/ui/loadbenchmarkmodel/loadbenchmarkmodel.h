@@ -19,6 +19,7 @@
 #define LOADBENCHMARKMODEL_H
 
 #include <QAbstractTableModel>
+#include <QVector>
 
 #include <memory>
 
@@ -33,6 +34,10 @@ public:
     ~LoadBenchmarkModel();
 
     void setBenchmark(const std::shared_ptr<LDBenchmark> &data);
+    /** Update after new results became available in the current benchmark. */
+    void benchmarkUpdated();
+    /** Update after the current benchmark completed, this also refits the load cost model. */
+    void benchmarkFinished();
 
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -40,7 +45,15 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
 private:
+    /** Refit the load cost model to the measured files, and update the predictions. */
+    void refit();
+
     std::shared_ptr<LDBenchmark> m_data;
+    /** Load cost model features per row, extracting those is expensive. */
+    QVector<QVector<double>> m_features;
+    /** Predicted load cost per row, empty without a fitted model. */
+    QVector<double> m_lazyPredictions;
+    QVector<double> m_nowPredictions;
 };
 
 #endif // LOADBENCHMARKMODEL_H
@@ -135,6 +135,8 @@ void MainWindow::loadFile(const QString& fileName)
         return;
     setWindowFilePath(fileName);
 
+    // stop a running benchmark before the files it uses go away
+    ui->loadTimeView->setFileSet(nullptr);
     m_fileSet.reset(new ElfFileSet(this));
     m_fileSet->addFile(fileName);
 
@@ -49,6 +49,11 @@ void Gnuplotter::setTemplate(const QString& templateFileName)
     m_templateFileName = templateFileName;
 }
 
+void Gnuplotter::setTemplateArgument(const QByteArray& name, const QByteArray& value)
+{
+    m_templateArgs.insert(name, value);
+}
+
 void Gnuplotter::setSize(const QSize& size)
 {
     m_outputSize = size;
@@ -99,6 +104,8 @@ void Gnuplotter::processTemplate() const
 
     auto t = in.readAll();
     t.replace("@TEXTCOLOR@", QGuiApplication::palette().color(QPalette::Text).name().toUtf8());
+    for (auto it = m_templateArgs.constBegin(); it != m_templateArgs.constEnd(); ++it)
+        t.replace('@' + it.key() + '@', it.value());
 
     out.write(t);
 }
@@ -18,6 +18,8 @@
 #ifndef GNUPLOTTER_H
 #define GNUPLOTTER_H
 
+#include <QByteArray>
+#include <QHash>
 #include <QSize>
 #include <QString>
 
@@ -41,6 +43,8 @@ public:
 
     void setSize(const QSize &size);
     void setTemplate(const QString &templateFileName);
+    /** Replace @p name enclosed in '@' in the template by @p value. */
+    void setTemplateArgument(const QByteArray &name, const QByteArray &value);
 
     QString workingDir() const;
     QString imageFileName() const;
@@ -53,6 +57,7 @@ private:
     void processTemplate() const;
 
     QString m_templateFileName;
+    QHash<QByteArray, QByteArray> m_templateArgs;
     QSize m_outputSize = { 1024, 786 };
     // QTemporaryDir is not movable :-(
     std::unique_ptr<QTemporaryDir> m_tempDir;
@@ -14,7 +14,18 @@ nowSum=0
 sumLazy(x) = (lazySum = lazySum + x, lazySum)
 sumNow(x)  = (nowSum = nowSum + x, nowSum)
 
-plot 'ldbenchmark.csv' using 0:(sumLazy($2)):($2-$3) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
-     'ldbenchmark.csv' using 0:2:xticlabels(1) with lines smooth cumulative title "RTLD_LAZY" linecolor rgb "#bf0303", \
-     'ldbenchmark.csv' using 0:(sumNow($5)):($5-$6) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
-     'ldbenchmark.csv' using 0:5 with lines smooth cumulative title "RTLD_NOW" linecolor rgb "#2C72C7"
+# columns 8 to 10 only exist with phase timing enabled
+if (@PHASETIMING@) {
+    plot 'ldbenchmark.csv' using 0:(sumLazy($2)):($2-$3) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
+         'ldbenchmark.csv' using 0:2:xticlabels(1) with lines smooth cumulative title "RTLD_LAZY" linecolor rgb "#bf0303", \
+         'ldbenchmark.csv' using 0:(sumNow($5)):($5-$6) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
+         'ldbenchmark.csv' using 0:5 with lines smooth cumulative title "RTLD_NOW" linecolor rgb "#2C72C7", \
+         'ldbenchmark.csv' using 0:8 with lines smooth cumulative title "search" linecolor rgb "#f67400" dashtype 2, \
+         'ldbenchmark.csv' using 0:9 with lines smooth cumulative title "map" linecolor rgb "#27ae60" dashtype 2, \
+         'ldbenchmark.csv' using 0:10 with lines smooth cumulative title "relocation" linecolor rgb "#8e44ad" dashtype 2
+} else {
+    plot 'ldbenchmark.csv' using 0:(sumLazy($2)):($2-$3) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
+         'ldbenchmark.csv' using 0:2:xticlabels(1) with lines smooth cumulative title "RTLD_LAZY" linecolor rgb "#bf0303", \
+         'ldbenchmark.csv' using 0:(sumNow($5)):($5-$6) with yerrorbars notitle linecolor rgb "#808080" pointsize 0, \
+         'ldbenchmark.csv' using 0:5 with lines smooth cumulative title "RTLD_NOW" linecolor rgb "#2C72C7"
+}
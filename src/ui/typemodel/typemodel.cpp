@@ -26,6 +26,7 @@
 #include <dwarf/dwarfcudie.h>
 #endif
 #include <printers/dwarfprinter.h>
+#include <checks/cachelinecheck.h>
 #include <checks/structurepackingcheck.h>
 
 #if HAVE_DWARF
@@ -227,6 +228,12 @@ QVariant TypeModel::data(const QModelIndex& index, int role) const
                 check.setElfFileSet(m_fileSet);
                 s += check.checkOneStructure(node.die).toHtmlEscaped();
                 s += QLatin1String("</pre></tt><br/>");
+
+                s += QLatin1String("<tt><pre>");
+                CacheLineCheck cacheLineCheck;
+                cacheLineCheck.setElfFileSet(m_fileSet);
+                s += cacheLineCheck.checkOneStructure(node.die).toHtmlEscaped();
+                s += QLatin1String("</pre></tt><br/>");
             }
 
             return s;
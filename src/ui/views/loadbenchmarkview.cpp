@@ -19,6 +19,7 @@
 #include "ui_loadbenchmarkview.h"
 
 #include <checks/ldbenchmark.h>
+#include <checks/ldbenchmarkjob.h>
 #include <plotter/gnuplotter.h>
 #include <loadbenchmarkmodel/loadbenchmarkmodel.h>
 
@@ -31,37 +32,105 @@ LoadBenchmarkView::LoadBenchmarkView(QWidget* parent):
 {
     ui->setupUi(this);
     ui->runButton->setDefaultAction(ui->actionRunBenchmark);
+    ui->cancelButton->setDefaultAction(ui->actionCancelBenchmark);
+    ui->progressBar->hide();
     auto proxy = new QSortFilterProxyModel(this);
     proxy->setSourceModel(m_model);
     ui->dataView->setModel(proxy);
 
     ui->actionRunBenchmark->setEnabled(Gnuplotter::hasGnuplot());
     connect(ui->actionRunBenchmark, &QAction::triggered, this, &LoadBenchmarkView::runBenchmark);
+    connect(ui->actionCancelBenchmark, &QAction::triggered, this, [this]() {
+        if (m_job)
+            m_job->cancel();
+    });
 
-    addActions({ ui->actionRunBenchmark });
+    addActions({ ui->actionRunBenchmark, ui->actionCancelBenchmark });
 }
 
 LoadBenchmarkView::~LoadBenchmarkView() = default;
 
 void LoadBenchmarkView::setFileSet(ElfFileSet* fileSet)
 {
+    // results of the previous set refer to its files, which are about to be deleted
+    if (m_job) {
+        m_job->disconnect(this);
+        delete m_job;
+        m_job = nullptr;
+    }
+    m_model->setBenchmark(nullptr);
+    m_benchmark.reset();
+    ui->plotter->setPlotter(Gnuplotter());
+    ui->plotter->clear();
+
+    ui->actionRunBenchmark->setEnabled(Gnuplotter::hasGnuplot());
+    ui->actionCancelBenchmark->setEnabled(false);
+    ui->phaseTimingBox->setEnabled(true);
+    ui->progressBar->hide();
+
     m_fileSet = fileSet;
 }
 
 void LoadBenchmarkView::runBenchmark()
 {
-    if (!m_fileSet)
+    if (!m_fileSet || m_job)
         return;
 
     m_benchmark = std::make_shared<LDBenchmark>();
-    m_benchmark->measureFileSet(m_fileSet);
-
+    // auditing adds its own overhead, so only do that on request
+    m_benchmark->setPhaseTiming(ui->phaseTimingBox->isChecked());
+    m_job = new LDBenchmarkJob(m_benchmark, this);
+    connect(m_job, &LDBenchmarkJob::progress, this, &LoadBenchmarkView::benchmarkProgress);
+    connect(m_job, &LDBenchmarkJob::finished, this, &LoadBenchmarkView::benchmarkFinished);
+    m_job->start(m_fileSet);
+
+    // results are filled in as the benchmark progresses
     Gnuplotter plotter;
     plotter.setSize(ui->plotter->size());
     plotter.setTemplate(QStringLiteral(":/ldbenchmark.gnuplot"));
-
-    m_benchmark->writeCSV(plotter.workingDir() + "/ldbenchmark.csv");
+    plotter.setTemplateArgument("PHASETIMING", ui->phaseTimingBox->isChecked() ? "1" : "0");
+    m_plotDir = plotter.workingDir();
+    m_benchmark->writeCSV(m_plotDir + "/ldbenchmark.csv");
     ui->plotter->setPlotter(std::move(plotter));
+    m_plotTimer.start();
 
     m_model->setBenchmark(m_benchmark);
+
+    ui->actionRunBenchmark->setEnabled(false);
+    ui->actionCancelBenchmark->setEnabled(true);
+    ui->phaseTimingBox->setEnabled(false);
+    ui->progressBar->setValue(0);
+    ui->progressBar->show();
+}
+
+void LoadBenchmarkView::benchmarkProgress(int completed, int maximum)
+{
+    ui->progressBar->setMaximum(maximum);
+    ui->progressBar->setValue(completed);
+    m_model->benchmarkUpdated();
+
+    // plotting is done synchronously, so don't do that for every single run
+    if (m_plotTimer.elapsed() > 1000)
+        updatePlot();
+}
+
+void LoadBenchmarkView::benchmarkFinished()
+{
+    m_job->deleteLater();
+    m_job = nullptr;
+
+    m_model->benchmarkFinished();
+    updatePlot();
+
+    ui->actionRunBenchmark->setEnabled(true);
+    ui->actionCancelBenchmark->setEnabled(false);
+    ui->phaseTimingBox->setEnabled(true);
+    ui->progressBar->hide();
+}
+
+void LoadBenchmarkView::updatePlot()
+{
+    m_benchmark->writeCSV(m_plotDir + "/ldbenchmark.csv");
+    ui->plotter->replot();
+    m_plotTimer.restart();
 }
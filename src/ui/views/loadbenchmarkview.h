@@ -18,6 +18,7 @@
 #ifndef LOADBENCHMARKVIEW_H
 #define LOADBENCHMARKVIEW_H
 
+#include <QElapsedTimer>
 #include <QWidget>
 
 #include <memory>
@@ -27,6 +28,7 @@ class LoadBenchmarkView;
 }
 class LoadBenchmarkModel;
 class LDBenchmark;
+class LDBenchmarkJob;
 
 class ElfFileSet;
 
@@ -41,12 +43,19 @@ public:
 
 private slots:
     void runBenchmark();
+    void benchmarkProgress(int completed, int maximum);
+    void benchmarkFinished();
 
 private:
+    void updatePlot();
+
     std::unique_ptr<Ui::LoadBenchmarkView> ui;
     ElfFileSet *m_fileSet = nullptr;
     LoadBenchmarkModel *m_model;
     std::shared_ptr<LDBenchmark> m_benchmark;
+    LDBenchmarkJob *m_job = nullptr;
+    QString m_plotDir;
+    QElapsedTimer m_plotTimer;
 };
 
 #endif // LOADBENCHMARKVIEW_H
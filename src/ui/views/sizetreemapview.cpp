@@ -15,6 +15,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "config-elf-dissector.h"
 #include "sizetreemapview.h"
 #include "ui_sizetreemapview.h"
 
@@ -26,6 +27,12 @@
 #include <elf/elffile.h>
 #include <elf/elfsymboltablesection.h>
 #include <demangle/demangler.h>
+#include <checks/debuginfosizecheck.h>
+#if HAVE_DWARF
+#include <dwarf/dwarfinfo.h>
+#include <dwarf/dwarfdie.h>
+#include <dwarf/dwarfcudie.h>
+#endif
 
 #include <QMenu>
 #include <QSettings>
@@ -54,6 +61,7 @@ SizeTreeMapView::SizeTreeMapView(QWidget* parent) :
     ui->actionColorizeSections->setData("ColorizeSections");
     ui->actionColorizeSymbols->setData("ColorizeSymbols");
     ui->actionRelocationHeatmap->setData("RelocationHeatmap");
+    ui->actionDebugInfoBreakdown->setData("DebugInfoBreakdown");
 
     auto colorizeGroup = new QActionGroup(this);
     colorizeGroup->setExclusive(true);
@@ -64,6 +72,8 @@ SizeTreeMapView::SizeTreeMapView(QWidget* parent) :
 
     auto separator = new QAction(this);
     separator->setSeparator(true);
+    auto separator2 = new QAction(this);
+    separator2->setSeparator(true);
     addActions({
         ui->actionHideDebugInformation,
         ui->actionHideOccupiesMemory,
@@ -73,7 +83,9 @@ SizeTreeMapView::SizeTreeMapView(QWidget* parent) :
         ui->actionNoColorization,
         ui->actionColorizeSections,
         ui->actionColorizeSymbols,
-        ui->actionRelocationHeatmap
+        ui->actionRelocationHeatmap,
+        separator2,
+        ui->actionDebugInfoBreakdown
     });
 
     foreach (auto action, actions())
@@ -107,6 +119,55 @@ static QColor relocColor(double ratio)
     );
 }
 
+#if HAVE_DWARF
+static void addSize(TreeMapItem *item, quint64 size)
+{
+    item->setSum(item->sum() + size);
+    item->setValue(item->sum());
+    item->setField(1, QString::number(item->sum()));
+}
+
+static void fillDebugInfoTreeMap(TreeMapItem *baseItem, ElfFile *file)
+{
+    DebugInfoSizeCheck check;
+    check.analyze(file->dwarfInfo());
+    baseItem->setSum(check.totalSize());
+
+    struct Node {
+        TreeMapItem *item = nullptr;
+        QHash<QString, TreeMapItem*> children;
+    };
+
+    Colorizer cuColorizer;
+    QHash<const DwarfCuDie*, Node> cuNodes;
+    for (const auto &dieSize : check.topLevelDies()) {
+        auto &cuNode = cuNodes[dieSize.cu];
+        if (!cuNode.item) {
+            cuNode.item = new TreeMapItem(baseItem);
+            cuNode.item->setField(0, QString::fromUtf8(dieSize.cu->name()));
+            cuNode.item->setBackColor(cuColorizer.nextColor());
+        }
+        addSize(cuNode.item, dieSize.size);
+
+        auto fileName = DebugInfoSizeCheck::declaringFile(dieSize.die);
+        if (fileName.isEmpty())
+            fileName = QStringLiteral("<unknown>");
+        auto fileItem = cuNode.children.value(fileName);
+        if (!fileItem) {
+            fileItem = new TreeMapItem(cuNode.item);
+            fileItem->setField(0, fileName);
+            fileItem->setBackColor(cuNode.item->backColor());
+            cuNode.children.insert(fileName, fileItem);
+        }
+        addSize(fileItem, dieSize.size);
+
+        auto item = new TreeMapItem(fileItem, dieSize.size, dieSize.die->displayName(), QString::number(dieSize.size));
+        item->setSum(dieSize.size);
+        item->setBackColor(fileItem->backColor());
+    }
+}
+#endif
+
 void SizeTreeMapView::setModel(QAbstractItemModel* model)
 {
     m_sectionProxy->setSourceModel(model);
@@ -166,6 +227,14 @@ void SizeTreeMapView::reloadTreeMap()
     QSettings settings;
     m_treeMap->setSplitMode(settings.value(QStringLiteral("TreeMap/SplitMode"), "Bisection").toString());
 
+#if HAVE_DWARF
+    if (ui->actionDebugInfoBreakdown->isChecked() && file->dwarfInfo()) {
+        fillDebugInfoTreeMap(baseItem, file);
+        baseItem->setSorting(-2, true, true);
+        return;
+    }
+#endif
+
     struct SymbolNode {
         TreeMapItem *item;
         QHash<QByteArray, SymbolNode*> children;
@@ -268,6 +337,7 @@ void SizeTreeMapView::restoreSettings()
     readCheckedState(ui->actionColorizeSections, false);
     readCheckedState(ui->actionColorizeSymbols, true);
     readCheckedState(ui->actionRelocationHeatmap, false);
+    readCheckedState(ui->actionDebugInfoBreakdown, false);
 }
 
 void SizeTreeMapView::viewActionToggled()
@@ -30,15 +30,14 @@ public:
     ~GnuplotWidget();
 
     void setPlotter(Gnuplotter &&plotter);
+    /** Re-render the plot, eg. after the input data changed. */
+    void replot();
 
     QSize minimumSizeHint() const override;
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
 
-private slots:
-    void replot();
-
 private:
     Gnuplotter m_plotter;
 };
@@ -16,17 +16,24 @@
 */
 
 #include <elf/elffile.h>
+#include <elf/elffileset.h>
 #include <elf/elfsymboltablesection.h>
 #include <elf/elfheader.h>
 #include <elf/elfpltsection.h>
 #include <elf/elfrelocationsection.h>
+#include <elf/elfrelrsection.h>
 #include <elf/elfgotsection.h>
 
 #include <QtTest/qtest.h>
 #include <QObject>
+#include <QTemporaryDir>
 
 #include <elf.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 class ElfFileTest : public QObject
 {
     Q_OBJECT
@@ -82,6 +89,7 @@ private slots:
         }
 
         QVERIFY(f.reverseRelocator());
+        int relocCount = 0;
 
         for (int i = 0; i < f.header()->sectionHeaderCount(); ++i) {
             auto shdr = f.sectionHeaders().at(i);
@@ -89,6 +97,17 @@ private slots:
                 auto section = f.section<ElfRelocationSection>(i);
                 QVERIFY(section);
                 QVERIFY(section->header()->entryCount() > 0);
+                relocCount += section->header()->entryCount();
+            }
+            if (shdr->type() == SHT_RELR) {
+                auto section = f.section<ElfRelrSection>(i);
+                QVERIFY(section);
+                const auto offsets = section->relocationOffsets();
+                QCOMPARE((uint64_t)offsets.size(), section->relocationCount());
+                QVERIFY(std::is_sorted(offsets.begin(), offsets.end()));
+                foreach (auto offset, offsets)
+                    QVERIFY(f.reverseRelocator()->isRelocated(offset));
+                relocCount += offsets.size();
             }
 
             if (QByteArray(shdr->name()).startsWith(".got")) {
@@ -99,10 +118,11 @@ private slots:
                     startIndex = 3; // the first 3 entries are placeholders for lazy symbol resolution
                 for (uint i = startIndex; i < section->header()->entryCount(); ++i) {
                     auto gotEntry = section->entry(i);
-                    QVERIFY(f.reverseRelocator()->find(gotEntry->address()));
+                    QVERIFY(f.reverseRelocator()->isRelocated(gotEntry->address()));
                 }
             }
         }
+        QCOMPARE(f.reverseRelocator()->size(), relocCount);
 
 #ifdef Q_OS_FREEBSD
         // Doesn't seem to have a buildId (w/ clang, anyway)
@@ -114,6 +134,78 @@ private slots:
         QCOMPARE((uint16_t)f.segmentHeaders().size(), f.header()->programHeaderCount());
     }
 
+    void testReadPointer()
+    {
+        ElfFile f(QStringLiteral(BINDIR "single-executable"));
+        QVERIFY(f.open(QFile::ReadOnly));
+        QVERIFY(f.isValid());
+
+        // e_entry follows e_ident, e_type, e_machine and e_version in both ELF classes
+        QCOMPARE(f.readPointer(f.rawData() + EI_NIDENT + 8), f.header()->entryPoint());
+        QCOMPARE(f.readUInt32(f.rawData() + EI_NIDENT + 4), (uint32_t)EV_CURRENT);
+
+        // written in the byte order of the file, LSB here
+        unsigned char buffer[8] = {};
+        f.writeUInt32(buffer, 0x12345678);
+        QCOMPARE(buffer[0], (unsigned char)0x78);
+        QCOMPARE(f.readUInt32(buffer), (uint32_t)0x12345678);
+        f.writePointer(buffer, 0x1122);
+        QCOMPARE(buffer[0], (unsigned char)0x22);
+        QCOMPARE(f.readPointer(buffer), (uint64_t)0x1122);
+    }
+
+    void testIsExecutable()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(set.size() > 1);
+        QVERIFY(set.file(0)->isExecutable());
+        for (int i = 1; i < set.size(); ++i)
+            QVERIFY(!set.file(i)->isExecutable());
+
+        // drop the section header table, only ELF and program headers remain
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto fileName = dir.path() + QLatin1String("/stripped");
+        QVERIFY(QFile::copy(QStringLiteral(BINDIR "single-executable"), fileName));
+        {
+            QFile file(fileName);
+            QVERIFY(file.open(QFile::ReadWrite));
+            auto data = file.readAll();
+            const bool is64 = data.at(EI_CLASS) == ELFCLASS64;
+            const uint16_t shnum = 0;
+            const uint64_t shoff = 0;
+            memcpy(data.data() + (is64 ? offsetof(Elf64_Ehdr, e_shoff) : offsetof(Elf32_Ehdr, e_shoff)), &shoff, is64 ? 8 : 4);
+            memcpy(data.data() + (is64 ? offsetof(Elf64_Ehdr, e_shnum) : offsetof(Elf32_Ehdr, e_shnum)), &shnum, 2);
+            QVERIFY(file.seek(0));
+            QCOMPARE(file.write(data), (qint64)data.size());
+        }
+
+        ElfFile f(fileName);
+        QVERIFY(f.open(QFile::ReadOnly));
+        QCOMPARE(f.sectionCount(), 0);
+        QVERIFY(!f.dynamicSection());
+        QVERIFY(f.isExecutable());
+    }
+
+    void testRelrEncoding()
+    {
+        QVector<uint64_t> offsets;
+        QCOMPARE(ElfRelrSection::encodedSize(offsets, 8), (uint64_t)0);
+        offsets.push_back(0x1000);
+        QCOMPARE(ElfRelrSection::encodedSize(offsets, 8), (uint64_t)8);
+        // the next 63 words fit into a single bitmap
+        for (int i = 1; i < 64; ++i)
+            offsets.push_back(0x1000 + i * 8);
+        QCOMPARE(ElfRelrSection::encodedSize(offsets, 8), (uint64_t)16);
+        offsets.push_back(0x1000 + 64 * 8);
+        QCOMPARE(ElfRelrSection::encodedSize(offsets, 8), (uint64_t)24);
+        // too far away for a bitmap
+        offsets.push_back(0x10000);
+        QCOMPARE(ElfRelrSection::encodedSize(offsets, 8), (uint64_t)32);
+        QCOMPARE(ElfRelrSection::encodedSize({ 0x1000, 0x1004, 0x1008 }, 4), (uint64_t)8);
+    }
+
     void testFailedLoad_data()
     {
         QTest::addColumn<QString>("executable");
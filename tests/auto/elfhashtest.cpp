@@ -23,6 +23,7 @@
 
 #include <QtTest/qtest.h>
 #include <QObject>
+#include <QSet>
 
 #include <elf.h>
 #include <algorithm>
@@ -57,7 +58,8 @@ private slots:
             const auto entry = symTab->entry(i);
             if (strcmp(entry->name(), "") == 0)
                 continue;
-            QCOMPARE(hashSection->lookup(entry->name()), entry);
+            // undefined entries are skipped, like the dynamic linker does
+            QCOMPARE(hashSection->lookup(entry->name()), ElfHashSection::isDefinition(entry) ? entry : nullptr);
         }
 #endif
 
@@ -92,12 +94,65 @@ private slots:
         for (uint32_t i = hashSection->symbolIndex(); i < symTab->header()->entryCount(); ++i) {
             const auto entry = symTab->entry(i);
             QCOMPARE(hashSection->lookup(entry->name()), entry);
+
+            ElfHashSection::LookupStatistics stats;
+            QCOMPARE(hashSection->lookup(entry->name(), &stats), entry);
+            QCOMPARE(stats.bloomProbes, (uint64_t)1);
+            QVERIFY(stats.chainWalks >= 1);
+            QVERIFY(stats.bytesCompared >= stats.strcmpCalls);
         }
 
+        ElfHashSection::LookupStatistics stats;
+        QVERIFY(!hashSection->lookup("this_symbol_does_not_exist_hopefully", &stats));
+        QCOMPARE(stats.bloomProbes, (uint64_t)1);
+
         const auto hist = hashSection->histogram();
         const uint32_t sum = std::accumulate(hist.begin(), hist.end(), 0);
         QCOMPARE(sum, hashSection->bucketCount());
     }
+
+    void testNegativeLookup()
+    {
+        ElfFile f(QStringLiteral(BINDIR "/elf-dissector"));
+        QVERIFY(f.open(QFile::ReadOnly));
+        QVERIFY(f.isValid());
+
+        const auto hashSection = f.hash();
+        QVERIFY(hashSection);
+        const auto symTab = hashSection->linkedSection<ElfSymbolTableSection>();
+        QVERIFY(symTab);
+
+        ElfHashSection::LookupStatistics stats;
+        QVERIFY(!hashSection->lookup("this_symbol_does_not_exist_hopefully"));
+        QVERIFY(!hashSection->lookup("this_symbol_does_not_exist_hopefully", &stats));
+
+        // imports are not found, even though they are in the symbol table
+        int undefinedCount = 0;
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+            const auto entry = symTab->entry(i);
+            if (entry->sectionIndex() != SHN_UNDEF || strcmp(entry->name(), "") == 0)
+                continue;
+            QVERIFY(!ElfHashSection::isDefinition(entry));
+            QVERIFY(!hashSection->lookup(entry->name()));
+            ++undefinedCount;
+        }
+        QVERIFY(undefinedCount > 0);
+
+        // with everything hidden, lookups find nothing and don't walk any chain
+        QSet<QByteArray> hidden;
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i)
+            hidden.insert(symTab->entry(i)->name());
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+            const auto entry = symTab->entry(i);
+            if (!ElfHashSection::isDefinition(entry) || strcmp(entry->name(), "") == 0)
+                continue;
+            QCOMPARE(hashSection->lookup(entry->name()), entry);
+            ElfHashSection::LookupStatistics hiddenStats;
+            QVERIFY(!hashSection->lookup(entry->name(), &hiddenStats, &hidden));
+            QCOMPARE(hiddenStats.chainWalks, (uint64_t)0);
+            QCOMPARE(hiddenStats.strcmpCalls, (uint64_t)0);
+        }
+    }
 };
 
 QTEST_MAIN(ElfHashTest)
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/exportreductioncheck.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QBuffer>
+#include <QFile>
+#include <QObject>
+#include <QProcess>
+#include <QSet>
+#include <QTemporaryDir>
+
+#include <cstring>
+
+#include <elf.h>
+
+class ExportReductionCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testAnalyze()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(set.size() > 1);
+
+        ExportReductionCheck check(&set);
+        const auto results = check.analyze();
+        // the executable itself is skipped
+        QCOMPARE(results.size(), set.size() - 1);
+
+        int externallyUsed = 0;
+        foreach (const auto &res, results) {
+            QVERIFY(res.file != set.file(0));
+            int total = 0;
+            for (int usage = ExportReductionCheck::Required; usage <= ExportReductionCheck::Unused; ++usage)
+                total += res.counts[usage];
+            QCOMPARE(total, res.exports.size());
+            externallyUsed += res.counts[ExportReductionCheck::UsedExternally];
+
+            const auto symTab = res.file->section<ElfSymbolTableSection>(res.file->indexOfSection(SHT_DYNSYM));
+            QVERIFY(symTab);
+            QCOMPARE(res.dynsymSize, res.hiddenCount() * symTab->header()->entrySize());
+            if (res.hasLookupEstimate) {
+                QCOMPARE(res.reducedLookups.lookups, res.currentLookups.lookups);
+                QVERIFY(res.reducedLookups.stats.strcmpCalls <= res.currentLookups.stats.strcmpCalls);
+            }
+        }
+        QVERIFY(externallyUsed > 0);
+    }
+
+    void testVersionScript()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libversioned-symbols.so"));
+        QCOMPARE(set.size(), 1);
+
+        ExportReductionCheck check(&set);
+        const auto res = check.analyzeFile(0);
+        QVERIFY(!res.exports.isEmpty());
+
+        // function@VER1 is a compat symbol, nothing in the set uses function@@VER2
+        bool hasCompat = false;
+        foreach (const auto &exp, res.exports) {
+            if (strcmp(exp.symbol->name(), "function") != 0)
+                continue;
+            if (exp.version == "VER1") {
+                QCOMPARE(exp.usage, ExportReductionCheck::Required);
+                hasCompat = true;
+            } else {
+                QCOMPARE(exp.version, QByteArray("VER2"));
+                QCOMPARE(exp.usage, ExportReductionCheck::Unused);
+            }
+        }
+        QVERIFY(hasCompat);
+
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        ExportReductionCheck::writeVersionScript(res, &buffer);
+        const auto script = buffer.data();
+        QVERIFY(script.contains("VER1 {\n  global:\n    function;\n  local:\n    *;\n};\n"));
+        QVERIFY(script.contains("VER2 {\n} VER1;\n"));
+
+        // the .symver directives of the library need both nodes, relinking with the script must keep both versions
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QFile scriptFile(dir.filePath(QStringLiteral("versioned-symbols.map")));
+        QVERIFY(scriptFile.open(QIODevice::WriteOnly));
+        scriptFile.write(script);
+        scriptFile.close();
+
+        const auto libPath = dir.filePath(QStringLiteral("libversioned-symbols.so"));
+        QProcess cc;
+        cc.setProcessChannelMode(QProcess::ForwardedChannels);
+        cc.start(QStringLiteral(C_COMPILER), { QStringLiteral("-shared"), QStringLiteral("-fPIC"), QStringLiteral(TARGETSRCDIR "versioned-symbols.c"),
+            QStringLiteral("-Wl,--version-script=") + scriptFile.fileName(), QStringLiteral("-o"), libPath });
+        QVERIFY(cc.waitForFinished(-1));
+        QCOMPARE(cc.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(cc.exitCode(), 0);
+
+        ElfFileSet relinkedSet;
+        relinkedSet.addFile(libPath);
+        QCOMPARE(relinkedSet.size(), 1);
+        ExportReductionCheck relinkedCheck(&relinkedSet);
+        QSet<QByteArray> versions;
+        foreach (const auto &exp, relinkedCheck.analyzeFile(0).exports) {
+            if (strcmp(exp.symbol->name(), "function") == 0)
+                versions.insert(exp.version);
+        }
+        QCOMPARE(versions, QSet<QByteArray>({ "VER1", "VER2" }));
+    }
+};
+
+QTEST_MAIN(ExportReductionCheckTest)
+
+#include "exportreductionchecktest.moc"
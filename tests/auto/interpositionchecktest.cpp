@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/interpositioncheck.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+
+class InterpositionCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testAnalyze()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "interposition"));
+        QVERIFY(set.size() > 1);
+        const auto exe = set.file(0);
+
+        InterpositionCheck check(&set);
+        const auto results = check.analyze();
+        const auto scope = SymbolLookupSimulator(&set).scopeOrder();
+        // the executable is skipped
+        QCOMPARE(results.size(), scope.size() - 1);
+
+        const InterpositionCheck::Result *lib = nullptr;
+        foreach (const auto &res, results) {
+            QVERIFY(res.file != exe);
+            if (res.file->displayName() == QLatin1String("libinterposition-lib.so"))
+                lib = &res;
+        }
+        QVERIFY(lib);
+
+        // the PLT slots for interposed() and canonical()
+        QCOMPARE(lib->selfRelocations, 2);
+        QCOMPARE(lib->functionRelocations, 2);
+        QCOMPARE(lib->pltSlots, 2);
+        QCOMPARE(lib->symbolCount, 2);
+
+        // symbolic binding skips exactly the relocations against own definitions
+        const auto resolved = [](const SymbolLookupSimulator::Statistics &stats) { return stats.lookups + stats.cachedLookups; };
+        QCOMPARE(resolved(lib->defaultCost) - resolved(lib->symbolicFunctionsCost), (uint64_t)2);
+        QCOMPARE(resolved(lib->defaultCost) - resolved(lib->symbolicCost), (uint64_t)2);
+
+        QCOMPARE(lib->interpositions.size(), 2);
+        foreach (const auto &interposition, lib->interpositions) {
+            QCOMPARE(interposition.interposer, exe);
+            QVERIFY(interposition.isFunction);
+            if (interposition.symbolName == "interposed") {
+                QVERIFY(!interposition.isCanonicalPlt);
+            } else {
+                QCOMPARE(interposition.symbolName, QByteArray("canonical"));
+                QVERIFY(interposition.isCanonicalPlt);
+            }
+        }
+        QVERIFY(!lib->isSymbolicFunctionsSafe());
+        QVERIFY(!lib->isSymbolicSafe());
+    }
+};
+
+QTEST_MAIN(InterpositionCheckTest)
+
+#include "interpositionchecktest.moc"
@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/pltgotcheck.h>
+#include <disassmbler/instructiondecoder.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfheader.h>
+#include <elf/elfrelocationentry.h>
+#include <elf/elfrelocationsection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+#include <QSet>
+
+#include <algorithm>
+#include <cstring>
+
+#include <elf.h>
+
+class PltGotCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testPltStubs()
+    {
+        ElfFile file(QStringLiteral(BINDIR "libindirections.so"));
+        QVERIFY(file.open(QFile::ReadOnly));
+        InstructionDecoder decoder(&file);
+        if (!decoder.isValid())
+            QSKIP("Capstone not available");
+
+        const auto relocIndex = std::max(file.indexOfSection(".rela.plt"), file.indexOfSection(".rel.plt"));
+        QVERIFY(relocIndex > 0);
+        const auto relocSection = file.section<ElfRelocationSection>(relocIndex);
+        QVERIFY(relocSection);
+        QCOMPARE(relocSection->header()->entryCount(), (uint64_t)2);
+
+        // puts and exportedFunction, each with a stub jumping through its GOT slot
+        const auto stubs = PltGotCheck::pltStubs(&file, decoder);
+        QCOMPARE(stubs.size(), 2);
+        QSet<QByteArray> names;
+        for (auto it = stubs.constBegin(); it != stubs.constEnd(); ++it) {
+            const auto sectionIndex = file.indexOfSectionWithVirtualAddress(it.key());
+            QVERIFY(sectionIndex > 0);
+            QVERIFY(strncmp(file.sectionHeaders().at(sectionIndex)->name(), ".plt", 4) == 0);
+            names.insert(it.value()->symbol()->name());
+        }
+        QCOMPARE(names, QSet<QByteArray>({ "puts", "exportedFunction" }));
+        for (uint64_t i = 0; i < relocSection->header()->entryCount(); ++i)
+            QVERIFY(stubs.values().contains(relocSection->entry(i)));
+    }
+
+    void testAnalyze()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libindirections.so"));
+        QVERIFY(set.size() > 1);
+
+        PltGotCheck check(&set);
+        const auto results = check.analyze();
+        QCOMPARE(results.size(), set.size());
+        const auto &res = results.at(0);
+        if (!res.disassembled)
+            QSKIP("Capstone not available");
+        if (res.file->header()->machine() != EM_X86_64 && res.file->header()->machine() != EM_386)
+            QSKIP("Expected values are for x86");
+
+        PltGotCheck::Sites sites;
+        foreach (const auto &func, res.functions) {
+            QVERIFY(func.function);
+            QVERIFY(func.sites.indirections() > 0);
+            QVERIFY(strcmp(func.function->name(), "exportedFunction") != 0);
+            sites += func.sites;
+        }
+        QCOMPARE(sites.indirections(), res.sites.indirections());
+
+        const auto function = [&res](const char *name) {
+            const auto it = std::find_if(res.functions.constBegin(), res.functions.constEnd(), [name](const PltGotCheck::Function &func) {
+                return strcmp(func.function->name(), name) == 0;
+            });
+            return it != res.functions.constEnd() ? (*it).sites : PltGotCheck::Sites();
+        };
+        const auto callAll = function("callAll");
+        QCOMPARE(callAll.count[PltGotCheck::DirectCall], 1);
+        QCOMPARE(callAll.count[PltGotCheck::PltCall], 1);
+        QCOMPARE(callAll.count[PltGotCheck::IntraLibraryPltCall], 1);
+        QCOMPARE(callAll.count[PltGotCheck::GotCall], 1);
+        QCOMPARE(callAll.count[PltGotCheck::GotAccess], 1);
+        QCOMPARE(callAll.count[PltGotCheck::IntraLibraryGotAccess], 0);
+        const auto localFunction = function("localFunction");
+        QCOMPARE(localFunction.indirections(), 1);
+        QCOMPARE(localFunction.count[PltGotCheck::IntraLibraryGotAccess], 1);
+
+        QCOMPARE(res.callees.value("puts").count[PltGotCheck::PltCall], 1);
+        QCOMPARE(res.callees.value("exportedFunction").count[PltGotCheck::IntraLibraryPltCall], 1);
+        QCOMPARE(res.callees.value("rand").count[PltGotCheck::GotCall], 1);
+        QCOMPARE(res.callees.value("environ").count[PltGotCheck::GotAccess], 1);
+        QCOMPARE(res.callees.value("exportedData").count[PltGotCheck::IntraLibraryGotAccess], 1);
+    }
+};
+
+QTEST_MAIN(PltGotCheckTest)
+
+#include "pltgotchecktest.moc"
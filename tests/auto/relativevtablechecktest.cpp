@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/relativevtablecheck.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+
+#include <cstring>
+
+#include <elf.h>
+
+static const RelativeVTableCheck::VTable* findVTable(const RelativeVTableCheck::Result &result, const char *name)
+{
+    foreach (const auto &vtable, result.vtables) {
+        if (strcmp(vtable.symbol->name(), name) == 0)
+            return &vtable;
+    }
+    return nullptr;
+}
+
+class RelativeVTableCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testAnalyze()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "librelative-vtables.so"));
+        QVERIFY(set.size() > 1);
+
+        RelativeVTableCheck check;
+        const auto res = check.analyze(&set, 0);
+        QCOMPARE(res.file, set.file(0));
+        QCOMPARE(res.vtables.size(), 3);
+        const uint64_t addrSize = res.file->addressSize();
+
+        // offset to top, RTTI, complete and deleting destructor, f(), g()
+        auto vtable = findVTable(res, "_ZTV4Base");
+        QVERIFY(vtable);
+        QCOMPARE(vtable->slotCount, 6);
+        QCOMPARE(vtable->relocationCount, 5);
+        QCOMPARE(vtable->size(), 6 * addrSize);
+        QCOMPARE(vtable->relativeSize(), (uint64_t)24);
+        QVERIFY(vtable->externalTargets.isEmpty());
+        QCOMPARE(vtable->hierarchy, QByteArray("Base"));
+
+        vtable = findVTable(res, "_ZTV7Derived");
+        QVERIFY(vtable);
+        QCOMPARE(vtable->slotCount, 6);
+        QCOMPARE(vtable->relocationCount, 5);
+        QVERIFY(vtable->externalTargets.isEmpty());
+        QCOMPARE(vtable->hierarchy, QByteArray("Base"));
+
+        // offset to top, RTTI, complete and deleting destructor, what() from libstdc++
+        vtable = findVTable(res, "_ZTV5Error");
+        QVERIFY(vtable);
+        QCOMPARE(vtable->slotCount, 5);
+        QCOMPARE(vtable->relocationCount, 4);
+        QCOMPARE(vtable->size(), 5 * addrSize);
+        QCOMPARE(vtable->relativeSize(), (uint64_t)20);
+        QCOMPARE(vtable->externalTargets.size(), 1);
+        QCOMPARE(*vtable->externalTargets.begin(), QByteArray("_ZNKSt9exception4whatEv"));
+        QCOMPARE(vtable->hierarchy, QByteArray("std::exception"));
+
+        QCOMPARE(res.relocationCount, 14);
+        QCOMPARE(res.gotEntryCount, 1);
+        QCOMPARE(res.savedRelocations(), 13);
+        QCOMPARE(res.size, 17 * addrSize);
+        QCOMPARE(res.relativeSize, (uint64_t)68);
+        QCOMPARE(res.dirtyPages, 1);
+        QCOMPARE(res.relativeDirtyPages, 1);
+
+        // Elf64_Rela on 64bit, Elf32_Rel on 32bit platforms
+        if (addrSize == 8) {
+            QCOMPARE(res.relocationTableSize, (uint64_t)14 * 24);
+            QCOMPARE(res.gotSize, (uint64_t)32);
+        } else {
+            QCOMPARE(res.relocationTableSize, (uint64_t)14 * 8);
+            QCOMPARE(res.gotSize, (uint64_t)12);
+        }
+    }
+};
+
+QTEST_MAIN(RelativeVTableCheckTest)
+
+#include "relativevtablechecktest.moc"
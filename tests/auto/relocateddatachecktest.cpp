@@ -0,0 +1,110 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/relocateddatacheck.h>
+
+#include <elf/elffile.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+
+#include <elf.h>
+
+static const RelocatedDataCheck::Object* findObject(const QVector<RelocatedDataCheck::Object> &objects, const char *name)
+{
+    foreach (const auto &obj, objects) {
+        if (obj.name == name)
+            return &obj;
+    }
+    return nullptr;
+}
+
+class RelocatedDataCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testAnalyze()
+    {
+        ElfFile file(QStringLiteral(BINDIR "librelocated-data.so"));
+        QVERIFY(file.open(QFile::ReadOnly));
+
+        RelocatedDataCheck check;
+        const auto objects = check.analyze(&file);
+        QCOMPARE(objects.size(), 3);
+
+        auto obj = findObject(objects, "names");
+        QVERIFY(obj);
+        QCOMPARE(obj->relocationCount, 3);
+        QCOMPARE(obj->relativeCount, 3);
+        QCOMPARE(obj->localSymbolicCount, 0);
+        QCOMPARE(obj->classification, RelocatedDataCheck::OffsetTableCandidate);
+
+        obj = findObject(objects, "localFunctions");
+        QVERIFY(obj);
+        QCOMPARE(obj->relocationCount, 2);
+        QCOMPARE(obj->relativeCount, 0);
+        QCOMPARE(obj->localSymbolicCount, 2);
+        QCOMPARE(obj->classification, RelocatedDataCheck::LocalSymbolic);
+
+        obj = findObject(objects, "externalFunctions");
+        QVERIFY(obj);
+        QCOMPARE(obj->relocationCount, 1);
+        QCOMPARE(obj->relativeCount, 0);
+        QCOMPARE(obj->localSymbolicCount, 0);
+        QCOMPARE(obj->classification, RelocatedDataCheck::External);
+
+        // ranked by dirtied pages, then by relocation count
+        for (int i = 1; i < objects.size(); ++i) {
+            QVERIFY(objects.at(i - 1).pageCount >= objects.at(i).pageCount);
+            if (objects.at(i - 1).pageCount == objects.at(i).pageCount)
+                QVERIFY(objects.at(i - 1).relocationCount >= objects.at(i).relocationCount);
+        }
+    }
+
+    void testPages()
+    {
+        ElfFile file(QStringLiteral(BINDIR "librelocated-data.so"));
+        QVERIFY(file.open(QFile::ReadOnly));
+
+        // one pointer per page
+        RelocatedDataCheck check;
+        check.setPageSize(file.addressSize());
+        auto objects = check.analyze(&file);
+        QCOMPARE(objects.size(), 3);
+        QCOMPARE(objects.at(0).name, QByteArray("names"));
+        QCOMPARE(objects.at(0).pageCount, 3);
+        QCOMPARE(objects.at(1).name, QByteArray("localFunctions"));
+        QCOMPARE(objects.at(1).pageCount, 2);
+        QCOMPARE(objects.at(2).name, QByteArray("externalFunctions"));
+        QCOMPARE(objects.at(2).pageCount, 1);
+        QCOMPARE(RelocatedDataCheck::distinctPageCount(objects), 6);
+
+        // all objects share a single page, which is dirtied only once
+        check.setPageSize(1 << 20);
+        objects = check.analyze(&file);
+        QCOMPARE(objects.size(), 3);
+        foreach (const auto &obj, objects) {
+            QCOMPARE(obj.pageCount, 1);
+            QCOMPARE(obj.pages.size(), 1);
+        }
+        QCOMPARE(RelocatedDataCheck::distinctPageCount(objects), 1);
+    }
+};
+
+QTEST_MAIN(RelocatedDataCheckTest)
+
+#include "relocateddatachecktest.moc"
@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/symbolbindingtrace.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+#include <QTemporaryFile>
+
+#include <cstring>
+
+#include <elf.h>
+
+class SymbolBindingTraceTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testLoadAndResolve()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(set.size() > 1);
+
+        const auto provider = set.file(1);
+        const auto symTab = provider->section<ElfSymbolTableSection>(provider->indexOfSection(SHT_DYNSYM));
+        QVERIFY(symTab);
+        QByteArray symbol;
+        for (uint32_t i = 1; i < symTab->header()->entryCount() && symbol.isEmpty(); ++i) {
+            const auto entry = symTab->entry(i);
+            if (entry->hasValidSection() && entry->bindType() == STB_GLOBAL && entry->type() == STT_FUNC)
+                symbol = entry->name();
+        }
+        QVERIFY(!symbol.isEmpty());
+
+        const auto requesterPath = set.file(0)->fileName().toUtf8();
+        const auto providerPath = provider->fileName().toUtf8();
+        QTemporaryFile traceFile;
+        QVERIFY(traceFile.open());
+        traceFile.write(requesterPath + '\t' + providerPath + '\t' + symbol + '\n');
+        traceFile.write("invalid line\n");
+        traceFile.write(requesterPath + "\t/not/existing.so\tnot_existing\n");
+        traceFile.write(requesterPath + '\t' + providerPath + '\t' + symbol + '\n');
+        traceFile.close();
+
+        SymbolBindingTrace trace;
+        QVERIFY(trace.load(traceFile.fileName()));
+        auto bindings = trace.bindings();
+        QCOMPARE(bindings.size(), 2);
+        QCOMPARE(bindings.at(0).count, 2);
+        QCOMPARE(bindings.at(0).symbol, symbol);
+        QCOMPARE(bindings.at(1).count, 1);
+        QVERIFY(!bindings.at(0).definition);
+
+        trace.resolve(&set);
+        bindings = trace.bindings();
+        QCOMPARE(bindings.at(0).requesterFile, set.file(0));
+        QCOMPARE(bindings.at(0).providerFile, provider);
+        QVERIFY(bindings.at(0).definition);
+        QCOMPARE(QByteArray(bindings.at(0).definition->name()), symbol);
+        QCOMPARE(bindings.at(1).requesterFile, set.file(0));
+        QVERIFY(!bindings.at(1).providerFile);
+        QVERIFY(!bindings.at(1).definition);
+    }
+
+    void testLoadMissing()
+    {
+        SymbolBindingTrace trace;
+        QVERIFY(!trace.load(QStringLiteral("/not/existing/trace")));
+    }
+};
+
+QTEST_MAIN(SymbolBindingTraceTest)
+
+#include "symbolbindingtracetest.moc"
@@ -0,0 +1,173 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/symbollookupsimulator.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfhashsection.h>
+#include <elf/elfsymboltablesection.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+
+#include <cstring>
+
+#include <elf.h>
+
+class SymbolLookupSimulatorTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testScopeOrder()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(set.size() > 1);
+
+        SymbolLookupSimulator sim(&set);
+        const auto scope = sim.scopeOrder();
+        QCOMPARE(scope.size(), set.size());
+        QCOMPARE(scope.at(0), 0);
+    }
+
+    void testHideSymbols()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(set.size() > 1);
+
+        SymbolLookupSimulator sim(&set);
+        sim.simulate(SymbolLookupSimulator::BindNow);
+        const auto before = sim.totalStatistics();
+        QVERIFY(before.lookups > 0);
+        QVERIFY(before.strcmpCalls > 0);
+
+        // the provider doing the most work
+        int provider = -1;
+        for (int i = 0; i < set.size(); ++i) {
+            if (provider < 0 || sim.providerStatistics(i).strcmpCalls > sim.providerStatistics(provider).strcmpCalls)
+                provider = i;
+        }
+        QVERIFY(sim.providerStatistics(provider).strcmpCalls > 0);
+
+        const auto file = set.file(provider);
+        const auto symTab = file->section<ElfSymbolTableSection>(file->indexOfSection(SHT_DYNSYM));
+        QVERIFY(symTab);
+        QSet<QByteArray> symbols;
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i)
+            symbols.insert(symTab->entry(i)->name());
+
+        sim.hideSymbols(provider, symbols);
+        sim.simulate(SymbolLookupSimulator::BindNow);
+        const auto after = sim.totalStatistics();
+        QCOMPARE(after.lookups, before.lookups);
+        QCOMPARE(sim.providerStatistics(provider).chainWalks, (uint64_t)0);
+        QCOMPARE(sim.providerStatistics(provider).strcmpCalls, (uint64_t)0);
+        QVERIFY(after.failedLookups > before.failedLookups);
+    }
+
+    void testCanonicalPlt()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "interposition"));
+        QVERIFY(set.size() > 1);
+
+        const auto exe = set.file(0);
+        const auto hash = exe->hash();
+        QVERIFY(hash);
+        const auto symTab = exe->section<ElfSymbolTableSection>(exe->indexOfSection(SHT_DYNSYM));
+        QVERIFY(symTab);
+        ElfSymbolTableEntry *canonical = nullptr;
+        ElfSymbolTableEntry *undefined = nullptr;
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+            const auto entry = symTab->entry(i);
+            if (strcmp(entry->name(), "canonical") == 0)
+                canonical = entry;
+            else if (strcmp(entry->name(), "callInterposed") == 0)
+                undefined = entry;
+        }
+
+        // the non-PIE executable takes the address of canonical(), so its PLT entry is the canonical address
+        QVERIFY(canonical);
+        QCOMPARE(canonical->sectionIndex(), (uint16_t)SHN_UNDEF);
+        QVERIFY(canonical->value() != 0);
+        QVERIFY(ElfHashSection::isDefinition(canonical));
+        QVERIFY(!ElfHashSection::isDefinition(canonical, true));
+        QCOMPARE(hash->lookup("canonical"), canonical);
+        QVERIFY(!hash->lookup("canonical", nullptr, nullptr, true));
+
+        // plain undefined symbols are never definitions
+        QVERIFY(undefined);
+        QCOMPARE(undefined->value(), (uint64_t)0);
+        QVERIFY(!ElfHashSection::isDefinition(undefined));
+        QVERIFY(!hash->lookup("callInterposed"));
+
+        const auto def = hash->lookup("interposed");
+        QVERIFY(def);
+        QVERIFY(def->hasValidSection());
+    }
+
+    void testVersionedLookup()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libtiny-functions-user.so"));
+        QVERIFY(set.size() > 1);
+        int libIndex = -1;
+        for (int i = 0; i < set.size(); ++i) {
+            if (set.file(i)->displayName() == QLatin1String("libtiny-functions.so"))
+                libIndex = i;
+        }
+        QVERIFY(libIndex > 0);
+        const auto lib = set.file(libIndex);
+
+        // the user references the compat version
+        const auto user = set.file(0);
+        const auto symTab = user->section<ElfSymbolTableSection>(user->indexOfSection(SHT_DYNSYM));
+        QVERIFY(symTab);
+        uint32_t reference = 0;
+        for (uint32_t i = 1; i < symTab->header()->entryCount(); ++i) {
+            if (strcmp(symTab->entry(i)->name(), "getValue") == 0)
+                reference = i;
+        }
+        QVERIFY(reference > 0);
+        QCOMPARE(SymbolLookupSimulator::symbolVersion(user, reference), QByteArray("VER1"));
+
+        SymbolLookupSimulator sim(&set);
+        int providerIndex = -1;
+        const auto compat = sim.lookupDefinition("getValue", "VER1", &providerIndex);
+        QVERIFY(compat);
+        QCOMPARE(providerIndex, libIndex);
+        QCOMPARE(SymbolLookupSimulator::symbolVersion(lib, compat->index()), QByteArray("VER1"));
+
+        const auto current = sim.lookupDefinition("getValue", "VER2", &providerIndex);
+        QVERIFY(current);
+        QVERIFY(current != compat);
+        QCOMPARE(providerIndex, libIndex);
+        QCOMPARE(SymbolLookupSimulator::symbolVersion(lib, current->index()), QByteArray("VER2"));
+
+        // unversioned references bind to the oldest version
+        QCOMPARE(sim.lookupDefinition("getValue", QByteArray(), nullptr), compat);
+        QVERIFY(!sim.lookupDefinition("getValue", "VER3", nullptr));
+        QVERIFY(sim.lookupDefinition("tinyFunction", "VER1", nullptr));
+    }
+};
+
+QTEST_MAIN(SymbolLookupSimulatorTest)
+
+#include "symbollookupsimulatortest.moc"
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <checks/tinyfunctioncheck.h>
+#include <checks/symbollookupsimulator.h>
+#include <disassmbler/instructiondecoder.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+#include <elf/elfsymboltableentry.h>
+
+#include <QtTest/qtest.h>
+#include <QHash>
+#include <QObject>
+
+#include <elf.h>
+
+class TinyFunctionCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testBinding()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libtiny-functions-user.so"));
+        QVERIFY(set.size() > 1);
+        if (!InstructionDecoder(set.file(0)).isValid())
+            QSKIP("Capstone not available");
+
+        TinyFunctionCheck check(&set);
+        const auto results = check.analyze();
+
+        QHash<QByteArray, TinyFunctionCheck::Result> byName;
+        foreach (const auto &res, results) {
+            QVERIFY(res.file);
+            QCOMPARE(res.function->type(), (uint8_t)STT_FUNC);
+            QVERIFY(res.function->size() <= 32);
+            QVERIFY(res.instructions > 0);
+            QVERIFY(!res.callers.contains(res.file));
+            // the C library calls small functions of the dynamic loader
+            if (res.file->displayName() != QLatin1String("libtiny-functions.so"))
+                continue;
+            QCOMPARE(res.callSites, 1);
+            QCOMPARE(res.callers.size(), 1);
+            QCOMPARE(res.callers.at(0), set.file(0));
+            byName.insert(res.function->name(), res);
+        }
+
+        // largeFunction and the default getValue version exceed the size threshold
+        QCOMPARE(byName.size(), 2);
+        QVERIFY(byName.contains("tinyFunction"));
+
+        // the user binds to the compat version, which comes after the default one in the hash chain
+        QVERIFY(byName.contains("getValue"));
+        const auto &getValue = byName.value("getValue");
+        QCOMPARE(SymbolLookupSimulator::symbolVersion(getValue.file, getValue.function->index()), QByteArray("VER1"));
+
+        // nothing is small enough
+        check.setSizeThreshold(0);
+        QVERIFY(check.analyze().isEmpty());
+    }
+};
+
+QTEST_MAIN(TinyFunctionCheckTest)
+
+#include "tinyfunctionchecktest.moc"
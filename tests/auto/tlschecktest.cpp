@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "config-elf-dissector.h"
+#include <checks/tlscheck.h>
+#include <disassmbler/instructiondecoder.h>
+
+#include <elf/elffile.h>
+#include <elf/elffileset.h>
+
+#include <QtTest/qtest.h>
+#include <QObject>
+
+#include <elf.h>
+
+class TlsCheckTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void testDecoder()
+    {
+        ElfFile f(QStringLiteral(BINDIR "elf-dissector"));
+        QVERIFY(f.open(QFile::ReadOnly));
+        InstructionDecoder decoder(&f);
+#ifndef HAVE_CAPSTONE
+        QVERIFY(!decoder.isValid());
+        QSKIP("Capstone not available");
+#endif
+        QVERIFY(decoder.isValid());
+
+        const auto index = f.indexOfSection(".text");
+        QVERIFY(index > 0);
+        const auto text = f.section<ElfSection>(index);
+        const unsigned char *data = text->rawData();
+        size_t size = text->size();
+        uint64_t address = text->header()->virtualAddress();
+
+        int calls = 0;
+        InstructionDecoder::Instruction insn;
+        while (size > 0 && decoder.decode(&data, &size, &address, &insn)) {
+            QVERIFY(insn.size > 0);
+            QCOMPARE(insn.address + insn.size, address);
+            if (insn.isCall && insn.branchTarget) {
+                ++calls;
+                // direct calls go to the text or the PLT
+                QVERIFY(f.indexOfSectionWithVirtualAddress(insn.branchTarget) > 0);
+            }
+        }
+        QVERIFY(calls > 0);
+    }
+
+    void testGlobalDynamic()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libtls-global-dynamic.so"));
+        QVERIFY(set.size() > 1);
+
+        TlsCheck check(&set);
+        const auto results = check.analyze();
+        QCOMPARE(results.size(), set.size());
+        const auto &res = results.at(0);
+
+        // two ints in .tbss, dlopen()ed as the set starts with a library
+        QCOMPARE(res.tlsSize, (uint64_t)8);
+        QCOMPARE(res.tlsInitSize, (uint64_t)0);
+        QCOMPARE(res.tlsAlignment, (uint64_t)4);
+        QVERIFY(!res.loadedAtStartup);
+        QVERIFY(res.canUseInitialExec());
+        QVERIFY(!res.hasStaticTlsFlag);
+        QVERIFY(!res.usesInitialExec());
+        QVERIFY(res.usesDynamicModel());
+        QCOMPARE(res.relocations[TlsCheck::StaticOffset], 0);
+        if (res.relocations[TlsCheck::Descriptor] > 0)
+            QSKIP("Compiler defaults to TLS descriptors");
+
+        // general-dynamic for the exported counter, local-dynamic for the static one
+        QCOMPARE(res.relocations[TlsCheck::ModuleId], 2);
+        QCOMPARE(res.relocations[TlsCheck::ModuleOffset], 1);
+        QCOMPARE(res.ownModuleRelocations, 1);
+
+#ifndef HAVE_CAPSTONE
+        QCOMPARE(res.callSites, -1);
+        QSKIP("Capstone not available");
+#endif
+        QCOMPARE(res.callSites, 3);
+        QCOMPARE(res.callers.size(), 2);
+        QCOMPARE(res.callers.at(0).function->name(), "incrementBoth");
+        QCOMPARE(res.callers.at(0).callSites, 2);
+        QCOMPARE(res.callers.at(1).function->name(), "incrementCounter");
+        QCOMPARE(res.callers.at(1).callSites, 1);
+    }
+
+    void testInitialExec()
+    {
+        ElfFileSet set;
+        set.addFile(QStringLiteral(BINDIR "libtls-initial-exec.so"));
+        QVERIFY(set.size() > 1);
+
+        TlsCheck check(&set);
+        const auto results = check.analyze();
+        QCOMPARE(results.size(), set.size());
+        const auto &res = results.at(0);
+
+        QCOMPARE(res.tlsSize, (uint64_t)8);
+        QVERIFY(res.hasStaticTlsFlag);
+        QVERIFY(res.usesInitialExec());
+        QVERIFY(!res.usesDynamicModel());
+        // one for the exported counter, one for the static variable
+        QCOMPARE(res.relocations[TlsCheck::StaticOffset], 2);
+        QCOMPARE(res.relocations[TlsCheck::ModuleId], 0);
+        QCOMPARE(res.relocations[TlsCheck::ModuleOffset], 0);
+        QCOMPARE(res.relocations[TlsCheck::Descriptor], 0);
+        QCOMPARE(res.ownModuleRelocations, 0);
+        // __tls_get_addr isn't referenced at all
+        QCOMPARE(res.callSites, 0);
+        QVERIFY(res.callers.isEmpty());
+    }
+};
+
+QTEST_MAIN(TlsCheckTest)
+
+#include "tlschecktest.moc"
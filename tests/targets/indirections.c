@@ -0,0 +1,43 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+
+/* as with -fno-plt */
+extern int rand(void) __attribute__((noplt));
+extern char **environ;
+
+/* exported, so accessed through the GOT */
+int exportedData = 1;
+
+/* exported, so called through the PLT */
+int exportedFunction(void)
+{
+    return 1;
+}
+
+static __attribute__((noinline)) int localFunction(void)
+{
+    return exportedData;
+}
+
+int callAll(void)
+{
+    puts("indirections");
+    return exportedFunction() + localFunction() + rand() + (environ != NULL);
+}
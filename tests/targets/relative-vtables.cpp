@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <exception>
+
+// key functions are defined below, so the vtables are emitted in here
+struct Base {
+    virtual ~Base();
+    virtual int f();
+    virtual int g();
+};
+
+struct Derived : public Base {
+    int f() override;
+};
+
+// what() stays the implementation in libstdc++, an external vtable target
+struct Error : public std::exception {
+    ~Error() override;
+};
+
+Base::~Base() = default;
+int Base::f() { return 1; }
+int Base::g() { return 2; }
+int Derived::f() { return 3; }
+Error::~Error() = default;
+
+Base* makeDerived()
+{
+    return new Derived;
+}
+
+std::exception* makeError()
+{
+    return new Error;
+}
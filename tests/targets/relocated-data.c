@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+
+int localFunction(void)
+{
+    return 42;
+}
+
+/* only relative relocations, pointing to string literals */
+const char *const names[] = { "one", "two", "three" };
+
+/* symbolic relocations against a function defined in here */
+int (*const localFunctions[])(void) = { localFunction, localFunction };
+
+/* symbolic relocation against a function defined elsewhere */
+int (*const externalFunctions[])(const char*) = { puts };
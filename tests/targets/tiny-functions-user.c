@@ -0,0 +1,28 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/* binds to the compat version, as if built against an old version of the library */
+__asm__(".symver getValueV1, getValue@VER1");
+int getValueV1(void);
+int tinyFunction(void);
+int largeFunction(int a, int b);
+
+int useAll(int a)
+{
+    return getValueV1() + tinyFunction() + largeFunction(a, 3);
+}
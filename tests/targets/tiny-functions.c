@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2026 Volker Krause <vkrause@kde.org>
+
+    This program is free software; you can redistribute it and/or modify it
+    under the terms of the GNU Library General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+    License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/* the compat version is tiny, the default version too large */
+__asm__(".symver getValueV1, getValue@VER1");
+int getValueV1(void)
+{
+    return 1;
+}
+
+__asm__(".symver getValueV2, getValue@@VER2");
+int getValueV2(int a, int b)
+{
+    int r = 0;
+    for (int i = 0; i < a; ++i)
+        r += (i * b) ^ (r >> 3);
+    return r;
+}
+
+int tinyFunction(void)
+{
+    return 1;
+}
+
+int largeFunction(int a, int b)
+{
+    int r = 0;
+    for (int i = 0; i < a; ++i)
+        r += (i * b) ^ (r >> 3);
+    return r;
+}